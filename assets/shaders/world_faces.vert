@@ -0,0 +1,72 @@
+#version 450 core
+
+// Face records (voir FaceRecord.hpp) : 8 octets par face, lus depuis un SSBO.
+// Aucun attribut de sommet, les 6 sommets d'une face sont reconstruits depuis gl_VertexID,
+// qui indexe tout le buffer partagé des chunks (voir ChunkMegaBuffer).
+layout(std430, binding = 0) readonly buffer FaceRecords {
+    uvec2 faces[];
+};
+
+// Origine du chunk de chaque draw (une par commande de glMultiDrawArraysIndirect)
+layout(location = 3) in ivec2 chunkOrigin;
+
+// Données communes à toute la frame, voir FrameUniforms.hpp
+layout(std140, binding = 0) uniform FrameUniforms {
+    mat4 viewProjection;
+    vec4 lightDirection;
+    uint textureAnimation;
+    float zNear;
+    float zFar;
+};
+
+flat out uint textureIdx;
+
+out float vert_lighting;
+out vec3 vert_pos;
+out vec2 vert_uv;
+
+// Sommets de chaque face, même ordre que BlockMesh::vertices
+// bits 0-2: offset x, y, z du coin ; bits 3-4: u, v
+const uint faceVertices[36] = uint[36](
+    14u, 31u,  2u, 31u, 19u,  2u,   // top
+    15u, 29u,  3u, 29u, 17u,  3u,   // +x east
+    10u, 24u,  6u, 24u, 20u,  6u,   // -x west
+    11u, 25u,  2u, 25u, 16u,  2u,   // -z north
+    14u, 28u,  7u, 28u, 21u,  7u,   // +z south
+    13u, 28u,  1u, 28u, 16u,  1u    // bottom
+);
+
+// Axes du monde suivis par u et v pour chaque face (quads fusionnés par le greedy meshing)
+const uint faceUAxis[6] = uint[6](2u, 2u, 2u, 0u, 0u, 2u);
+const uint faceVAxis[6] = uint[6](0u, 1u, 1u, 1u, 1u, 0u);
+
+void main() {
+    uvec2 record = faces[gl_VertexID / 6];
+
+    // Word 0: x(4 bits) + z(4 bits) + y(8 bits) + textureIndex(8 bits) + face(3 bits)
+    uvec3 origin = uvec3(record.x & 0x0Fu, (record.x >> 8) & 0xFFu, (record.x >> 4) & 0x0Fu);
+    uint baseTextureIdx = (record.x >> 16) & 0xFFu;
+    uint face = (record.x >> 24) & 0x07u;
+
+    // Word 1: occlusion des 4 coins (2 bits chacun) + uScale-1(4 bits) + vScale-1(4 bits)
+    uint uScale = ((record.y >> 8) & 0x0Fu) + 1u;
+    uint vScale = ((record.y >> 12) & 0x0Fu) + 1u;
+
+    uint corner = faceVertices[face * 6u + uint(gl_VertexID % 6)];
+    uvec3 cornerOffset = uvec3(corner & 1u, (corner >> 1) & 1u, (corner >> 2) & 1u);
+    uint xUv = (corner >> 3) & 1u;
+    uint yUv = (corner >> 4) & 1u;
+    uint occlusionLevel = (record.y >> (2u * (xUv | (yUv << 1)))) & 0x03u;
+
+    uvec3 extent = uvec3(1u);
+    extent[faceUAxis[face]] = uScale;
+    extent[faceVAxis[face]] = vScale;
+
+    // Calculate final values
+    vert_pos = vec3(origin + cornerOffset * extent);
+    vert_uv = vec2(xUv * uScale, yUv * vScale);
+    textureIdx = baseTextureIdx;
+    vert_lighting = 0.75f + 0.08f * occlusionLevel;
+
+    gl_Position = viewProjection * vec4(vert_pos + vec3(chunkOrigin.x, 0, chunkOrigin.y), 1);
+}
@@ -11,7 +11,8 @@ uniform sampler2DArray atlas;
 out vec4 color;
 
 void main() {
-    vec4 tex = texture(atlas, vec3(vert_uv, textureIdx));
+    // Merged quads span several blocks, the texture repeats once per block
+    vec4 tex = texture(atlas, vec3(fract(vert_uv), textureIdx));
     
     // DEBUG: Show texture index as color gradient
     if (false) { // Change to true to enable debug
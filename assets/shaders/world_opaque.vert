@@ -5,9 +5,17 @@ layout(location = 0) in uint data_01;   // bytes 0-1
 layout(location = 1) in uint data_23;   // bytes 2-3  
 layout(location = 2) in uint data_45;   // bytes 4-5
 
-uniform mat4 MVP;
-uniform vec3 lightDirection;
-uniform uint textureAnimation;
+// Origine du chunk de chaque draw (une par commande de glMultiDrawArraysIndirect, voir ChunkMegaBuffer)
+layout(location = 3) in ivec2 chunkOrigin;
+
+// Données communes à toute la frame, voir FrameUniforms.hpp
+layout(std140, binding = 0) uniform FrameUniforms {
+    mat4 viewProjection;
+    vec4 lightDirection;
+    uint textureAnimation;
+    float zNear;
+    float zFar;
+};
 
 flat out uint textureIdx;
 
@@ -15,10 +23,13 @@ out float vert_lighting;
 out vec3 vert_pos;
 out vec2 vert_uv;
 
+// Nombre d'images des textures animées
+const uint animationFrames = 32u;
+
 void main() {
     // Extract data from bytes 0-1
     // Byte 0: x(5 bits) + z_low(3 bits)
-    // Byte 1: z_high(2 bits) + u(1 bit) + v(1 bit) + spare(4 bits)
+    // Byte 1: z_high(2 bits) + u(1 bit) + v(1 bit) + uScale-1(4 bits)
     uint byte0 = data_01 & 0xFF;
     uint byte1 = (data_01 >> 8) & 0xFF;
     
@@ -29,6 +40,7 @@ void main() {
     
     uint xUv = (byte1 >> 2) & 0x01;                   // bit 2 of byte 1
     uint yUv = (byte1 >> 3) & 0x01;                   // bit 3 of byte 1
+    uint uScale = ((byte1 >> 4) & 0x0F) + 1;          // bits 4-7 of byte 1 (greedy quads)
     
     // Extract data from bytes 2-3
     // Byte 2: y(8 bits)
@@ -38,15 +50,18 @@ void main() {
     
     // Extract data from bytes 4-5
     // Byte 4: occlusion(2 bits) + animated(1 bit) + spare(5 bits)
+    // Byte 5: vScale-1(4 bits) + spare(4 bits)
     uint byte4 = data_45 & 0xFF;
+    uint byte5 = (data_45 >> 8) & 0xFF;
     uint occlusionLevel = byte4 & 0x03;               // bits 0-1 of byte 4
     uint animated = (byte4 >> 2) & 0x01;              // bit 2 of byte 4
+    uint vScale = (byte5 & 0x0F) + 1;                 // bits 0-3 of byte 5 (greedy quads)
     
     // Calculate final values
     vert_pos = vec3(xPos, yPos, zPos);
-    vert_uv = vec2(xUv, yUv);
-    textureIdx = baseTextureIdx + textureAnimation * animated;
+    vert_uv = vec2(xUv * uScale, yUv * vScale);
+    textureIdx = baseTextureIdx + (textureAnimation % animationFrames) * animated;
     vert_lighting = 0.75f + 0.08f * occlusionLevel;
     
-    gl_Position = MVP * vec4(vert_pos, 1);
+    gl_Position = viewProjection * vec4(vert_pos + vec3(chunkOrigin.x, 0, chunkOrigin.y), 1);
 }
\ No newline at end of file
@@ -8,8 +8,15 @@ in vec2 vert_uv;
 
 uniform sampler2DArray atlas;
 uniform sampler2D opaqueDepth;
-uniform float zFar;
-uniform float zNear;
+
+// Données communes à toute la frame, voir FrameUniforms.hpp
+layout(std140, binding = 0) uniform FrameUniforms {
+    mat4 viewProjection;
+    vec4 lightDirection;
+    uint textureAnimation;
+    float zNear;
+    float zFar;
+};
 
 layout(location = 0) out vec4 accumTexture;
 layout(location = 1) out vec4 revealageTexture;
@@ -27,7 +34,8 @@ void main() {
     if (gl_FragCoord.z > texelFetch(opaqueDepth, ivec2(gl_FragCoord.xy), 0).r + 0.000005){
         discard;
     }
-    vec4 texture = texture(atlas, vec3(vert_uv, textureIdx));
+    // Merged quads span several blocks, the texture repeats once per block
+    vec4 texture = texture(atlas, vec3(fract(vert_uv), textureIdx));
     if (texture.a == 1) discard; // opaque objects are already drawn
     accumTexture = vec4(texture.xyz * vert_lighting, texture.w) * weight(gl_FragCoord.z, texture.w);
     revealageTexture = vec4(texture.w);
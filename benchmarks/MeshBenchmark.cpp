@@ -0,0 +1,178 @@
+/**
+ * @file MeshBenchmark.cpp
+ * @brief Block storage size, build time and size of the chunk meshes on generated terrain
+ *
+ * @details Generated chunks are snapshotted with their generated neighbors and meshed in every
+ *          format and ambient occlusion combination. Run on a Release build, with the number of
+ *          repetitions as the optional argument.
+ */
+
+#include "../src/Common.hpp"
+#include "../src/World/Chunk.hpp"
+#include "../src/World/ChunkMeshBuilder.hpp"
+#include "../src/World/ChunkSnapshot.hpp"
+#include "../src/World/WorldGenerator.hpp"
+
+#include <chrono>
+#include <limits>
+
+namespace {
+	constexpr int32_t GridSize = 7;
+	constexpr int32_t DefaultRepetitions = 5;
+
+	/**
+	 * @brief Size of a block in the storage the palette replaced: a BlockData holding its type
+	 *        and class as two int sized enums, for every block of the chunk
+	 */
+	constexpr size_t RawBlockDataSize = 8;
+	constexpr size_t RawChunkSize = static_cast<size_t>(Chunk::BlockCount) * RawBlockDataSize;
+
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * @brief A generated grid of chunks, and the snapshots of the chunks that have all their
+	 *        neighbors
+	 */
+	struct Terrain {
+		std::vector<std::unique_ptr<Chunk>> chunks;
+		std::vector<const Chunk*> innerChunks;
+		std::vector<std::array<const Chunk*, 9>> neighbors;
+		std::vector<ChunkSnapshot> snapshots;
+	};
+
+	Terrain generateTerrain() {
+		Terrain terrain;
+		WorldGenerator generator(1337);
+		for (int32_t z = 0; z < GridSize; ++z) {
+			for (int32_t x = 0; x < GridSize; ++x) {
+				terrain.chunks.push_back(std::make_unique<Chunk>(glm::ivec2(x, z) * Chunk::HorizontalSize));
+				generator.populateChunk(*terrain.chunks.back());
+			}
+		}
+
+		for (int32_t z = 1; z < GridSize - 1; ++z) {
+			for (int32_t x = 1; x < GridSize - 1; ++x) {
+				std::array<const Chunk*, 9> neighbors{};
+				for (int32_t dz = -1; dz <= 1; ++dz) {
+					for (int32_t dx = -1; dx <= 1; ++dx) {
+						neighbors[(dx + 1) + (dz + 1) * 3] = terrain.chunks[(x + dx) + (z + dz) * GridSize].get();
+					}
+				}
+				terrain.innerChunks.push_back(terrain.chunks[x + z * GridSize].get());
+				terrain.neighbors.push_back(neighbors);
+			}
+		}
+
+		terrain.snapshots.resize(terrain.innerChunks.size());
+		for (size_t i = 0; i < terrain.snapshots.size(); ++i) {
+			terrain.snapshots[i].capture(*terrain.innerChunks[i], terrain.neighbors[i]);
+		}
+		return terrain;
+	}
+
+	/**
+	 * @brief Milliseconds per item to run work on items 0 to count - 1, the best of the
+	 *        repetitions
+	 */
+	template <typename Work>
+	double measure(size_t count, int32_t repetitions, const Work& work) {
+		double best = std::numeric_limits<double>::max();
+		for (int32_t repetition = 0; repetition < repetitions; ++repetition) {
+			const Clock::time_point start = Clock::now();
+			for (size_t i = 0; i < count; ++i) {
+				work(i);
+			}
+			const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+			best = std::min(best, elapsed.count() / static_cast<double>(count));
+		}
+		return best;
+	}
+
+	const char* getFormatName(ChunkMeshFormat format) {
+		return format == ChunkMeshFormat::faceRecords ? "face records" : "vertices";
+	}
+
+	/**
+	 * @brief Block bytes of a chunk: its sections and the palettes and indices they own
+	 */
+	size_t getBlockBytes(const Chunk& chunk) {
+		return sizeof(ChunkSection) * Chunk::SectionCount + chunk.getBlockMemoryUsage();
+	}
+
+	/**
+	 * @brief Memory of the paletted block storage against the raw layout it replaced, and the
+	 *        time to snapshot and mesh the chunks read from it
+	 */
+	void benchmarkBlockStorage(Terrain& terrain, int32_t repetitions) {
+		size_t palettedBytes = 0;
+		for (const Chunk* chunk : terrain.innerChunks) {
+			palettedBytes += getBlockBytes(*chunk);
+		}
+		palettedBytes /= terrain.innerChunks.size();
+
+		const double captureTime = measure(terrain.snapshots.size(), repetitions, [&](size_t i) {
+			terrain.snapshots[i].capture(*terrain.innerChunks[i], terrain.neighbors[i]);
+		});
+		ChunkMeshData meshData;
+		const double meshTime = measure(terrain.snapshots.size(), repetitions, [&](size_t i) {
+			ChunkMeshBuilder::buildMesh(terrain.snapshots[i], true, meshData);
+		});
+
+		// Cold chunks, last since the blocks of a compressed chunk are decompressed when read
+		size_t compressedBytes = 0;
+		for (const std::unique_ptr<Chunk>& chunk : terrain.chunks) {
+			chunk->compressBlocks();
+		}
+		for (const Chunk* chunk : terrain.innerChunks) {
+			compressedBytes += getBlockBytes(*chunk);
+		}
+		compressedBytes /= terrain.innerChunks.size();
+
+		std::printf("Block storage (bytes per chunk, ms/chunk)\n");
+		std::printf("  raw %zu  paletted %zu (%.1f%%)  compressed %zu (%.1f%%)\n", RawChunkSize, palettedBytes,
+					100.0 * static_cast<double>(palettedBytes) / RawChunkSize, compressedBytes,
+					100.0 * static_cast<double>(compressedBytes) / RawChunkSize);
+		std::printf("  snapshot %7.3f  mesh %7.3f\n", captureTime, meshTime);
+	}
+
+	/**
+	 * @brief Size and build time of greedy meshes against per-face meshes
+	 */
+	void benchmarkGreedyMeshing(const std::vector<ChunkSnapshot>& snapshots, int32_t repetitions) {
+		std::printf("Greedy vs per-face meshes (vertices or faces per chunk, ms/chunk)\n");
+		for (ChunkMeshFormat format : {ChunkMeshFormat::vertices, ChunkMeshFormat::faceRecords}) {
+			for (bool useAmbientOcclusion : {false, true}) {
+				std::array<size_t, 2> sizes{};
+				std::array<double, 2> times{};
+				for (bool useGreedyMeshing : {false, true}) {
+					ChunkMeshData meshData;
+					const auto build = [&](size_t i) {
+						ChunkMeshBuilder::buildMesh(snapshots[i], useAmbientOcclusion, meshData, LODLevel::Full,
+													useGreedyMeshing, format);
+					};
+					for (size_t i = 0; i < snapshots.size(); ++i) {
+						build(i);
+						sizes[useGreedyMeshing] += format == ChunkMeshFormat::faceRecords ? meshData.faces.size()
+																						   : meshData.vertices.size();
+					}
+					sizes[useGreedyMeshing] /= snapshots.size();
+					times[useGreedyMeshing] = measure(snapshots.size(), repetitions, build);
+				}
+				std::printf("  %-12s AO %-3s  per face %6zu %7.3f  greedy %6zu %7.3f  size %.1f%%\n",
+							getFormatName(format), useAmbientOcclusion ? "on" : "off", sizes[0], times[0], sizes[1],
+							times[1], 100.0 * static_cast<double>(sizes[1]) / static_cast<double>(sizes[0]));
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	const int32_t repetitions = argc > 1 ? std::max(1, std::atoi(argv[1])) : DefaultRepetitions;
+	Terrain terrain = generateTerrain();
+	std::printf("%zu chunks, best of %d repetitions\n\n", terrain.snapshots.size(), repetitions);
+
+	benchmarkGreedyMeshing(terrain.snapshots, repetitions);
+	std::printf("\n");
+	benchmarkBlockStorage(terrain, repetitions);
+	return 0;
+}
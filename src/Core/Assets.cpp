@@ -3,6 +3,7 @@
 #include "../Rendering/Shaders.hpp"
 #include "../Rendering/Textures.hpp"
 #include "../Utils/Utils.hpp"
+#include "../World/BlockRegistry.hpp"
 
 #include <nlohmann/json.hpp>
 
@@ -104,59 +105,50 @@ void Assets::TextureAtlas::loadAtlas(const std::string& jsonPath, Assets& assets
 	padding = j["atlas"].value("padding", 0);
 
 	std::vector<std::vector<uint8_t>> textureData;
+	BlockRegistry& registry = BlockRegistry::getInstance();
 
 	// Load all texture files from blocks array
 	for (const auto& block : j["blocks"]) {
 		std::string blockName = block["name"];
 
-		// Convert string to BlockType
-		BlockData::BlockType blockType = BlockData::BlockType::air;
-		if (blockName == "bedrock")
-			blockType = BlockData::BlockType::bedrock;
-		else if (blockName == "planks")
-			blockType = BlockData::BlockType::planks;
-		else if (blockName == "grass")
-			blockType = BlockData::BlockType::grass;
-		else if (blockName == "dirt")
-			blockType = BlockData::BlockType::dirt;
-		else if (blockName == "sand")
-			blockType = BlockData::BlockType::sand;
-		else if (blockName == "stone")
-			blockType = BlockData::BlockType::stone;
-		else if (blockName == "cobblestone")
-			blockType = BlockData::BlockType::cobblestone;
-		else if (blockName == "glass")
-			blockType = BlockData::BlockType::glass;
-		else if (blockName == "oak_wood")
-			blockType = BlockData::BlockType::oak_wood;
-		else if (blockName == "oak_leaves")
-			blockType = BlockData::BlockType::oak_leaves;
-		else if (blockName == "water")
-			blockType = BlockData::BlockType::water;
-		else if (blockName == "lava")
-			blockType = BlockData::BlockType::lava;
-		else if (blockName == "iron")
-			blockType = BlockData::BlockType::iron;
-		else if (blockName == "diamond")
-			blockType = BlockData::BlockType::diamond;
-		else if (blockName == "gold")
-			blockType = BlockData::BlockType::gold;
-		else if (blockName == "obsidian")
-			blockType = BlockData::BlockType::obsidian;
-		else if (blockName == "sponge")
-			blockType = BlockData::BlockType::sponge;
-		BlockTextureData blockData;
+		BlockData::BlockType blockType;
+		if (!registry.findByName(blockName, blockType)) {
+			std::cerr << "Unknown block in texture atlas configuration: " << blockName << std::endl;
+			continue;
+		}
 
-		// Check if animated
-		blockData.animated = block.value("animated", false);
-		if (blockData.animated) {
-			blockData.frames = block.value("frames", 1);
-			blockData.frame_duration = block.value("frame_duration", 0.0f);
-		} else {
-			blockData.frames = 1;
-			blockData.frame_duration = 0;
+		// Optional overrides of the compiled-in block properties
+		if (block.contains("class")) {
+			const std::string className = block["class"];
+			if (className == "solid") {
+				registry.setClass(blockType, BlockData::BlockClass::solid);
+			} else if (className == "semiTransparent") {
+				registry.setClass(blockType, BlockData::BlockClass::semiTransparent);
+			} else if (className == "transparent") {
+				registry.setClass(blockType, BlockData::BlockClass::transparent);
+			} else {
+				std::cerr << "Unknown block class " << className << " for block " << blockName
+						  << std::endl;
+			}
+		}
+		if (block.contains("opacity")) {
+			registry.setOpacity(blockType, block["opacity"].get<uint8_t>());
+		}
+		if (block.contains("color")) {
+			const auto& color = block["color"];
+			const float alpha = color.size() > 3 ? color[3].get<float>() : 1.0f;
+			registry.setColor(blockType, glm::vec4(color[0], color[1], color[2], alpha));
+		}
+		if (block.contains("light")) {
+			registry.setLightEmission(blockType, block["light"].get<uint8_t>());
 		}
 
+		// Check if animated
+		const bool animated = block.value("animated", false);
+		const int frames = animated ? block.value("frames", 1) : 1;
+		const float frameDuration = animated ? block.value("frame_duration", 0.0f) : 0.0f;
+		registry.setAnimation(blockType, static_cast<uint8_t>(frames), frameDuration);
+
 		// Load face textures
 		std::string directory = block["directory"];
 		auto faces = block["faces"];
@@ -187,9 +179,9 @@ void Assets::TextureAtlas::loadAtlas(const std::string& jsonPath, Assets& assets
 
 			// For animated textures, expect vertical tile layout
 			// For static textures, use the entire image
-			if (blockData.animated) {
+			if (animated) {
 				int tilesPerCol = image->height / tileHeight;
-				for (int frame = 0; frame < std::min(blockData.frames, tilesPerCol); frame++) {
+				for (int frame = 0; frame < std::min(frames, tilesPerCol); frame++) {
 					std::vector<uint8_t> tileData(tileWidth * tileHeight * 4);
 
 					// Copy tile data from vertical strip
@@ -208,7 +200,7 @@ void Assets::TextureAtlas::loadAtlas(const std::string& jsonPath, Assets& assets
 						}
 					}
 
-					blockData.faceIndices[i] = textureData.size();
+					registry.setFaceLayer(blockType, i, static_cast<uint8_t>(textureData.size()));
 					textureData.push_back(std::move(tileData));
 				}
 			} else {
@@ -236,12 +228,10 @@ void Assets::TextureAtlas::loadAtlas(const std::string& jsonPath, Assets& assets
 					}
 				}
 
-				blockData.faceIndices[i] = textureData.size();
+				registry.setFaceLayer(blockType, i, static_cast<uint8_t>(textureData.size()));
 				textureData.push_back(std::move(tileData));
 			}
 		}
-
-		mapping[blockType] = blockData;
 	}
 
 	// Create texture array
@@ -282,18 +272,3 @@ void Assets::TextureAtlas::loadAtlas(const std::string& jsonPath, Assets& assets
 	atlasTexture->unbind();
 
 }
-
-BlockTextureData Assets::TextureAtlas::getBlockTextureData(BlockData::BlockType type) const {
-	auto it = mapping.find(type);
-	if (it != mapping.end()) {
-		return it->second;
-	}
-
-	// Return default texture data if not found
-	BlockTextureData defaultData;
-	defaultData.animated = false;
-	defaultData.frames = 1;
-	defaultData.frame_duration = 0;
-	std::fill(defaultData.faceIndices.begin(), defaultData.faceIndices.end(), 0);
-	return defaultData;
-}
\ No newline at end of file
@@ -13,16 +13,6 @@ class ShaderProgram;
 class Texture;
 struct Image;
 
-// Structure qui contiendra pour un bloc la correspondance des 6 faces (ordre : top, east, west,
-// north, south, bottom) ainsi que des informations pour les textures animées.
-struct BlockTextureData {
-	std::array<uint8_t, 6>
-		faceIndices;  // Chaque valeur correspond à la couche dans le texture array.
-	bool animated;
-	int frames;
-	float frame_duration;
-};
-
 class Assets {
 	// Un seul cache générique
 	template <typename T>
@@ -43,12 +33,8 @@ class Assets {
 		int tileHeight;
 		int padding;
 
-		// Mapping de BlockData::BlockType vers la configuration de texture (pour les 6 faces et
-		// animation)
-		std::unordered_map<BlockData::BlockType, BlockTextureData> mapping;
-
+		// Les couches de texture de chaque face sont enregistrées dans le BlockRegistry
 		void loadAtlas(const std::string& jsonPath, Assets& assets);
-		BlockTextureData getBlockTextureData(BlockData::BlockType type) const;
 	} atlas;
 
 	// Helper methods for cache management
@@ -77,9 +63,6 @@ public:
 	// Atlas access
 	const TextureAtlas& getAtlas() const { return atlas; }
 	Ref<const Texture> getAtlasTexture() const { return atlas.atlasTexture; }
-	BlockTextureData getBlockTextureData(BlockData::BlockType type) const {
-		return atlas.getBlockTextureData(type);
-	}
 
 	// Load texture atlas
 	void loadTextureAtlas(const std::string& jsonPath = "assets/textures/textures.json");
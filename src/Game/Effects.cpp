@@ -40,7 +40,11 @@ ChromaticAberrationEffect::ChromaticAberrationEffect(Window& window, Assets& ass
 	: PostProcessEffect(window,
 						assets,
 						assets.loadShaderProgram("assets/shaders/chromatic_aberration_effect"),
-						enabled) {}
+						enabled),
+	  startUniform(shader->getUniform<float>("start")),
+	  rOffsetUniform(shader->getUniform<float>("rOffset")),
+	  gOffsetUniform(shader->getUniform<float>("gOffset")),
+	  bOffsetUniform(shader->getUniform<float>("bOffset")) {}
 
 void ChromaticAberrationEffect::renderGui() {
 	ImGui::Checkbox("Enable chromatic aberration effect", &enabled);
@@ -53,16 +57,20 @@ void ChromaticAberrationEffect::renderGui() {
 }
 
 void ChromaticAberrationEffect::update() {
-	shader->setFloat("start", aberrationStart);
-	shader->setFloat("rOffset", aberrationROffset);
-	shader->setFloat("gOffset", aberrationGOffset);
-	shader->setFloat("bOffset", aberrationBOffset);
+	shader->set(startUniform, aberrationStart);
+	shader->set(rOffsetUniform, aberrationROffset);
+	shader->set(gOffsetUniform, aberrationGOffset);
+	shader->set(bOffsetUniform, aberrationBOffset);
 }
 
 // CrosshairEffect implementation
 CrosshairEffect::CrosshairEffect(Window& window, Assets& assets, bool enabled)
 	: PostProcessEffect(
-		  window, assets, assets.loadShaderProgram("assets/shaders/crosshair"), enabled) {}
+		  window, assets, assets.loadShaderProgram("assets/shaders/crosshair"), enabled),
+	  sizeUniform(shader->getUniform<float>("size")),
+	  verticalWidthUniform(shader->getUniform<float>("verticalWidth")),
+	  horizontalWidthUniform(shader->getUniform<float>("horizontalWidth")),
+	  aspectRatioUniform(shader->getUniform<float>("aspectRatio")) {}
 
 void CrosshairEffect::renderGui() {
 	ImGui::Checkbox("Enable crosshair", &enabled);
@@ -79,19 +87,20 @@ void CrosshairEffect::update() {
 	float aspectRatio =
 		width == 0 || height == 0 ? 0 : static_cast<float>(width) / static_cast<float>(height);
 
-	shader->setFloat("size", crosshairSize);
-	shader->setFloat("verticalWidth", crosshairVerticalWidth);
-	shader->setFloat("horizontalWidth", crosshairHorizontalWidth);
-	shader->setFloat("aspectRatio", aspectRatio);
+	shader->set(sizeUniform, crosshairSize);
+	shader->set(verticalWidthUniform, crosshairVerticalWidth);
+	shader->set(horizontalWidthUniform, crosshairHorizontalWidth);
+	shader->set(aspectRatioUniform, aspectRatio);
 }
 
 // GammaCorrectionEffect implementation
 GammaCorrectionEffect::GammaCorrectionEffect(Window& window, Assets& assets, bool enabled)
 	: PostProcessEffect(
-		  window, assets, assets.loadShaderProgram("assets/shaders/gamma_correction"), enabled) {}
+		  window, assets, assets.loadShaderProgram("assets/shaders/gamma_correction"), enabled),
+	  powerUniform(shader->getUniform<float>("power")) {}
 
 void GammaCorrectionEffect::update() {
-	shader->setFloat("power", power);
+	shader->set(powerUniform, power);
 }
 
 void GammaCorrectionEffect::renderGui() {
@@ -192,11 +201,13 @@ void InvertEffect::renderGui() {
 // VignetteEffect implementation
 VignetteEffect::VignetteEffect(Window& window, Assets& assets, bool enabled)
 	: PostProcessEffect(
-		  window, assets, assets.loadShaderProgram("assets/shaders/vignette_effect"), enabled) {}
+		  window, assets, assets.loadShaderProgram("assets/shaders/vignette_effect"), enabled),
+	  intensityUniform(shader->getUniform<float>("intensity")),
+	  startUniform(shader->getUniform<float>("start")) {}
 
 void VignetteEffect::update() {
-	shader->setFloat("intensity", vignetteIntensity);
-	shader->setFloat("start", vignetteStart);
+	shader->set(intensityUniform, vignetteIntensity);
+	shader->set(startUniform, vignetteStart);
 }
 
 void VignetteEffect::renderGui() {
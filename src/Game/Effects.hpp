@@ -37,6 +37,10 @@ class ChromaticAberrationEffect : public PostProcessEffect {
 	float aberrationROffset = 0.005;
 	float aberrationGOffset = 0.01;
 	float aberrationBOffset = -0.005;
+	ShaderProgram::Uniform<float> startUniform;
+	ShaderProgram::Uniform<float> rOffsetUniform;
+	ShaderProgram::Uniform<float> gOffsetUniform;
+	ShaderProgram::Uniform<float> bOffsetUniform;
 
    public:
 	ChromaticAberrationEffect(Window& window, Assets& assets, bool enabled);
@@ -50,6 +54,10 @@ class CrosshairEffect : public PostProcessEffect {
 	float crosshairSize = 0.015f;
 	float crosshairVerticalWidth = 0.2f;
 	float crosshairHorizontalWidth = 0.15f;
+	ShaderProgram::Uniform<float> sizeUniform;
+	ShaderProgram::Uniform<float> verticalWidthUniform;
+	ShaderProgram::Uniform<float> horizontalWidthUniform;
+	ShaderProgram::Uniform<float> aspectRatioUniform;
 
    public:
 	CrosshairEffect(Window& window, Assets& assets, bool enabled);
@@ -61,6 +69,7 @@ class CrosshairEffect : public PostProcessEffect {
 // GammaCorrectionEffect
 class GammaCorrectionEffect : public PostProcessEffect {
 	float power = 0.85;
+	ShaderProgram::Uniform<float> powerUniform;
 
    public:
 	GammaCorrectionEffect(Window& window, Assets& assets, bool enabled);
@@ -108,6 +117,8 @@ class InvertEffect : public PostProcessEffect {
 class VignetteEffect : public PostProcessEffect {
 	float vignetteIntensity = 2.9;
 	float vignetteStart = 2;
+	ShaderProgram::Uniform<float> intensityUniform;
+	ShaderProgram::Uniform<float> startUniform;
 
    public:
 	VignetteEffect(Window& window, Assets& assets, bool enabled);
@@ -3,9 +3,36 @@
 #include "../Utils/Utils.hpp"
 
 #include <cstdlib>
+#include <sstream>
 
 #define SERIALIZE_DATA
 
+namespace {
+	/**
+	 * @brief Save file header, absent from the original raw format
+	 */
+	constexpr std::array<char, 4> SaveMagic = {'M', 'P', 'P', 'W'};
+	constexpr uint32_t SaveVersion = 3;
+
+	/**
+	 * @brief First paletted format, a single palette for the whole chunk in XYZ order
+	 */
+	constexpr uint32_t ChunkPaletteSaveVersion = 1;
+
+	/**
+	 * @brief Per-section palettes without the heightmaps
+	 */
+	constexpr uint32_t SectionPaletteSaveVersion = 2;
+
+	/**
+	 * @brief Block layout of the original format, one full BlockData per block
+	 */
+	struct LegacyBlockData {
+		int32_t type;
+		int32_t blockClass;
+	};
+}
+
 Persistence::Persistence(std::string newPath) : path(std::move(newPath)) {
 	TRACE_FUNCTION();
 #ifdef SERIALIZE_DATA
@@ -25,20 +52,107 @@ Persistence::Persistence(std::string newPath) : path(std::move(newPath)) {
 
 	file.seekg(0, std::ios::beg);
 
+	std::array<char, 4> magic{};
+	uint32_t version = 0;
+	file.read(magic.data(), magic.size());
+	file.read(reinterpret_cast<char*>(&version), sizeof(version));
+	if (file && magic == SaveMagic &&
+		(version == SaveVersion || version == SectionPaletteSaveVersion ||
+		 version == ChunkPaletteSaveVersion)) {
+		loadPalettedChunks(file, version);
+	} else {
+		file.clear();
+		file.seekg(0, std::ios::beg);
+		loadLegacyChunks(file, length);
+	}
+#endif
+}
+
+void Persistence::loadPalettedChunks(std::ifstream& file, uint32_t version) {
+	TRACE_FUNCTION();
 	file.read(reinterpret_cast<char*>(&camera), sizeof(camera));
-	size_t chunkCount = (length - sizeof(Camera)) / (sizeof(glm::ivec2) + sizeof(Chunk::data));
 
-	for (size_t i = 0; i < chunkCount; i++) {
+	// Chunks are parsed to validate them (and convert older versions), then kept serialized
+	Chunk chunk(glm::ivec2(0));
+	glm::ivec2 worldPosition;
+	while (file.read(reinterpret_cast<char*>(&worldPosition[0]), sizeof(glm::ivec2))) {
 		TRACE_SCOPE("Persistence::Persistence::loadChunk");
-		glm::ivec2 worldPosition;
-		file.read(reinterpret_cast<char*>(&worldPosition[0]), sizeof(glm::ivec2));
+		chunk.reset(worldPosition);
+		bool isValid = version == ChunkPaletteSaveVersion ? readChunkPaletteData(file, chunk)
+														  : readSectionData(file, chunk, version);
+		if (!isValid) {
+			std::cerr << "Corrupted chunk data in: " << path << std::endl;
+			return;
+		}
+
+		commitChunk(chunk);
+	}
+}
 
-		Ref<Chunk> chunk = std::make_shared<Chunk>(worldPosition);
-		file.read(reinterpret_cast<char*>(chunk->data.data()), sizeof(Chunk::data));
+bool Persistence::readSectionData(std::istream& stream, Chunk& chunk, uint32_t version) {
+	for (auto& section : chunk.sections) {
+		if (!section.read(stream)) {
+			return false;
+		}
+	}
 
-		chunks[worldPosition] = chunk;
+	if (version == SectionPaletteSaveVersion) {
+		chunk.recomputeHeightmaps();
+		return true;
+	}
+	return chunk.solidHeightmap.read(stream, Chunk::VerticalSize) &&
+		   chunk.nonAirHeightmap.read(stream, Chunk::VerticalSize);
+}
+
+bool Persistence::readChunkPaletteData(std::istream& stream, Chunk& chunk) {
+	PalettedBlockStorage storage(Chunk::BlockCount);
+	if (!storage.read(stream)) {
+		return false;
+	}
+
+	for (int32_t z = 0; z < Chunk::HorizontalSize; z++) {
+		for (int32_t y = 0; y < Chunk::VerticalSize; y++) {
+			for (int32_t x = 0; x < Chunk::HorizontalSize; x++) {
+				int32_t index = x + y * Chunk::HorizontalSize +
+								z * Chunk::HorizontalSize * Chunk::VerticalSize;
+				chunk.placeBlock(storage.get(index), x, y, z);
+			}
+		}
+	}
+	return true;
+}
+
+void Persistence::loadLegacyChunks(std::ifstream& file, size_t length) {
+	TRACE_FUNCTION();
+	using LegacyChunkData = std::array<LegacyBlockData, Chunk::BlockCount>;
+
+	file.read(reinterpret_cast<char*>(&camera), sizeof(camera));
+	size_t chunkCount = (length - sizeof(Camera)) / (sizeof(glm::ivec2) + sizeof(LegacyChunkData));
+
+	auto legacyData = std::make_unique<LegacyChunkData>();
+	Chunk chunk(glm::ivec2(0));
+	for (size_t i = 0; i < chunkCount; i++) {
+		TRACE_SCOPE("Persistence::Persistence::loadLegacyChunk");
+		glm::ivec2 worldPosition;
+		file.read(reinterpret_cast<char*>(&worldPosition[0]), sizeof(glm::ivec2));
+		file.read(reinterpret_cast<char*>(legacyData->data()), sizeof(LegacyChunkData));
+
+		chunk.reset(worldPosition);
+		for (int32_t z = 0; z < Chunk::HorizontalSize; z++) {
+			for (int32_t y = 0; y < Chunk::VerticalSize; y++) {
+				for (int32_t x = 0; x < Chunk::HorizontalSize; x++) {
+					int32_t index = x + y * Chunk::HorizontalSize +
+									z * Chunk::HorizontalSize * Chunk::VerticalSize;
+					auto type = static_cast<BlockData::BlockType>((*legacyData)[index].type);
+					if (static_cast<size_t>(type) < BlockData::TypeCount) {
+						chunk.placeBlock(type, x, y, z);
+					}
+				}
+			}
+		}
+
+		commitChunk(chunk);
 	}
-#endif
 }
 
 Persistence::~Persistence() {
@@ -50,30 +164,49 @@ Persistence::~Persistence() {
 		return;
 	}
 
+	file.write(SaveMagic.data(), SaveMagic.size());
+	file.write(reinterpret_cast<const char*>(&SaveVersion), sizeof(SaveVersion));
 	file.write(reinterpret_cast<char*>(&camera), sizeof(camera));
 
-	for (auto& [key, chunk] : chunks) {
+	for (auto& [key, data] : chunks) {
 		TRACE_SCOPE("Persistence::~Persistence::saveChunk");
 		glm::ivec2 worldPosition = key;
 		file.write(reinterpret_cast<char*>(&worldPosition[0]), sizeof(glm::ivec2));
-		file.write(reinterpret_cast<char*>(chunk->data.data()), sizeof(Chunk::data));
+		file.write(data.data(), static_cast<std::streamsize>(data.size()));
 	}
 #endif
 }
 
-void Persistence::commitChunk(const Ref<Chunk>& chunk) {
+void Persistence::commitChunk(const Chunk& chunk) {
 	TRACE_FUNCTION();
 #ifdef SERIALIZE_DATA
-	chunks[chunk->getPosition()] = chunk;
+	// Same layout as in the save file: uniform sections only cost their palette (3 bytes)
+	chunk.ensureResident();
+	std::ostringstream stream(std::ios::out | std::ios::binary);
+	for (const auto& section : chunk.sections) {
+		section.write(stream);
+	}
+	chunk.solidHeightmap.write(stream);
+	chunk.nonAirHeightmap.write(stream);
+	chunks[chunk.getPosition()] = std::move(stream).str();
 #endif
 }
 
-Ref<Chunk> Persistence::getChunk(glm::ivec2 position) const {
+bool Persistence::loadChunk(Chunk& chunk) const {
 	TRACE_FUNCTION();
-	if (!chunks.contains(position)) {
-		return nullptr;
+	auto it = chunks.find(chunk.getPosition());
+	if (it == chunks.end()) {
+		return false;
+	}
+
+	std::istringstream stream(it->second, std::ios::in | std::ios::binary);
+	if (!readSectionData(stream, chunk, SaveVersion)) {
+		std::cerr << "Corrupted chunk data for chunk " << chunk.getPosition().x << ", "
+				  << chunk.getPosition().y << std::endl;
+		chunk.reset(chunk.getPosition());
+		return false;
 	}
-	return chunks.at(position);
+	return true;
 }
 
 void Persistence::commitCamera(const Camera& newCamera) {
@@ -3,8 +3,14 @@
  * @brief Gère la sauvegarde et le chargement des données de la scène (chunks, caméra).
  *
  * @details La classe Persistence lit et écrit un fichier binaire qui contient la position de la
- * caméra et les données de chaque chunk. Elle offre des méthodes pour committer (sauvegarder) un
- * chunk ou la caméra, et pour récupérer un chunk à partir de son identifiant de position.
+ * caméra et les données de chaque chunk (une palette par section). Les anciennes sauvegardes, qui
+ * contenaient un BlockData complet par bloc, sont converties au chargement. Elle offre des
+ * méthodes pour committer (sauvegarder) un chunk ou la caméra, et pour recharger un chunk à partir
+ * de son identifiant de position. Les heightmaps de chaque chunk sont sauvegardées avec ses
+ * sections.
+ *
+ * Les chunks sont conservés sérialisés (au format du fichier) : le monde les committe lorsqu'il
+ * les décharge, ce qui permet de recycler leur mémoire.
  *
  * @param path Chemin du fichier de sauvegarde.
  */
@@ -19,14 +25,25 @@
 class Persistence {
 	std::string path;
 	Camera camera;
-	std::unordered_map<glm::ivec2, Ref<Chunk>, Util::HashVec2> chunks;
+	std::unordered_map<glm::ivec2, std::string, Util::HashVec2> chunks;	 // Serialized chunk data
+
+	void loadPalettedChunks(std::ifstream& file, uint32_t version);
+	static bool readSectionData(std::istream& stream, Chunk& chunk, uint32_t version);
+	static bool readChunkPaletteData(std::istream& stream, Chunk& chunk);
+	void loadLegacyChunks(std::ifstream& file, size_t length);
 
    public:
 	explicit Persistence(std::string path);
 	~Persistence();
 
-	void commitChunk(const Ref<Chunk>& chunk);
-	[[nodiscard]] Ref<Chunk> getChunk(glm::ivec2 position) const;
+	void commitChunk(const Chunk& chunk);
+
+	/**
+	 * @brief Restores the saved content of the chunk at chunk.getPosition()
+	 * @param chunk Empty chunk to fill
+	 * @return false if the chunk has never been committed
+	 */
+	bool loadChunk(Chunk& chunk) const;
 
 	void commitCamera(const Camera& newCamera);
 	[[nodiscard]] const Camera& getCamera() const;
@@ -4,18 +4,15 @@
  * et niveau d'occlusion.
  *
  * @details La structure de données est codée sur 32 bits avec des segments dédiés à la position,
- * aux UV, au tile index, au flag d'animation et à l'occlusion. Les méthodes setType(),
+ * aux UV, au tile index, au flag d'animation et à l'occlusion. Les méthodes setTextureIndex(),
  * setOcclusionLevel(), etc. permettent d'en modifier les valeurs.
  */
 
 #pragma once
 
 #include "../Common.hpp"
-#include "../World/BlockTypes.hpp"
 #include "Buffers.hpp"
 
-class Assets;
-
 /**
  * Data layout optimisé (24 bits = 3 octets):
  *
@@ -24,7 +21,7 @@ class Assets;
  *   05-09: z coordinates (5 bits) - max 31
  *   10-10: u coordinate  (1 bit)
  *   11-11: v coordinate  (1 bit)
- *   12-15: spare         (4 bits) - reserved for future use
+ *   12-15: u scale - 1   (4 bits) - texture repetitions of a merged quad along u
  *
  * uint8_t posY (8 bits):
  *   00-07: y coordinates (8 bits) - max 255
@@ -35,7 +32,9 @@ class Assets;
  * uint16_t flags (16 bits):
  *   00-01: occlusion     (2 bits)
  *   02-02: animated      (1 bit)
- *   03-15: spare         (13 bits) - reserved for future use
+ *   03-07: spare         (5 bits) - reserved for future use
+ *   08-11: v scale - 1   (4 bits) - texture repetitions of a merged quad along v
+ *   12-15: spare         (4 bits) - reserved for future use
  */
 
 #pragma pack(push, 1)
@@ -46,14 +45,13 @@ class BlockVertex {
 
 	// Layout:
 	// data[0] = x(5 bits) + z_low(3 bits)
-	// data[1] = z_high(2 bits) + u(1 bit) + v(1 bit) + spare(4 bits)
+	// data[1] = z_high(2 bits) + u(1 bit) + v(1 bit) + uScale-1(4 bits)
 	// data[2] = y(8 bits)
 	// data[3] = textureIndex(8 bits)
 	// data[4] = occlusion(2 bits) + animated(1 bit) + spare(5 bits)
-	// data[5] = spare(8 bits)
+	// data[5] = vScale-1(4 bits) + spare(4 bits)
 
 	void setUv(bool u, bool v);
-	void setTextureIndexInternal(uint8_t tileIndex);
 
    public:
 	BlockVertex() = default;
@@ -62,10 +60,20 @@ class BlockVertex {
 	void setPosition(uint8_t x, uint8_t y, uint8_t z);
 	void offset(uint32_t x, uint32_t y, uint32_t z);
 	void setAnimated();
-	void setType(const glm::ivec3& offset, BlockData::BlockType type, const Assets& assets);
+	/**
+	 * @brief Sets the texture array layer, see BlockRegistry::getFaceLayer
+	 */
+	void setTextureIndex(uint8_t tileIndex) { data[3] = tileIndex; }
 	[[nodiscard]] glm::ivec3 getPosition() const;
+	[[nodiscard]] glm::bvec2 getUv() const { return {(data[1] >> 2) & 1, (data[1] >> 3) & 1}; }
 	void setOcclusionLevel(uint8_t occlusionLevel);
 
+	/**
+	 * @brief Sets how many times the texture repeats along u and v (1 to 16), for faces merged
+	 *        by the greedy mesher
+	 */
+	void setUvScale(uint8_t uScale, uint8_t vScale);
+
 	static std::vector<VertexAttribute> vertexAttributes() {
 		// Send as 3 uint16_t for shader compatibility
 		return {
@@ -78,3 +86,60 @@ class BlockVertex {
 #pragma pack(pop)
 
 static_assert(sizeof(BlockVertex) == 6, "BlockVertex must be exactly 6 bytes");
+
+// Accesseurs appelés pour chaque sommet par le mesher, définis ici pour être inlinés
+inline void BlockVertex::setPosition(uint8_t x, uint8_t y, uint8_t z) {
+	assert(x <= 31 && "X coordinate must be <= 31");
+	assert(z <= 31 && "Z coordinate must be <= 31");
+	assert(y <= 255 && "Y coordinate must be <= 255");
+
+	// data[0] = x(5 bits) + z_low(3 bits)
+	data[0] = (x & 0x1F) | ((z & 0x07) << 5);
+
+	// data[1] = z_high(2 bits) + u(1 bit) + v(1 bit) + spare(4 bits)
+	data[1] = (data[1] & 0xFC) | ((z >> 3) & 0x03);
+
+	// data[2] = y(8 bits)
+	data[2] = y;
+}
+
+inline void BlockVertex::offset(uint32_t x, uint32_t y, uint32_t z) {
+	// Extract current position
+	uint8_t currentX = data[0] & 0x1F;
+	uint8_t currentZ = ((data[0] >> 5) & 0x07) | ((data[1] & 0x03) << 3);
+	uint8_t currentY = data[2];
+
+	// Add offset
+	uint8_t newX = currentX + x;
+	uint8_t newY = currentY + y;
+	uint8_t newZ = currentZ + z;
+
+	// Validate new position
+	assert(newX <= 31 && "X coordinate out of bounds");
+	assert(newZ <= 31 && "Z coordinate out of bounds");
+	assert(newY <= 255 && "Y coordinate out of bounds");
+
+	// Set new position
+	setPosition(newX, newY, newZ);
+}
+
+inline glm::ivec3 BlockVertex::getPosition() const {
+	uint8_t x = data[0] & 0x1F;
+	uint8_t z = ((data[0] >> 5) & 0x07) | ((data[1] & 0x03) << 3);
+	uint8_t y = data[2];
+	return glm::ivec3(x, y, z);
+}
+
+inline void BlockVertex::setOcclusionLevel(uint8_t occlusionLevel) {
+	assert(occlusionLevel < 4 && "Occlusion level must be < 4");
+	// Occlusion bits are 0-1 in data[4]
+	data[4] = (data[4] & 0xFC) | (occlusionLevel & 0x03);
+}
+
+inline void BlockVertex::setUvScale(uint8_t uScale, uint8_t vScale) {
+	assert(uScale >= 1 && uScale <= 16 && "U scale must be in [1, 16]");
+	assert(vScale >= 1 && vScale <= 16 && "V scale must be in [1, 16]");
+	// U scale is in data[1] bits 4-7, v scale in data[5] bits 0-3
+	data[1] = (data[1] & 0x0F) | (((uScale - 1) & 0x0F) << 4);
+	data[5] = (data[5] & 0xF0) | ((vScale - 1) & 0x0F);
+}
@@ -22,6 +22,11 @@ class Buffer {
 
 	void bind() { glBindBuffer(type, id); }
 
+	/**
+	 * @brief Binds the buffer to an indexed binding point, e.g. GL_SHADER_STORAGE_BUFFER
+	 */
+	void bindBase(uint32_t target, uint32_t index) { glBindBufferBase(target, index, id); }
+
 	template <typename T>
 	void bufferStaticData(const std::vector<T>& data, int32_t dataSize, int32_t dataOffset = 0) {
 		TRACE_FUNCTION();
@@ -62,11 +67,11 @@ class Buffer {
 		TRACE_FUNCTION();
 		assert(isValid() && "Cannot write data to an invalid buffer");
 		assert(dataOffset + dataSize <= data.size() && "Data is out of bounds");
-		assert(dataOffset + dataSize <= size && "Buffer is out of bounds");
+		assert(bufferOffset + dataSize <= size && "Buffer is out of bounds");
 
+		// Only part of the buffer is written, its size stays the same
 		bind();
-		size = dataSize;
-		glBufferSubData(type, bufferOffset * sizeof(T), sizeof(T) * size, &data[dataOffset]);
+		glBufferSubData(type, bufferOffset * sizeof(T), sizeof(T) * dataSize, &data[dataOffset]);
 	}
 
 	[[nodiscard]] int32_t getSize() const { return size; }
@@ -87,6 +92,30 @@ class VertexBuffer : public Buffer {
 	static Ref<VertexBuffer> createRef() { return std::make_shared<VertexBuffer>(); }
 };
 
+// Uniform buffer, holds a single std140 block bound to an indexed binding point
+class UniformBuffer : public Buffer {
+   public:
+	UniformBuffer() : Buffer(GL_UNIFORM_BUFFER) {}
+
+	/**
+	 * @brief Writes the whole block, the storage is allocated on the first write and when the
+	 *        block size changes. The size of a uniform buffer is in bytes.
+	 */
+	template <typename T>
+	void bufferDynamicValue(const T& value) {
+		TRACE_FUNCTION();
+		assert(isValid() && "Cannot write data to an invalid buffer");
+
+		bind();
+		if (size != static_cast<int32_t>(sizeof(T))) {
+			size = sizeof(T);
+			glBufferData(type, sizeof(T), &value, GL_DYNAMIC_DRAW);
+		} else {
+			glBufferSubData(type, 0, sizeof(T), &value);
+		}
+	}
+};
+
 // Index buffer
 class IndexBuffer : public Buffer {
 	uint32_t type = 0;
@@ -0,0 +1,99 @@
+/**
+ * @file FaceRecord.hpp
+ * @brief Compact chunk mesh format: one 8 byte record per face instead of 6 BlockVertex
+ *
+ * @details A face drawn with BlockVertex costs 6 vertices of 6 bytes. A FaceRecord stores the
+ *          face once: block position, face direction, texture layer, the occlusion level of its
+ *          4 corners and the size of a greedy quad. The vertex shader (world_faces.vert) reads
+ *          the records from a shader storage buffer and rebuilds the 6 vertices of a face from
+ *          gl_VertexID, so no vertex attribute is used.
+ *
+ * Data layout (2 x 32 bits, read as an uvec2 by the shader):
+ *
+ * uint32_t placement:
+ *   00-03: x coordinate        (4 bits)
+ *   04-07: z coordinate        (4 bits)
+ *   08-15: y coordinate        (8 bits)
+ *   16-23: texture layer       (8 bits)
+ *   24-26: face, BlockMesh order (3 bits)
+ *   27-31: spare               (5 bits)
+ *
+ * uint32_t shading:
+ *   00-07: occlusion of the 4 corners, 2 bits each, corner = u + 2 * v
+ *   08-11: u scale - 1         (4 bits)
+ *   12-15: v scale - 1         (4 bits)
+ *   16-31: spare               (16 bits)
+ *
+ * @note Encoding and decoding only manipulate bits, no GL context is needed.
+ */
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+class FaceRecord {
+   public:
+	static constexpr int32_t VerticesPerFace = 6;
+	static constexpr int32_t CornerCount = 4;
+
+	/**
+	 * @brief Corner of a face vertex from its texture coordinates, as used for the occlusion bits
+	 */
+	[[nodiscard]] static constexpr int32_t getCorner(const glm::bvec2& uv) {
+		return (uv.x ? 1 : 0) | (uv.y ? 2 : 0);
+	}
+
+   private:
+	uint32_t placement = 0;
+	uint32_t shading = 0;
+
+   public:
+	FaceRecord() = default;
+
+	/**
+	 * @param origin Chunk-local position of the block, or of the first block of a merged quad
+	 * @param face Face direction, see BlockRegistry::getFaceIndex
+	 * @param cornerOcclusion Occlusion level (0 to 3) of each corner
+	 * @param uScale, vScale Blocks covered by the face along u and v (1 to 16)
+	 */
+	FaceRecord(const glm::ivec3& origin,
+			   int32_t face,
+			   uint8_t textureLayer,
+			   const std::array<uint8_t, CornerCount>& cornerOcclusion,
+			   uint8_t uScale = 1,
+			   uint8_t vScale = 1) {
+		assert(origin.x >= 0 && origin.x < 16 && "X coordinate must be in [0, 15]");
+		assert(origin.z >= 0 && origin.z < 16 && "Z coordinate must be in [0, 15]");
+		assert(origin.y >= 0 && origin.y < 256 && "Y coordinate must be in [0, 255]");
+		assert(face >= 0 && face < 6 && "Face must be in [0, 5]");
+		assert(uScale >= 1 && uScale <= 16 && "U scale must be in [1, 16]");
+		assert(vScale >= 1 && vScale <= 16 && "V scale must be in [1, 16]");
+
+		placement = (origin.x & 0x0F) | ((origin.z & 0x0F) << 4) | ((origin.y & 0xFF) << 8) |
+					(static_cast<uint32_t>(textureLayer) << 16) | ((face & 0x07) << 24);
+		for (int32_t corner = 0; corner < CornerCount; ++corner) {
+			assert(cornerOcclusion[corner] < 4 && "Occlusion level must be < 4");
+			shading |= (cornerOcclusion[corner] & 0x03u) << (2 * corner);
+		}
+		shading |= ((uScale - 1u) & 0x0F) << 8 | ((vScale - 1u) & 0x0F) << 12;
+	}
+
+	[[nodiscard]] glm::ivec3 getPosition() const {
+		return {placement & 0x0F, (placement >> 8) & 0xFF, (placement >> 4) & 0x0F};
+	}
+	[[nodiscard]] uint8_t getTextureLayer() const { return (placement >> 16) & 0xFF; }
+	[[nodiscard]] int32_t getFace() const { return (placement >> 24) & 0x07; }
+	[[nodiscard]] uint8_t getOcclusionLevel(int32_t corner) const {
+		return (shading >> (2 * corner)) & 0x03;
+	}
+	[[nodiscard]] uint8_t getUScale() const { return ((shading >> 8) & 0x0F) + 1; }
+	[[nodiscard]] uint8_t getVScale() const { return ((shading >> 12) & 0x0F) + 1; }
+
+	bool operator==(const FaceRecord& other) const = default;
+};
+
+static_assert(sizeof(FaceRecord) == 8, "FaceRecord must be exactly 8 bytes");
@@ -0,0 +1,38 @@
+/**
+ * @file FrameUniforms.hpp
+ * @brief Uniform block shared by the world shaders, written once per frame
+ *
+ * @details The data that doesn't change during a frame is no longer set on every program and
+ *          pass: the world shaders declare the block below and read it from a uniform buffer
+ *          bound at FrameUniforms::Binding.
+ *
+ * @code
+ * layout(std140, binding = 0) uniform FrameUniforms {
+ *     mat4 viewProjection;
+ *     vec4 lightDirection;   // xyz, w unused
+ *     uint textureAnimation; // animation frame counter, wrapped by each shader
+ *     float zNear;
+ *     float zFar;
+ * };
+ * @endcode
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+
+struct FrameUniforms {
+	static constexpr uint32_t Binding = 0;
+
+	// std140 layout: every member is aligned on its own size, vec3 on 16 bytes hence the vec4
+	glm::mat4 viewProjection{1};
+	glm::vec4 lightDirection{0};
+	uint32_t textureAnimation = 0;
+	float zNear = 0;
+	float zFar = 0;
+	float padding = 0;
+};
+
+static_assert(offsetof(FrameUniforms, lightDirection) == 64);
+static_assert(offsetof(FrameUniforms, textureAnimation) == 80);
+static_assert(sizeof(FrameUniforms) == 96, "FrameUniforms must match the std140 block");
@@ -0,0 +1,60 @@
+#include "RenderQueue.hpp"
+
+#include "../Utils/Utils.hpp"
+
+void RenderQueue::record(const State& state, const glm::ivec2& origin, int32_t first, int32_t count) {
+	if (count == 0) {
+		return;
+	}
+	if (!commands.empty()) {
+		Command& previous = commands.back();
+		if (previous.getState() == state && previous.origin == origin && previous.first + previous.count == first) {
+			previous.count += count;
+			return;
+		}
+	}
+	commands.push_back({makeKey(state, static_cast<uint32_t>(commands.size())), first, count, origin});
+}
+
+void RenderQueue::sort() {
+	// Keys are unique thanks to the recording order, no need for a stable sort
+	std::sort(commands.begin(), commands.end(),
+			  [](const Command& a, const Command& b) { return a.key < b.key; });
+}
+
+void RenderQueue::execute(Backend& backend) {
+	TRACE_FUNCTION();
+	sort();
+
+	statistics = {};
+	statistics.commands = static_cast<int32_t>(commands.size());
+	std::optional<State> boundState;
+	uint8_t stateBits = DefaultState;
+	for (size_t begin = 0; begin < commands.size();) {
+		const State state = commands[begin].getState();
+		size_t end = begin + 1;
+		while (end < commands.size() && commands[end].getState() == state) {
+			++end;
+		}
+
+		if (!boundState || boundState->pass != state.pass || boundState->shader != state.shader) {
+			backend.bindShader(state.pass, state.shader);
+			statistics.shaderChanges++;
+		}
+		if (state.bits != stateBits) {
+			backend.setState(stateBits, state.bits);
+			stateBits = state.bits;
+			statistics.stateChanges++;
+		}
+		backend.draw(state, std::span<const Command>(commands).subspan(begin, end - begin));
+		statistics.batches++;
+
+		boundState = state;
+		begin = end;
+	}
+
+	if (stateBits != DefaultState) {
+		backend.setState(stateBits, DefaultState);
+		statistics.stateChanges++;
+	}
+}
@@ -0,0 +1,118 @@
+/**
+ * @file RenderQueue.hpp
+ * @brief Draw commands recorded during culling, sorted by state and executed in batches
+ *
+ * @details A pass no longer draws while it walks the visible chunks: each chunk records its
+ *          ranges with the state they need (pass, shader, state bits) and the queue sorts them
+ *          by a 64 bit key so that commands sharing a state follow each other:
+ *
+ *   56-63: spare
+ *   48-55: pass
+ *   40-47: shader
+ *   32-39: state bits (see StateBits)
+ *   00-31: recording order, commands of a state keep the order they were recorded in
+ *
+ *          execute walks the sorted commands and hands each run of a state to a Backend as
+ *          one batch, only binding the shader or changing the state bits when they differ from
+ *          the previous batch.
+ *
+ * @note Recording and sorting make no GL call, a Backend that only counts its calls is enough
+ *       to exercise the queue.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+
+class RenderQueue {
+   public:
+	enum class Pass : uint8_t { opaque, transparent };
+
+	enum StateBits : uint8_t {
+		NoCulling = 1 << 0,  // Faces are drawn from both sides
+	};
+
+	/**
+	 * @brief Default state bits, restored at the end of execute
+	 */
+	static constexpr uint8_t DefaultState = 0;
+
+	struct State {
+		Pass pass = Pass::opaque;
+		uint8_t shader = 0;
+		uint8_t bits = DefaultState;
+
+		bool operator==(const State& other) const = default;
+	};
+
+	struct Command {
+		uint64_t key;
+		int32_t first;
+		int32_t count;
+		glm::ivec2 origin;
+
+		[[nodiscard]] State getState() const {
+			return {static_cast<Pass>((key >> 48) & 0xFF), static_cast<uint8_t>((key >> 40) & 0xFF),
+					static_cast<uint8_t>((key >> 32) & 0xFF)};
+		}
+	};
+
+	/**
+	 * @brief Executes the batches of a queue, see execute
+	 */
+	class Backend {
+	   public:
+		virtual void bindShader(Pass pass, uint8_t shader) = 0;
+		virtual void setState(uint8_t previousBits, uint8_t bits) = 0;
+
+		/**
+		 * @param commands Commands of a single state, in recording order
+		 */
+		virtual void draw(const State& state, std::span<const Command> commands) = 0;
+
+		virtual ~Backend() = default;
+	};
+
+	/**
+	 * @brief Counters of the last execute
+	 */
+	struct Statistics {
+		int32_t commands = 0;
+		int32_t batches = 0;
+		int32_t shaderChanges = 0;
+		int32_t stateChanges = 0;
+	};
+
+   private:
+	std::vector<Command> commands;
+	Statistics statistics;
+
+	[[nodiscard]] static uint64_t makeKey(const State& state, uint32_t order) {
+		return static_cast<uint64_t>(state.pass) << 48 | static_cast<uint64_t>(state.shader) << 40 |
+			   static_cast<uint64_t>(state.bits) << 32 | order;
+	}
+
+   public:
+	void clear() { commands.clear(); }
+
+	/**
+	 * @brief Records count vertices from first, drawn at origin with a state
+	 *
+	 * @details A range that directly follows the previous command, with the same state and
+	 *          origin, extends it instead.
+	 */
+	void record(const State& state, const glm::ivec2& origin, int32_t first, int32_t count);
+
+	/**
+	 * @brief Sorts the commands by key, execute does it before drawing
+	 */
+	void sort();
+
+	/**
+	 * @brief Sorts the commands and hands them to the backend, one batch per state
+	 */
+	void execute(Backend& backend);
+
+	[[nodiscard]] std::span<const Command> getCommands() const { return commands; }
+	[[nodiscard]] const Statistics& getStatistics() const { return statistics; }
+};
@@ -56,7 +56,9 @@ ShaderProgram::ShaderProgram(const Ref<const Shader>& vertexShader,
 		glGetProgramInfoLog(id, sizeof(infoLog) / sizeof(infoLog[0]), nullptr, infoLog);
 		std::cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
 		id = 0;
+		return;
 	}
+	cacheUniformLocations();
 }
 
 ShaderProgram::ShaderProgram(const std::string& name, Assets& assets) {
@@ -84,6 +86,32 @@ ShaderProgram::ShaderProgram(const std::string& name, Assets& assets) {
 		glGetProgramInfoLog(id, sizeof(infoLog) / sizeof(infoLog[0]), nullptr, infoLog);
 		std::cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
 		id = 0;
+		return;
+	}
+	cacheUniformLocations();
+}
+
+void ShaderProgram::cacheUniformLocations() {
+	int32_t uniformCount = 0;
+	glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &uniformCount);
+	char name[256];
+	for (int32_t i = 0; i < uniformCount; i++) {
+		int32_t length = 0;
+		int32_t arraySize = 0;
+		uint32_t type = 0;
+		glGetActiveUniform(id, i, sizeof(name), &length, &arraySize, &type, name);
+
+		// Members of uniform blocks have no location, they are set through their buffer
+		const int32_t location = glGetUniformLocation(id, name);
+		if (location < 0) {
+			continue;
+		}
+		std::string uniformName(name, length);
+		uniformLocations[uniformName] = location;
+		// Arrays are reported as "name[0]", they can be set by their plain name as well
+		if (uniformName.ends_with("[0]")) {
+			uniformLocations[uniformName.substr(0, uniformName.size() - 3)] = location;
+		}
 	}
 }
 
@@ -98,48 +126,85 @@ void ShaderProgram::bind() const {
 	glUseProgram(id);
 }
 
+int32_t ShaderProgram::getUniformLocation(const std::string& name) const {
+	const auto location = uniformLocations.find(name);
+	return location != uniformLocations.end() ? location->second : -1;
+}
+
 // Uniform setters
+void ShaderProgram::set(Uniform<float> uniform, float value) const {
+	glUniform1f(uniform.location, value);
+}
+
+void ShaderProgram::set(Uniform<int32_t> uniform, int32_t value) const {
+	glUniform1i(uniform.location, value);
+}
+
+void ShaderProgram::set(Uniform<uint32_t> uniform, uint32_t value) const {
+	glUniform1ui(uniform.location, value);
+}
+
+void ShaderProgram::set(Uniform<glm::vec2> uniform, const glm::vec2& value) const {
+	glUniform2fv(uniform.location, 1, &value[0]);
+}
+
+void ShaderProgram::set(Uniform<glm::vec3> uniform, const glm::vec3& value) const {
+	glUniform3fv(uniform.location, 1, &value[0]);
+}
+
+void ShaderProgram::set(Uniform<glm::vec4> uniform, const glm::vec4& value) const {
+	glUniform4fv(uniform.location, 1, &value[0]);
+}
+
+void ShaderProgram::set(Uniform<glm::mat4> uniform, const glm::mat4& value) const {
+	glUniformMatrix4fv(uniform.location, 1, GL_FALSE, &value[0][0]);
+}
+
+void ShaderProgram::setTexture(Uniform<Texture> uniform, const Ref<const Texture>& texture, int32_t slot) const {
+	glUniform1i(uniform.location, slot);
+	texture->bindToSlot(slot);
+}
+
 void ShaderProgram::setFloat(const std::string& name, float value) const {
 	TRACE_FUNCTION();
-	glUniform1f(glGetUniformLocation(id, name.c_str()), value);
+	set(getUniform<float>(name), value);
 }
 
 void ShaderProgram::setInt(const std::string& name, int value) const {
 	TRACE_FUNCTION();
-	glUniform1i(glGetUniformLocation(id, name.c_str()), value);
+	set(getUniform<int32_t>(name), value);
 }
 
 void ShaderProgram::setUInt(const std::string& name, uint32_t value) const {
 	TRACE_FUNCTION();
-	glUniform1ui(glGetUniformLocation(id, name.c_str()), value);
+	set(getUniform<uint32_t>(name), value);
 }
 
 void ShaderProgram::setVec2(const std::string& name, const glm::vec2& value) const {
 	TRACE_FUNCTION();
-	glUniform2fv(glGetUniformLocation(id, name.c_str()), 1, &value[0]);
+	set(getUniform<glm::vec2>(name), value);
 }
 
 void ShaderProgram::setVec3(const std::string& name, const glm::vec3& value) const {
 	TRACE_FUNCTION();
-	glUniform3fv(glGetUniformLocation(id, name.c_str()), 1, &value[0]);
+	set(getUniform<glm::vec3>(name), value);
 }
 
 void ShaderProgram::setVec4(const std::string& name, const glm::vec4& value) const {
 	TRACE_FUNCTION();
-	glUniform4fv(glGetUniformLocation(id, name.c_str()), 1, &value[0]);
+	set(getUniform<glm::vec4>(name), value);
 }
 
 void ShaderProgram::setMat4(const std::string& name, const glm::mat4& mat) const {
 	TRACE_FUNCTION();
-	glUniformMatrix4fv(glGetUniformLocation(id, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+	set(getUniform<glm::mat4>(name), mat);
 }
 
 void ShaderProgram::setTexture(const std::string& name,
 							   const Ref<const Texture>& texture,
 							   int32_t slot) const {
 	TRACE_FUNCTION();
-	setInt(name, slot);
-	texture->bindToSlot(slot);
+	setTexture(getUniform<Texture>(name), texture, slot);
 }
 
 // ProceduralShader implementation
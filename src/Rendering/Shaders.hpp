@@ -4,6 +4,7 @@
 
 // Forward declaration
 class Assets;
+class Texture;
 
 // Shader unique
 class Shader {
@@ -28,14 +29,49 @@ class Shader {
 class ShaderProgram {
 	uint32_t id = 0;
 
+	// Locations of the active uniforms, queried once after linking
+	std::unordered_map<std::string, int32_t> uniformLocations;
+
+	void cacheUniformLocations();
+
    public:
+	/**
+	 * @brief Location of a uniform of type T, resolved once with getUniform and passed to set
+	 *        instead of the uniform name
+	 *
+	 * @details Uniforms missing from the program (or optimized out) get location -1, which GL
+	 *          ignores, as with the name based setters.
+	 */
+	template <typename T>
+	struct Uniform {
+		int32_t location = -1;
+
+		[[nodiscard]] bool isValid() const { return location >= 0; }
+	};
+
 	ShaderProgram(const Ref<const Shader>& vertexShader, const Ref<const Shader>& fragmentShader);
 	ShaderProgram(const std::string& name, Assets& assets);
 	~ShaderProgram();
 
 	void bind() const;
 
-	// Uniform setters
+	[[nodiscard]] int32_t getUniformLocation(const std::string& name) const;
+	template <typename T>
+	[[nodiscard]] Uniform<T> getUniform(const std::string& name) const {
+		return {getUniformLocation(name)};
+	}
+
+	// Uniform setters, on the bound program
+	void set(Uniform<float> uniform, float value) const;
+	void set(Uniform<int32_t> uniform, int32_t value) const;
+	void set(Uniform<uint32_t> uniform, uint32_t value) const;
+	void set(Uniform<glm::vec2> uniform, const glm::vec2& value) const;
+	void set(Uniform<glm::vec3> uniform, const glm::vec3& value) const;
+	void set(Uniform<glm::vec4> uniform, const glm::vec4& value) const;
+	void set(Uniform<glm::mat4> uniform, const glm::mat4& value) const;
+	void setTexture(Uniform<Texture> uniform, const Ref<const Texture>& texture, int32_t slot) const;
+
+	// Uniform setters by name, the location is looked up in the cache
 	void setFloat(const std::string& name, float value) const;
 	void setInt(const std::string& name, int value) const;
 	void setUInt(const std::string& name, uint32_t value) const;
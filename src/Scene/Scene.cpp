@@ -23,6 +23,8 @@ Scene::Skybox::Skybox(Assets& assets) {
 								 "assets/textures/skybox/empty.png;"
 								 "assets/textures/skybox/empty.png");
 	shader = assets.loadShaderProgram("assets/shaders/skybox");
+	cubeMapUniform = shader->getUniform<Texture>("cubeMap");
+	transformUniform = shader->getUniform<glm::mat4>("transform");
 }
 
 void Scene::Skybox::update(const glm::mat4& projection,
@@ -37,8 +39,8 @@ void Scene::Skybox::render() {
 	glDisable(GL_CULL_FACE);
 
 	shader->bind();
-	shader->setTexture("cubeMap", cubeMap, 1);
-	shader->setMat4("transform", transform * glm::rotate(rotation, glm::vec3(1, 0, 0)));
+	shader->setTexture(cubeMapUniform, cubeMap, 1);
+	shader->set(transformUniform, transform * glm::rotate(rotation, glm::vec3(1, 0, 0)));
 	vertexArray.renderIndexed();
 
 	glDepthFunc(GL_LESS);
@@ -48,11 +50,12 @@ void Scene::Skybox::render() {
 // Implémentation de BlockOutline
 Scene::BlockOutline::BlockOutline(Ref<const CubeMesh> blockMesh, Assets& assets)
 	: outlinedBlockShader(assets.loadShaderProgram("assets/shaders/outline")),
+	  mvpUniform(outlinedBlockShader->getUniform<glm::mat4>("MVP")),
 	  blockMesh(std::move(blockMesh)) {}
 
 void Scene::BlockOutline::render(const glm::mat4& transform) const {
 	outlinedBlockShader->bind();
-	outlinedBlockShader->setMat4("MVP", transform);
+	outlinedBlockShader->set(mvpUniform, transform);
 	blockMesh->render();
 }
 
@@ -127,13 +130,14 @@ void Scene::render() {
 		framebuffer = std::make_shared<Framebuffer>(width, height, true, 1);
 	}
 
+	world->updateFrameUniforms(mvp, zNear, zFar);
 	window.getFramebufferStack()->push(framebuffer);
 	glClearColor(0, 0, 0, 0);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 	world->renderOpaque(mvp, player.getPosition(), frustum);
 	auto opaqueRender = window.getFramebufferStack()->pop();
 
-	world->renderTransparent(mvp, player.getPosition(), frustum, zNear, zFar, opaqueRender);
+	world->renderTransparent(player.getPosition(), frustum, opaqueRender);
 
 	if (WorldRayCast ray{player.getPosition(), player.getLookDirection(), *world, Player::Reach}) {
 		outline.render(mvp * glm::translate(ray.getHitTarget().position));
@@ -203,6 +207,21 @@ void Scene::renderMenu() {
 			world->setUseAmbientOcclusion(useOcclusion == 1);
 		}
 
+		bool useGreedyMeshing = world->getUseGreedyMeshing();
+		if (ImGui::Checkbox("Greedy meshing", &useGreedyMeshing)) {
+			world->setUseGreedyMeshing(useGreedyMeshing);
+		}
+
+		bool useCaveCulling = world->getUseCaveCulling();
+		if (ImGui::Checkbox("Cave culling", &useCaveCulling)) {
+			world->setUseCaveCulling(useCaveCulling);
+		}
+
+		bool useFaceRecords = world->getMeshFormat() == ChunkMeshFormat::faceRecords;
+		if (ImGui::Checkbox("Face records (vertex pulling)", &useFaceRecords)) {
+			world->setMeshFormat(useFaceRecords ? ChunkMeshFormat::faceRecords : ChunkMeshFormat::vertices);
+		}
+
 		ImGui::Spacing();
 
 		int32_t distance = world->getViewDistance();
@@ -210,6 +229,16 @@ void Scene::renderMenu() {
 			world->setViewDistance(distance);
 		}
 
+		float coldChunkIdleTime = world->getColdChunkIdleTime();
+		if (ImGui::SliderFloat("Cold chunk delay (s)", &coldChunkIdleTime, 1, 600)) {
+			world->setColdChunkIdleTime(coldChunkIdleTime);
+		}
+
+		int32_t coldChunkBudget = world->getColdChunkCompressionBudget();
+		if (ImGui::SliderInt("Cold chunks compressed per frame", &coldChunkBudget, 0, 16)) {
+			world->setColdChunkCompressionBudget(coldChunkBudget);
+		}
+
 		ImGui::Spacing();
 
 		float speed = skybox.getRotationSpeed();
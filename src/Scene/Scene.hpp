@@ -43,6 +43,8 @@ class Scene {
 		};
 		Ref<const Texture> cubeMap;
 		Ref<const ShaderProgram> shader;
+		ShaderProgram::Uniform<Texture> cubeMapUniform;
+		ShaderProgram::Uniform<glm::mat4> transformUniform;
 		float rotation = 0;
 		float rotationSpeed = 0.01;
 
@@ -63,6 +65,7 @@ class Scene {
 	// BlockOutline intégré
 	struct BlockOutline {
 		Ref<const ShaderProgram> outlinedBlockShader;
+		ShaderProgram::Uniform<glm::mat4> mvpUniform;
 		Ref<const CubeMesh> blockMesh;
 
 		BlockOutline(Ref<const CubeMesh> blockMesh, Assets& assets);
@@ -0,0 +1,107 @@
+#include "BlockRegistry.hpp"
+
+namespace {
+	struct BlockDefaults {
+		const char* name;
+		glm::vec4 color;
+		uint8_t lightEmission;
+	};
+
+	/**
+	 * @brief Compiled-in properties, in BlockType order
+	 */
+	const std::array<BlockDefaults, BlockRegistry::BlockCount> Defaults = {{
+		{"bedrock", {0.341, 0.341, 0.341, 1}, 0},
+		{"planks", {0.706, 0.565, 0.353, 1}, 0},
+		{"grass", {0.376, 0.627, 0.212, 1}, 0},
+		{"dirt", {0.588, 0.424, 0.29, 1}, 0},
+		{"sand", {0.82, 0.792, 0.576, 1}, 0},
+		{"stone", {0.498, 0.498, 0.498, 1}, 0},
+		{"cobblestone", {0.427, 0.427, 0.427, 1}, 0},
+		{"glass", {0.996, 0.996, 0.996, 1}, 0},
+		{"oak_wood", {0.416, 0.333, 0.204, 1}, 0},
+		{"oak_leaves", {0.114, 0.506, 0.114, 1}, 0},
+		{"water", {0.216, 0.325, 0.655, 1}, 0},
+		{"lava", {0.988, 0.631, 0., 1}, 15},
+		{"iron", {0.914, 0.914, 0.914, 1}, 0},
+		{"diamond", {0.412, 0.875, 0.855, 1}, 0},
+		{"gold", {0.996, 0.984, 0.365, 1}, 0},
+		{"obsidian", {0.035, 0.035, 0.055, 1}, 0},
+		{"sponge", {0.898, 0.898, 0.306, 1}, 0},
+		{"air", {1, 1, 1, 1}, 0},
+	}};
+
+	constexpr uint8_t defaultOpacity(BlockData::BlockClass blockClass) {
+		switch (blockClass) {
+			case BlockData::BlockClass::solid:
+				return BlockRegistry::MaxOpacity;
+			case BlockData::BlockClass::semiTransparent:
+				return 2;
+			case BlockData::BlockClass::transparent:
+				return 1;
+			default:
+				return 0;
+		}
+	}
+}
+
+BlockRegistry::BlockRegistry() {
+	for (size_t id = 0; id < BlockCount; ++id) {
+		const BlockDefaults& defaults = Defaults[id];
+		names[id] = defaults.name;
+		classes[id] = BlockData::DefaultClasses[id];
+		opacities[id] = defaultOpacity(classes[id]);
+		colors[id] = defaults.color;
+		animated[id] = 0;
+		frameCounts[id] = 1;
+		frameDurations[id] = 0.0f;
+		lightEmissions[id] = defaults.lightEmission;
+	}
+
+	for (Table<uint8_t>& layers : faceLayers) {
+		layers.fill(0);
+	}
+}
+
+bool BlockRegistry::findByName(std::string_view name, BlockType& outType) const {
+	for (size_t id = 0; id < BlockCount; ++id) {
+		if (name == names[id]) {
+			outType = static_cast<BlockType>(id);
+			return true;
+		}
+	}
+	return false;
+}
+
+void BlockRegistry::setClass(BlockType type, BlockClass blockClass) {
+	classes[toId(type)] = blockClass;
+	// Keep the canonical BlockData handed out by chunks in sync
+	BlockTable::Entries[toId(type)].blockClass = blockClass;
+}
+
+void BlockRegistry::setOpacity(BlockType type, uint8_t opacity) {
+	opacities[toId(type)] = std::min(opacity, MaxOpacity);
+}
+
+void BlockRegistry::setColor(BlockType type, const glm::vec4& color) {
+	colors[toId(type)] = color;
+}
+
+void BlockRegistry::setFaceLayer(BlockType type, int32_t face, uint8_t layer) {
+	assert(face >= 0 && face < FaceCount);
+	faceLayers[face][toId(type)] = layer;
+}
+
+void BlockRegistry::setAnimation(BlockType type, uint8_t frameCount, float frameDuration) {
+	animated[toId(type)] = frameCount > 1 ? 1 : 0;
+	frameCounts[toId(type)] = std::max<uint8_t>(frameCount, 1);
+	frameDurations[toId(type)] = frameDuration;
+}
+
+void BlockRegistry::setLightEmission(BlockType type, uint8_t lightEmission) {
+	lightEmissions[toId(type)] = std::min(lightEmission, MaxLightLevel);
+}
+
+glm::vec4 BlockData::getColor() const {
+	return BlockRegistry::getInstance().getColor(type);
+}
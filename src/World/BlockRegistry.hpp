@@ -0,0 +1,123 @@
+/**
+ * @file BlockRegistry.hpp
+ * @brief Flat property tables for every block type
+ *
+ * @details Block types are dense 8-bit IDs (the underlying value of BlockData::BlockType), so
+ *          each property is stored in its own array indexed by that ID. The tables start from
+ *          compiled-in defaults and are completed by Assets while loading textures.json; after
+ *          that they are only read, which makes them safe to use from the meshing threads.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+#include "BlockTypes.hpp"
+
+#include <string_view>
+
+/**
+ * @class BlockRegistry
+ * @brief Singleton holding the per-block property tables (structure of arrays)
+ */
+class BlockRegistry {
+   public:
+	using BlockId = uint8_t;
+	using BlockType = BlockData::BlockType;
+	using BlockClass = BlockData::BlockClass;
+
+	static constexpr size_t BlockCount = BlockData::TypeCount;
+	static_assert(BlockCount <= 256, "Block IDs must fit in 8 bits");
+
+	/**
+	 * @brief Number of faces of a block, in BlockMesh order: top, east, west, north, south, bottom
+	 */
+	static constexpr int32_t FaceCount = 6;
+
+	/**
+	 * @brief Opacity of a block that fully blocks light
+	 */
+	static constexpr uint8_t MaxOpacity = 15;
+
+	static constexpr uint8_t MaxLightLevel = 15;
+
+	template <typename T>
+	using Table = std::array<T, BlockCount>;
+
+   private:
+	Table<const char*> names;
+	Table<BlockClass> classes;
+	Table<uint8_t> opacities;
+	Table<glm::vec4> colors;
+	std::array<Table<uint8_t>, FaceCount> faceLayers;
+	Table<uint8_t> animated;
+	Table<uint8_t> frameCounts;
+	Table<float> frameDurations;
+	Table<uint8_t> lightEmissions;
+
+	BlockRegistry();
+
+	[[nodiscard]] static constexpr BlockId toId(BlockType type) { return static_cast<BlockId>(type); }
+
+   public:
+	BlockRegistry(const BlockRegistry&) = delete;
+	BlockRegistry& operator=(const BlockRegistry&) = delete;
+
+	static BlockRegistry& getInstance() {
+		static BlockRegistry instance;
+		return instance;
+	}
+
+	/**
+	 * @brief Face index (BlockMesh order) of the face pointing towards a unit direction
+	 */
+	[[nodiscard]] static constexpr int32_t getFaceIndex(const glm::ivec3& direction) {
+		if (direction.y != 0) {
+			return direction.y > 0 ? 0 : 5;
+		} else if (direction.x != 0) {
+			return direction.x > 0 ? 1 : 2;
+		}
+		return direction.z > 0 ? 4 : 3;
+	}
+
+	/**
+	 * @brief Looks up a block type by its textures.json name
+	 * @return false if the name is unknown
+	 */
+	bool findByName(std::string_view name, BlockType& outType) const;
+
+	[[nodiscard]] const char* getName(BlockType type) const { return names[toId(type)]; }
+	[[nodiscard]] BlockClass getClass(BlockType type) const { return classes[toId(type)]; }
+	[[nodiscard]] uint8_t getOpacity(BlockType type) const { return opacities[toId(type)]; }
+	[[nodiscard]] bool isOpaque(BlockType type) const { return opacities[toId(type)] == MaxOpacity; }
+	[[nodiscard]] const glm::vec4& getColor(BlockType type) const { return colors[toId(type)]; }
+	[[nodiscard]] bool isAnimated(BlockType type) const { return animated[toId(type)] != 0; }
+	[[nodiscard]] uint8_t getFrameCount(BlockType type) const { return frameCounts[toId(type)]; }
+	[[nodiscard]] float getFrameDuration(BlockType type) const { return frameDurations[toId(type)]; }
+	[[nodiscard]] uint8_t getLightEmission(BlockType type) const { return lightEmissions[toId(type)]; }
+
+	[[nodiscard]] uint8_t getFaceLayer(BlockType type, int32_t face) const {
+		assert(face >= 0 && face < FaceCount);
+		return faceLayers[face][toId(type)];
+	}
+
+	/**
+	 * @brief Texture layer of one face for every block ID, for loops that keep the face fixed
+	 */
+	[[nodiscard]] const Table<uint8_t>& getFaceLayers(int32_t face) const {
+		assert(face >= 0 && face < FaceCount);
+		return faceLayers[face];
+	}
+
+	/**
+	 * @name Registration
+	 * @brief Only called while loading textures.json, before any chunk is meshed
+	 * @{
+	 */
+	void setClass(BlockType type, BlockClass blockClass);
+	void setOpacity(BlockType type, uint8_t opacity);
+	void setColor(BlockType type, const glm::vec4& color);
+	void setFaceLayer(BlockType type, int32_t face, uint8_t layer);
+	void setAnimation(BlockType type, uint8_t frameCount, float frameDuration);
+	void setLightEmission(BlockType type, uint8_t lightEmission);
+	/** @} */
+};
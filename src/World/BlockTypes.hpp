@@ -4,9 +4,9 @@
 
 // Block data structure
 struct BlockData {
-	enum class BlockClass { air, solid, semiTransparent, transparent };
+	enum class BlockClass : uint8_t { air, solid, semiTransparent, transparent };
 
-	enum class BlockType {
+	enum class BlockType : uint8_t {
 		bedrock,
 		planks,
 		grass,
@@ -27,66 +27,90 @@ struct BlockData {
 		air
 	};
 
-	glm::vec4 getColor() const {
-		switch (type) {
-			case BlockType::bedrock:
-				return glm::vec4(0.341, 0.341, 0.341, 1);
-			case BlockType::planks:
-				return glm::vec4(0.706, 0.565, 0.353, 1);
-			case BlockType::grass:
-				return glm::vec4(0.376, 0.627, 0.212, 1);
-			case BlockType::dirt:
-				return glm::vec4(0.588, 0.424, 0.29, 1);
-			case BlockType::sand:
-				return glm::vec4(0.82, 0.792, 0.576, 1);
-			case BlockType::stone:
-				return glm::vec4(0.498, 0.498, 0.498, 1);
-			case BlockType::cobblestone:
-				return glm::vec4(0.427, 0.427, 0.427, 1);
-			case BlockType::glass:
-				return glm::vec4(0.996, 0.996, 0.996, 1);
-			case BlockType::oak_wood:
-				return glm::vec4(0.416, 0.333, 0.204, 1);
-			case BlockType::oak_leaves:
-				return glm::vec4(0.114, 0.506, 0.114, 1);
-			case BlockType::water:
-				return glm::vec4(0.216, 0.325, 0.655, 1);
-			case BlockType::lava:
-				return glm::vec4(0.988, 0.631, 0., 1);
-			case BlockType::iron:
-				return glm::vec4(0.914, 0.914, 0.914, 1);
-			case BlockType::diamond:
-				return glm::vec4(0.412, 0.875, 0.855, 1);
-			case BlockType::gold:
-				return glm::vec4(0.996, 0.984, 0.365, 1);
-			case BlockType::obsidian:
-				return glm::vec4(0.035, 0.035, 0.055, 1);
-			case BlockType::sponge:
-				return glm::vec4(0.898, 0.898, 0.306, 1);
-			default:
-				return glm::vec4(1, 1, 1, 1);
-		}
-	}
+	/**
+	 * @brief Number of distinct block types (air included)
+	 */
+	static constexpr size_t TypeCount = static_cast<size_t>(BlockType::air) + 1;
+
+	/**
+	 * @brief Display color of the block (particles, minimap), read from the BlockRegistry
+	 */
+	[[nodiscard]] glm::vec4 getColor() const;
 
 	BlockType type;
 	BlockClass blockClass;
 
-	static BlockClass typeToClass(BlockType type) {
-		if (type == BlockType::air) {
-			return BlockClass::air;
-		} else if (type == BlockType::water) {
-			return BlockClass::semiTransparent;
-		} else if (type == BlockType::oak_leaves || type == BlockType::glass) {
-			return BlockClass::transparent;
-		}
+	/**
+	 * @brief Compiled-in block class of each type, used until textures.json overrides it
+	 */
+	static constexpr std::array<BlockClass, TypeCount> DefaultClasses = {{
+		BlockClass::solid,			  // bedrock
+		BlockClass::solid,			  // planks
+		BlockClass::solid,			  // grass
+		BlockClass::solid,			  // dirt
+		BlockClass::solid,			  // sand
+		BlockClass::solid,			  // stone
+		BlockClass::solid,			  // cobblestone
+		BlockClass::transparent,	  // glass
+		BlockClass::solid,			  // oak_wood
+		BlockClass::transparent,	  // oak_leaves
+		BlockClass::semiTransparent,  // water
+		BlockClass::solid,			  // lava
+		BlockClass::solid,			  // iron
+		BlockClass::solid,			  // diamond
+		BlockClass::solid,			  // gold
+		BlockClass::solid,			  // obsidian
+		BlockClass::solid,			  // sponge
+		BlockClass::air,			  // air
+	}};
 
-		return BlockClass::solid;
+	static constexpr BlockClass typeToClass(BlockType type) {
+		return DefaultClasses[static_cast<size_t>(type)];
 	}
 
-	BlockData(BlockData::BlockType type = BlockType::air)
-		: type(type), blockClass(typeToClass(type)) {}
+	constexpr BlockData() : type(BlockType::air), blockClass(BlockClass::air) {}
+
+	constexpr BlockData(BlockType type, BlockClass blockClass)
+		: type(type), blockClass(blockClass) {}
+
+	/**
+	 * @brief Builds the BlockData of a type, with the class currently registered for it
+	 */
+	BlockData(BlockType type);
+
+	/**
+	 * @brief Returns the shared BlockData instance for a block type
+	 *
+	 * @details BlockData is fully determined by its type, so chunks only store the type and hand
+	 *          out pointers into this table. The returned reference stays valid for the lifetime
+	 *          of the program; only the BlockRegistry updates the entries, while loading
+	 *          textures.json.
+	 */
+	static const BlockData& get(BlockType type);
 };
 
+namespace BlockTable {
+	constexpr std::array<BlockData, BlockData::TypeCount> makeTable() {
+		std::array<BlockData, BlockData::TypeCount> table{};
+		for (size_t i = 0; i < table.size(); ++i) {
+			const auto type = static_cast<BlockData::BlockType>(i);
+			table[i] = BlockData(type, BlockData::typeToClass(type));
+		}
+		return table;
+	}
+
+	/**
+	 * @brief Canonical BlockData instances, constant-initialized from the compiled-in classes
+	 */
+	inline std::array<BlockData, BlockData::TypeCount> Entries = makeTable();
+}
+
+inline const BlockData& BlockData::get(BlockType type) {
+	return BlockTable::Entries[static_cast<size_t>(type)];
+}
+
+inline BlockData::BlockData(BlockType type) : BlockData(get(type)) {}
+
 // Block name utilities
 struct BlockName {
    private:
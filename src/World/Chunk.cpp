@@ -2,15 +2,20 @@
 
 #include "../Core/Assets.hpp"
 #include "../Core/PerformanceMonitor.hpp"
+#include "ChunkSnapshot.hpp"
 #include "World.hpp"
 
+namespace {
+	bool countsForHeightmap(BlockData::BlockClass blockClass, Heightmap::Type type) {
+		if (type == Heightmap::Type::solid) {
+			return blockClass == BlockData::BlockClass::solid;
+		}
+		return blockClass != BlockData::BlockClass::air;
+	}
+}
+
 Chunk::Chunk(const glm::ivec2& worldPosition)
-	: worldPosition(worldPosition), aabb(glm::vec3(0), glm::vec3(0)),
-	  solidVertices(std::make_shared<std::vector<BlockVertex>>()),
-	  semiTransparentVertices(std::make_shared<std::vector<BlockVertex>>()) {
-	// Start with initial capacity instead of max capacity
-	solidVertices->reserve(InitialVertexCapacity);
-	semiTransparentVertices->reserve(InitialVertexCapacity);
+	: worldPosition(worldPosition), aabb(glm::vec3(0), glm::vec3(0)) {
 	init();
 }
 
@@ -19,60 +24,71 @@ void Chunk::init() {
 	for (auto& lod : lodData) {
 		lod.solidVertexCount = 0;
 		lod.semiTransparentVertexCount = 0;
-		lod.mesh = nullptr;
+		lod.mesh.reset();
 		lod.isGenerated = false;
 	}
 	
 	currentLOD = LODLevel::Full;
 	renderState = RenderState::initial;
+	dirtySections = ChunkMeshData::AllSections;
+	sectionConnectivity.fill({});
+	visibleSections = ChunkMeshData::AllSections;
 
 	glm::vec3 position = glm::vec3(worldPosition.x, 0, worldPosition.y);
 	glm::vec3 maxOffset = glm::vec3(HorizontalSize, VerticalSize, HorizontalSize);
 	aabb = AABB{position, position + maxOffset};
 }
 
-void Chunk::renderOpaque(const glm::mat4& transform, const Frustum& frustum) {
-	TRACE_FUNCTION();
-	
-	const auto& lod = lodData[static_cast<size_t>(currentLOD)];
-	if (!lod.mesh || !isVisible(frustum)) {
-		return;
+int32_t Chunk::recordSolidDraws(const glm::vec3& cameraPosition,
+								RenderQueue& queue,
+								const RenderQueue::State& state) const {
+	const auto& lod = lodData[static_cast<size_t>(getDrawnLOD())];
+	if (!lod.mesh || lod.solidVertexCount == 0) {
+		return 0;
 	}
 
-	if (!shader)
-		return;
+	const glm::vec3 localCamera = cameraPosition - glm::vec3(worldPosition.x, 0, worldPosition.y);
+	const int32_t elementVertices = lod.mesh.getBuffer()->getElementVertices();
+	const int32_t meshOffset = lod.mesh.getOffset();
+	int32_t vertexCount = 0;
+	for (int32_t section = SectionCount - 1; section >= 0; --section) {
+		const ChunkMeshSlot& slot = lod.solidSlots[section];
+		if (slot.size == 0 || (visibleSections & (1u << section)) == 0) {
+			continue;
+		}
 
-	// Don't rebind shader - World already bound it
-	// Just set the MVP matrix for this chunk
-	shader->setMat4("MVP",
-					transform * glm::translate(glm::vec3(worldPosition.x, 0, worldPosition.y)));
+		const std::array<bool, 6> frontFacing = getFrontFacingDirections(localCamera, section);
 
-	if (lod.solidVertexCount != 0) {
-		lod.mesh->renderVertexSubStream(lod.solidVertexCount, 0);
+		int32_t first = meshOffset + slot.first;
+		for (size_t face = 0; face < frontFacing.size(); ++face) {
+			const int32_t size = slot.faceSizes[face];
+			if (size != 0 && frontFacing[face]) {
+				// Adjacent directions are merged into one command by the queue
+				queue.record(state, worldPosition, first * elementVertices, size * elementVertices);
+				vertexCount += size * elementVertices;
+			}
+			first += size;
+		}
 	}
+	return vertexCount;
 }
 
-void Chunk::renderSemiTransparent(const glm::mat4& transform, const Frustum& frustum) {
-	TRACE_FUNCTION();
-	
-	const auto& lod = lodData[static_cast<size_t>(currentLOD)];
-	if (!lod.mesh || !isVisible(frustum)) {
+void Chunk::recordSemiTransparentDraws(RenderQueue& queue, const RenderQueue::State& state) const {
+	const auto& lod = lodData[static_cast<size_t>(getDrawnLOD())];
+	if (!lod.mesh || lod.semiTransparentVertexCount == 0) {
 		return;
 	}
 
-	if (!shader)
-		return;
-
-	// Don't rebind shader - World already bound it
-	// Just set the MVP matrix for this chunk
-	shader->setMat4("MVP",
-					transform * glm::translate(glm::vec3(worldPosition.x, 0, worldPosition.y)));
-
-	glDisable(GL_CULL_FACE);
-	if (lod.semiTransparentVertexCount != 0) {
-		lod.mesh->renderVertexSubStream(lod.semiTransparentVertexCount, lod.solidVertexCount);
+	// Semi-transparent faces are drawn from both sides, whole sections are recorded
+	const int32_t elementVertices = lod.mesh.getBuffer()->getElementVertices();
+	const int32_t meshOffset = lod.mesh.getOffset();
+	for (int32_t section = SectionCount - 1; section >= 0; --section) {
+		const ChunkMeshSlot& slot = lod.semiTransparentSlots[section];
+		if (slot.size != 0 && (visibleSections & (1u << section)) != 0) {
+			queue.record(state, worldPosition, (meshOffset + slot.first) * elementVertices,
+						 slot.size * elementVertices);
+		}
 	}
-	glEnable(GL_CULL_FACE);
 }
 
 const BlockData* Chunk::getBlockAtOptimized(const glm::ivec3& pos, const World& world) const {
@@ -90,56 +106,93 @@ const BlockData* Chunk::getBlockAtOptimized(const glm::ivec3& pos, const World&
 	return nullptr;
 }
 
-/**
- * @brief Updates peak vertex usage statistics
- * 
- * @details Called after mesh rebuild to track maximum vertex usage.
- *          This information is used to optimize future allocations.
- */
-void Chunk::updatePeakUsage() {
-	// Update peak usage based on full LOD
-	const auto& fullLod = lodData[static_cast<size_t>(LODLevel::Full)];
-	peakSolidVertexCount = std::max(peakSolidVertexCount, fullLod.solidVertexCount);
-	peakSemiTransparentVertexCount = std::max(peakSemiTransparentVertexCount, fullLod.semiTransparentVertexCount);
-	rebuildCount++;
+void Chunk::updateHeightmaps(int32_t x,
+							 int32_t z,
+							 int32_t bottomY,
+							 int32_t topY,
+							 BlockData::BlockClass blockClass) {
+	for (Heightmap::Type type : {Heightmap::Type::solid, Heightmap::Type::nonAir}) {
+		Heightmap& heightmap = type == Heightmap::Type::solid ? solidHeightmap : nonAirHeightmap;
+		const int32_t height = heightmap.get(x, z);
+		if (countsForHeightmap(blockClass, type)) {
+			if (topY > height) {
+				heightmap.set(x, z, topY);
+			}
+		} else if (height >= bottomY && height <= topY) {
+			heightmap.set(x, z, findHighestBlock(x, bottomY - 1, z, type));
+		}
+	}
 }
 
-/**
- * @brief Ensures vertex vectors have sufficient capacity
- * 
- * @details Implements progressive reallocation strategy to minimize memory usage
- *          while avoiding frequent reallocations. Uses growth factor and peak usage
- *          statistics to determine optimal capacity.
- * 
- * @param requiredSolidCapacity Minimum capacity needed for solid vertices
- * @param requiredTransparentCapacity Minimum capacity needed for transparent vertices
- */
-void Chunk::ensureVertexCapacity(int32_t requiredSolidCapacity, int32_t requiredTransparentCapacity) {
-	// For solid vertices
-	if (solidVertices->capacity() < requiredSolidCapacity) {
-		// Use peak usage as a guide for allocation
-		int32_t targetCapacity = requiredSolidCapacity;
-		if (rebuildCount > 5 && peakSolidVertexCount > 0) {
-			// After several rebuilds, use peak usage plus growth factor
-			targetCapacity = static_cast<int32_t>(peakSolidVertexCount * VertexBufferGrowthFactor);
+int32_t Chunk::findHighestBlock(int32_t x, int32_t fromY, int32_t z, Heightmap::Type type) const {
+	int32_t y = fromY;
+	while (y >= 0) {
+		const ChunkSection& section = sections[y / ChunkSection::Size];
+		const int32_t sectionBase = y - y % ChunkSection::Size;
+		if (section.getState() == ChunkSection::State::mixed) {
+			for (; y >= sectionBase; --y) {
+				if (countsForHeightmap(getBlock(x, y, z).blockClass, type)) {
+					return y;
+				}
+			}
+		} else {
+			// Empty and uniform sections match either everywhere or nowhere
+			if (countsForHeightmap(BlockData::get(section.getUniformType()).blockClass, type)) {
+				return y;
+			}
+			y = sectionBase - 1;
 		}
-		targetCapacity = std::max(targetCapacity, requiredSolidCapacity);
-		targetCapacity = std::min(targetCapacity, MaxVertexCount);
-		
-		solidVertices->reserve(targetCapacity);
 	}
-	
-	// For semi-transparent vertices
-	if (semiTransparentVertices->capacity() < requiredTransparentCapacity) {
-		int32_t targetCapacity = requiredTransparentCapacity;
-		if (rebuildCount > 5 && peakSemiTransparentVertexCount > 0) {
-			targetCapacity = static_cast<int32_t>(peakSemiTransparentVertexCount * VertexBufferGrowthFactor);
+	return Heightmap::Empty;
+}
+
+void Chunk::recomputeHeightmaps() {
+	TRACE_FUNCTION();
+	for (int32_t x = 0; x < HorizontalSize; x++) {
+		for (int32_t z = 0; z < HorizontalSize; z++) {
+			solidHeightmap.set(x, z, findHighestBlock(x, VerticalSize - 1, z, Heightmap::Type::solid));
+			nonAirHeightmap.set(x, z, findHighestBlock(x, VerticalSize - 1, z, Heightmap::Type::nonAir));
+		}
+	}
+}
+
+size_t Chunk::compressBlocks() {
+	TRACE_FUNCTION();
+	size_t savedBytes = 0;
+	for (auto& section : sections) {
+		const size_t previousUsage = section.getMemoryUsage();
+		if (section.compress()) {
+			savedBytes += previousUsage - section.getMemoryUsage();
+			compressed = true;
+		}
+	}
+	return savedBytes;
+}
+
+void Chunk::decompressBlocks() const {
+	PERF_TIMER("Chunk::decompressBlocks");
+	for (auto& section : sections) {
+		section.decompress();
+	}
+	compressed = false;
+	idleTime = 0;
+}
+
+void Chunk::fillSection(int32_t index, BlockData::BlockType type) {
+	assert(index >= 0 && index < SectionCount);
+	ensureResident();
+	idleTime = 0;
+	sections[index].fill(type);
+
+	const int32_t bottomY = index * ChunkSection::Size;
+	const int32_t topY = bottomY + ChunkSection::Size - 1;
+	const BlockData::BlockClass blockClass = BlockData::get(type).blockClass;
+	for (int32_t x = 0; x < HorizontalSize; x++) {
+		for (int32_t z = 0; z < HorizontalSize; z++) {
+			updateHeightmaps(x, z, bottomY, topY, blockClass);
 		}
-		targetCapacity = std::max(targetCapacity, requiredTransparentCapacity);
-		targetCapacity = std::min(targetCapacity, MaxVertexCount);
-		
-		semiTransparentVertices->reserve(targetCapacity);
 	}
+	setDirty();
 }
 
 /**
@@ -199,15 +252,19 @@ void Chunk::rebuildMesh(const World& world) {
 	TRACE_FUNCTION();
 	PERF_TIMER("Chunk::rebuildMesh");
 
-	// Use ChunkMeshBuilder to generate mesh data for full LOD
+	// Use ChunkMeshBuilder to generate mesh data for full LOD, all sections at once
 	ChunkMeshData meshData;
+	dirtySections = 0;
 	{
 		TRACE_SCOPE("Chunk::rebuildMesh::BuildMesh");
-		ChunkMeshBuilder::buildMesh(*this, world, world.getAssets(), useAmbientOcclusion, meshData, LODLevel::Full);
+		ChunkSnapshot snapshot;
+		snapshot.capture(*this, world);
+		ChunkMeshBuilder::buildMesh(snapshot, useAmbientOcclusion, meshData, LODLevel::Full,
+									world.getUseGreedyMeshing(), world.getMeshFormat());
 	}
 	
 	// Apply the mesh data
-	applyMeshData(meshData, LODLevel::Full);
+	applyMeshData(meshData, LODLevel::Full, world.getMeshBuffer(meshData.format));
 }
 
 /**
@@ -215,90 +272,134 @@ void Chunk::rebuildMesh(const World& world) {
  * 
  * @details Copies the mesh data and uploads it to GPU
  */
-void Chunk::applyMeshData(const ChunkMeshData& meshData, LODLevel lod) {
+bool Chunk::applyMeshData(const ChunkMeshData& meshData, LODLevel lod, ChunkMegaBuffer& meshBuffer) {
 	TRACE_FUNCTION();
 	
 	auto& lodData = this->lodData[static_cast<size_t>(lod)];
 	
-	// Update counts for this LOD
-	lodData.solidVertexCount = meshData.solidVertexCount;
-	lodData.semiTransparentVertexCount = meshData.semiTransparentVertexCount;
-	
-	// Copy mesh data to internal buffers
-	{
-		TRACE_SCOPE("Chunk::applyMeshData::CopyData");
-		ensureVertexCapacity(lodData.solidVertexCount, lodData.semiTransparentVertexCount);
-		
-		if (lodData.solidVertexCount > 0) {
-			solidVertices->resize(lodData.solidVertexCount);
-			std::copy(meshData.solidVertices.begin(), 
-			         meshData.solidVertices.begin() + lodData.solidVertexCount,
-			         solidVertices->begin());
-		} else {
-			solidVertices->clear();
+	// Partial meshes only replace some sections of the current allocation
+	if (meshData.sectionMask != ChunkMeshData::AllSections) {
+		TRACE_SCOPE("Chunk::applyMeshData::UpdateSections");
+		if (!lodData.mesh || lodData.format != meshData.format) {
+			return false;
 		}
-		
-		if (lodData.semiTransparentVertexCount > 0) {
-			semiTransparentVertices->resize(lodData.semiTransparentVertexCount);
-			std::copy(meshData.semiTransparentVertices.begin(),
-			         meshData.semiTransparentVertices.begin() + lodData.semiTransparentVertexCount,
-			         semiTransparentVertices->begin());
-		} else {
-			semiTransparentVertices->clear();
+
+		const bool updated = meshData.format == ChunkMeshFormat::faceRecords
+								 ? updateSlots(lodData, meshData, meshData.faces)
+								 : updateSlots(lodData, meshData, meshData.vertices);
+		if (!updated) {
+			return false;
 		}
+
+		applyConnectivity(meshData);
+		lodData.isGenerated = true;
+		renderState = RenderState::ready;
+		return true;
 	}
 	
-	// Update statistics
-	updatePeakUsage();
-	
-	// Upload to GPU
+	PerformanceMonitor::getInstance().recordCount("Mesh Bytes per Chunk",
+												   static_cast<int32_t>(meshData.getByteSize()));
+
+	assert(meshBuffer.getFormat() == meshData.format && "The mesh belongs to the buffer of its format");
+	lodData.format = meshData.format;
+
+	// Upload to GPU, the worker already laid the mesh out in its final form. The previous range
+	// is given back first so that a mesh of the same size can take its place.
 	{
 		TRACE_SCOPE("Chunk::applyMeshData::UploadToGPU");
-		int32_t vertexCount = lodData.solidVertexCount + lodData.semiTransparentVertexCount;
+		lodData.mesh.reset();
+		if (meshData.format == ChunkMeshFormat::faceRecords) {
+			lodData.mesh = ChunkMeshAllocation(meshBuffer, static_cast<int32_t>(meshData.faces.size()));
+			if (!meshData.faces.empty()) {
+				meshBuffer.write(lodData.mesh.getId(), meshData.faces, static_cast<int32_t>(meshData.faces.size()));
+			}
+		} else {
+			lodData.mesh = ChunkMeshAllocation(meshBuffer, static_cast<int32_t>(meshData.vertices.size()));
+			if (!meshData.vertices.empty()) {
+				meshBuffer.write(lodData.mesh.getId(), meshData.vertices,
+								 static_cast<int32_t>(meshData.vertices.size()));
+			}
+		}
+	}
+
+	lodData.solidSlots = meshData.solidSlots;
+	lodData.semiTransparentSlots = meshData.semiTransparentSlots;
+	updateVertexCounts(lodData);
+	applyConnectivity(meshData);
+	lodData.isGenerated = true;
+	renderState = RenderState::ready;
+	return true;
+}
 
-		if (!lodData.mesh) {
-			lodData.mesh = std::make_shared<VertexArray>();
-			lodData.mesh->addVertexAttributes(BlockVertex::vertexAttributes(), sizeof(BlockVertex));
+void Chunk::applyConnectivity(const ChunkMeshData& meshData) {
+	for (int32_t section = 0; section < SectionCount; ++section) {
+		if ((meshData.sectionMask & (1u << section)) != 0 && (dirtySections & (1u << section)) == 0) {
+			sectionConnectivity[section] = meshData.sectionConnectivity[section];
 		}
+	}
+}
 
-		Ref<VertexBuffer> buffer = lodData.mesh->getVertexBuffer();
-		
-		// Always use bufferDynamicData to avoid issues with bufferDynamicSubData
-		int32_t bufferSize = glm::max(vertexCount, glm::min(vertexCount + 1000, MaxVertexCount));
-		
-		// Create combined buffer
-		std::vector<BlockVertex> combinedBuffer;
-		combinedBuffer.reserve(bufferSize);
-		
-		// Add vertices
-		if (lodData.solidVertexCount > 0) {
-			combinedBuffer.insert(combinedBuffer.end(), 
-				solidVertices->begin(), solidVertices->end());
+template <typename T>
+bool Chunk::updateSlots(LODData& lod, const ChunkMeshData& meshData, const std::vector<T>& data) {
+	for (int32_t section = 0; section < SectionCount; ++section) {
+		if ((meshData.sectionMask & (1u << section)) != 0 &&
+			(meshData.solidSlots[section].size > lod.solidSlots[section].capacity ||
+			 meshData.semiTransparentSlots[section].size > lod.semiTransparentSlots[section].capacity)) {
+			return false;
 		}
-		
-		if (lodData.semiTransparentVertexCount > 0) {
-			combinedBuffer.insert(combinedBuffer.end(), 
-				semiTransparentVertices->begin(), semiTransparentVertices->end());
+	}
+
+	// The slots of a partial mesh locate the data of each section in its vectors
+	ChunkMegaBuffer& buffer = *lod.mesh.getBuffer();
+	auto writeSlot = [&](ChunkMeshSlot& slot, const ChunkMeshSlot& source) {
+		if (source.size > 0) {
+			buffer.write(lod.mesh.getId(), data, source.size, source.first, slot.first);
 		}
-		
-		// Pad to buffer size
-		combinedBuffer.resize(bufferSize);
-		
-		// Upload to GPU
-		buffer->bufferDynamicData(combinedBuffer, bufferSize, 0);
-		lodData.isGenerated = true;
-		
-		// Mark as ready if this is the full LOD
-		if (lod == LODLevel::Full) {
-			renderState = RenderState::ready;
+		slot.size = source.size;
+		slot.faceSizes = source.faceSizes;
+	};
+	for (int32_t section = 0; section < SectionCount; ++section) {
+		if ((meshData.sectionMask & (1u << section)) != 0) {
+			writeSlot(lod.solidSlots[section], meshData.solidSlots[section]);
+			writeSlot(lod.semiTransparentSlots[section], meshData.semiTransparentSlots[section]);
 		}
 	}
+
+	updateVertexCounts(lod);
+	return true;
+}
+
+void Chunk::updateVertexCounts(LODData& lod) {
+	// Draw calls count vertices, face records are expanded to 6 vertices each
+	const int32_t elementVertices = lod.format == ChunkMeshFormat::faceRecords ? FaceRecord::VerticesPerFace : 1;
+	lod.solidVertexCount = 0;
+	for (const ChunkMeshSlot& slot : lod.solidSlots) {
+		lod.solidVertexCount += slot.size * elementVertices;
+	}
+
+	lod.semiTransparentVertexCount = 0;
+	for (const ChunkMeshSlot& slot : lod.semiTransparentSlots) {
+		lod.semiTransparentVertexCount += slot.size * elementVertices;
+	}
 }
 
 void Chunk::selectLOD(float distanceInChunks) {
 	currentLOD = LODSelector::selectLOD(distanceInChunks);
 }
 
+LODLevel Chunk::getDrawnLOD() const {
+	const int32_t current = static_cast<int32_t>(currentLOD);
+	constexpr int32_t levelCount = static_cast<int32_t>(LODLevel::Count);
+	for (int32_t distance = 0; distance < levelCount; ++distance) {
+		for (int32_t level : {current - distance, current + distance}) {
+			if (level >= 0 && level < levelCount && lodData[level].mesh) {
+				return static_cast<LODLevel>(level);
+			}
+		}
+	}
+	return currentLOD;
+}
+
 glm::ivec3 Chunk::toChunkCoordinates(const glm::ivec3& globalPosition) {
 	return {Util::positiveMod(globalPosition.x, HorizontalSize),
 			globalPosition.y,
@@ -317,38 +418,16 @@ void Chunk::reset(glm::ivec2 newPosition) {
 	worldPosition = newPosition;
 	init();
 
-	// Clear all blocks to air
-	std::fill(data.begin(), data.end(), BlockData{BlockData::BlockType::air});
-
-	// Ensure vertex vectors are allocated with initial capacity
-	if (!solidVertices) {
-		solidVertices = std::make_shared<std::vector<BlockVertex>>();
-		solidVertices->reserve(InitialVertexCapacity);
-	} else {
-		// Shrink to initial capacity if much larger
-		if (solidVertices->capacity() > InitialVertexCapacity * 4) {
-			solidVertices->clear();
-			solidVertices->shrink_to_fit();
-			solidVertices->reserve(InitialVertexCapacity);
+	// Clear all blocks to air, sections that already are empty have nothing to release
+	for (auto& section : sections) {
+		if (!section.isEmpty()) {
+			section.fill(BlockData::BlockType::air);
 		}
 	}
-	
-	if (!semiTransparentVertices) {
-		semiTransparentVertices = std::make_shared<std::vector<BlockVertex>>();
-		semiTransparentVertices->reserve(InitialVertexCapacity);
-	} else {
-		// Shrink to initial capacity if much larger
-		if (semiTransparentVertices->capacity() > InitialVertexCapacity * 4) {
-			semiTransparentVertices->clear();
-			semiTransparentVertices->shrink_to_fit();
-			semiTransparentVertices->reserve(InitialVertexCapacity);
-		}
-	}
-	
-	// Reset statistics for new chunk
-	peakSolidVertexCount = 0;
-	peakSemiTransparentVertexCount = 0;
-	rebuildCount = 0;
+	compressed = false;
+	idleTime = 0;
+	solidHeightmap.fill(Heightmap::Empty);
+	nonAirHeightmap.fill(Heightmap::Empty);
 }
 
 /**
@@ -365,9 +444,11 @@ void Chunk::clear() {
 	for (auto& lod : lodData) {
 		lod.solidVertexCount = 0;
 		lod.semiTransparentVertexCount = 0;
-		lod.mesh = nullptr;
+		lod.mesh.reset();
 		lod.isGenerated = false;
 	}
 	
 	currentLOD = LODLevel::Full;
+	dirtySections = ChunkMeshData::AllSections;
+	sectionConnectivity.fill({});
 }
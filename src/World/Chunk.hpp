@@ -3,8 +3,8 @@
  * @brief Représente un segment du monde (chunk) contenant un volume de blocs et un maillage pour le
  * rendu.
  *
- * @details La classe Chunk stocke un tableau 3D de BlockData et gère la reconstruction du maillage
- *          pour le rendu des blocs opaques et semi-transparents. Elle fournit des méthodes pour
+ * @details La classe Chunk stocke les types de blocs dans 16 sections verticales à palette et gère
+ *          la reconstruction du maillage pour le rendu des blocs opaques et semi-transparents. Elle fournit des méthodes pour
  * placer des blocs, vérifier la visibilité via une AABB et interagir avec le système de
  * persistance.
  *
@@ -18,10 +18,16 @@
 #include "../Rendering/BlockVertex.hpp"
 #include "../Rendering/Buffers.hpp"
 #include "../Rendering/Mesh.hpp"
+#include "../Rendering/RenderQueue.hpp"
 #include "../Rendering/Shaders.hpp"
 #include "BlockTypes.hpp"
+#include "ChunkHandle.hpp"
+#include "ChunkMegaBuffer.hpp"
 #include "ChunkMeshBuilder.hpp"
 #include "LODLevel.hpp"
+#include "ChunkSection.hpp"
+#include "SectionConnectivity.hpp"
+#include "Heightmap.hpp"
 
 #include <Frustum.h>
 #include <array>
@@ -35,19 +41,7 @@ class Chunk {
 	static constexpr int32_t VerticalSize = 256;
 
 	static constexpr int32_t BlockCount = HorizontalSize * HorizontalSize * VerticalSize;
-	static constexpr int32_t MaxVertexCount = BlockCount * 8;
-	
-	/**
-	 * @brief Initial vertex capacity for dynamic allocation
-	 * @details Starting with a reasonable capacity based on typical chunk complexity
-	 */
-	static constexpr int32_t InitialVertexCapacity = 8192;
-	
-	/**
-	 * @brief Growth factor for vertex buffer reallocation
-	 */
-	static constexpr float VertexBufferGrowthFactor = 1.5f;
-
+	static constexpr int32_t SectionCount = VerticalSize / ChunkSection::Size;
    private:
 	enum class RenderState { initial, ready, dirty };
 	
@@ -55,8 +49,16 @@ class Chunk {
 	struct LODData {
 		int32_t solidVertexCount = 0;
 		int32_t semiTransparentVertexCount = 0;
-		Ref<VertexArray> mesh;
+		ChunkMeshFormat format = ChunkMeshFormat::vertices;
+		// Range of the mesh in the shared buffer of its format, see ChunkMegaBuffer
+		ChunkMeshAllocation mesh;
 		bool isGenerated = false;
+		
+		/**
+		 * @brief Slot of each section in the mesh buffer, see ChunkMeshData
+		 */
+		std::array<ChunkMeshSlot, SectionCount> solidSlots;
+		std::array<ChunkMeshSlot, SectionCount> semiTransparentSlots;
 	};
 	
 	// Store data for each LOD level
@@ -65,73 +67,131 @@ class Chunk {
 	// Current LOD level being used
 	LODLevel currentLOD = LODLevel::Full;
 	
-	Ref<const ShaderProgram> shader;
 	bool useAmbientOcclusion = true;
 	RenderState renderState;
 	glm::ivec2 worldPosition;
 
 	/**
-	 * @brief Linear storage for block data
-	 * 
-	 * @details Stored in XYZ order (x changes fastest, then y, then z).
-	 *          Index calculation: x + y * HorizontalSize + z * HorizontalSize * VerticalSize
+	 * @brief Incremented on every change that can alter the mesh (block edits, neighbor changes,
+	 *        render settings)
+	 *
+	 * @details Mesh tasks record the version their snapshot was taken at, so results built from
+	 *          outdated data can be recognized and thrown away.
 	 */
-	std::array<BlockData, BlockCount> data;
-	AABB aabb;
-	
+	uint32_t contentVersion = 0;
+
+	/**
+	 * @brief Sections changed since the last full LOD build, one bit per section
+	 *
+	 * @details A full LOD mesh is patched by remeshing only these sections, see takeDirtySections.
+	 */
+	uint16_t dirtySections = ChunkMeshData::AllSections;
+
+	/**
+	 * @brief Faces of each section that see each other, taken from the last mesh applied
+	 *
+	 * @details Sections changed since then stay fully connected, which can only make more
+	 *          sections visible, until their mesh is rebuilt.
+	 */
+	std::array<SectionConnectivity, SectionCount> sectionConnectivity;
+
 	/**
-	 * @brief Convert 3D coordinates to linear index
+	 * @brief Sections reached by the visibility walk of the frame, see World::findVisibleSections
+	 */
+	uint16_t visibleSections = ChunkMeshData::AllSections;
+
+	/**
+	 * @brief Handle of this chunk in the world's ChunkTable, invalid while not loaded
+	 */
+	ChunkHandle handle;
+
+	/**
+	 * @brief Block storage split into 16x16x16 sections stacked along Y
 	 * 
-	 * @param x X coordinate (0 to HorizontalSize-1)
-	 * @param y Y coordinate (0 to VerticalSize-1) 
-	 * @param z Z coordinate (0 to HorizontalSize-1)
-	 * @return Linear index in the data array
+	 * @details Sections that are entirely air or made of a single block type carry no
+	 *          per-block storage. The mixed sections of a cold chunk are compressed (see
+	 *          compressBlocks) and restored by ensureResident on the next access to the blocks;
+	 *          const accessors may do it too since only the representation changes, hence mutable.
 	 */
-	[[nodiscard]] static constexpr int32_t getLinearIndex(int32_t x, int32_t y, int32_t z) {
-		// Use standard XYZ order: x + y * HorizontalSize + z * HorizontalSize * VerticalSize
-		return x + y * HorizontalSize + z * HorizontalSize * VerticalSize;
-	}
-	
+	mutable std::array<ChunkSection, SectionCount> sections;
+	mutable bool compressed = false;
+
 	/**
-	 * @brief Get block data at position
+	 * @brief Seconds since the chunk was last rendered or its blocks were accessed
 	 */
-	[[nodiscard]] BlockData& getBlock(int32_t x, int32_t y, int32_t z) {
-		assert(isInBounds(x, y, z));
-		return data[getLinearIndex(x, y, z)];
-	}
+	mutable float idleTime = 0;
+
+	/**
+	 * @brief Highest solid and highest non-air block of each column, kept up to date by
+	 *        placeBlock and fillSection
+	 */
+	Heightmap solidHeightmap;
+	Heightmap nonAirHeightmap;
+	AABB aabb;
 	
+	/**
+	 * @brief Get the shared block data at position
+	 */
 	[[nodiscard]] const BlockData& getBlock(int32_t x, int32_t y, int32_t z) const {
 		assert(isInBounds(x, y, z));
-		return data[getLinearIndex(x, y, z)];
+		ensureResident();
+		return BlockData::get(
+			sections[y / ChunkSection::Size].get(x, y % ChunkSection::Size, z));
 	}
 
+	void init();
+
+	void ensureResident() const {
+		if (compressed) [[unlikely]] {
+			decompressBlocks();
+		}
+	}
+	void decompressBlocks() const;
+
 	/**
-	 * @brief Temporary vertex storage for mesh building
-	 * 
-	 * @details These vectors are used to store vertices during mesh reconstruction,
-	 *          replacing static variables to ensure thread safety. They are allocated
-	 *          once per chunk and reused for each rebuild operation.
+	 * @brief Updates the heightmaps of a column after blocks of the given class were placed
+	 *        from bottomY to topY (inclusive)
+	 *
+	 * @details Raising a column is O(1); only replacing its top block scans downwards, skipping
+	 *          sections that are empty or uniform.
 	 */
-	Ref<std::vector<BlockVertex>> solidVertices;
-	Ref<std::vector<BlockVertex>> semiTransparentVertices;
-
+	void updateHeightmaps(int32_t x, int32_t z, int32_t bottomY, int32_t topY, BlockData::BlockClass blockClass);
+	[[nodiscard]] int32_t findHighestBlock(int32_t x, int32_t fromY, int32_t z, Heightmap::Type type) const;
 	/**
-	 * @brief Statistics for optimizing memory allocation
-	 * @details Track peak usage to optimize future allocations
+	 * @brief Writes the sections of a partial mesh into their slots
+	 * @return false if a section no longer fits in its slots, nothing is written then
 	 */
-	int32_t peakSolidVertexCount = 0;
-	int32_t peakSemiTransparentVertexCount = 0;
-	int32_t rebuildCount = 0;
+	template <typename T>
+	static bool updateSlots(LODData& lod, const ChunkMeshData& meshData, const std::vector<T>& data);
 
-	void init();
-	void updatePeakUsage();
-	void ensureVertexCapacity(int32_t requiredSolidCapacity, int32_t requiredTransparentCapacity);
+	static void updateVertexCounts(LODData& lod);
+
+	/**
+	 * @brief Takes the section connectivity of a mesh, except for sections changed since it was
+	 *        captured which stay fully connected
+	 */
+	void applyConnectivity(const ChunkMeshData& meshData);
 
    public:
 	explicit Chunk(const glm::ivec2& worldPosition);
 
-	void renderOpaque(const glm::mat4& transform, const Frustum& frustum);
-	void renderSemiTransparent(const glm::mat4& transform, const Frustum& frustum);
+	/**
+	 * @brief Records the solid faces of the drawn mesh, without the face directions that face
+	 *        away from the camera: back faces are culled anyway, so they are not submitted at all
+	 *
+	 * @details Only the sections of getVisibleSections are recorded. Ranges are absolute in the
+	 *          shared buffer of the mesh format (see getMeshFormat), the state is expected to
+	 *          select it.
+	 * @return Vertices recorded, see getSolidVertexCount for the vertices of the whole pass
+	 */
+	int32_t recordSolidDraws(const glm::vec3& cameraPosition,
+							 RenderQueue& queue,
+							 const RenderQueue::State& state) const;
+
+	/**
+	 * @brief Records the semi-transparent faces of the drawn mesh, see recordSolidDraws
+	 */
+	void recordSemiTransparentDraws(RenderQueue& queue, const RenderQueue::State& state) const;
 	void rebuildMesh(const World& world);
 	
 	/**
@@ -145,6 +205,12 @@ class Chunk {
 	 */
 	LODLevel getCurrentLOD() const { return currentLOD; }
 	
+	/**
+	 * @brief LOD whose mesh is drawn: the current LOD, or until its mesh is built the closest
+	 *        LOD that has one (finer first)
+	 */
+	[[nodiscard]] LODLevel getDrawnLOD() const;
+	
 	/**
 	 * @brief Check if a specific LOD level is generated
 	 */
@@ -159,24 +225,121 @@ class Chunk {
 	 *          asynchronously by ChunkMeshBuilder. Must be called from
 	 *          the main thread as it uploads data to GPU.
 	 * 
+	 *          A mesh built for some sections only (see ChunkMeshData::sectionMask) is written
+	 *          into the slots of these sections in the current full LOD allocation, the rest of
+	 *          the mesh is left untouched.
+	 * 
 	 * @param meshData The mesh data to apply
 	 * @param lod The LOD level this mesh data is for
+	 * @param meshBuffer Shared buffer of the format of the mesh, see World::getMeshBuffer
+	 * @return false if a partial mesh outgrew the slots of its sections, the chunk then needs a
+	 *         full rebuild
 	 */
-	void applyMeshData(const ChunkMeshData& meshData, LODLevel lod = LODLevel::Full);
+	bool applyMeshData(const ChunkMeshData& meshData, LODLevel lod, ChunkMegaBuffer& meshBuffer);
 
-	[[nodiscard]] bool needsMeshRebuild() const {
-		// Check if current LOD needs rebuilding
-		const auto& lod = lodData[static_cast<size_t>(currentLOD)];
-		return !lod.isGenerated || !lod.mesh || renderState != RenderState::ready;
+	/**
+	 * @brief Whether the mesh of a LOD level is missing or outdated
+	 * 
+	 * @details Meshes of every level are kept until the chunk changes, so moving back and forth
+	 *          across a LOD distance reuses them instead of building them again.
+	 */
+	[[nodiscard]] bool needsMeshRebuild(LODLevel level) const {
+		const auto& lod = lodData[static_cast<size_t>(level)];
+		return !lod.isGenerated || !lod.mesh;
 	};
-	void setShader(const Ref<const ShaderProgram>& newShader) { shader = newShader; };
-	void setDirty() { 
-		renderState = RenderState::dirty; 
+	[[nodiscard]] bool needsMeshRebuild() const { return needsMeshRebuild(currentLOD); };
+	/**
+	 * @brief Format of the mesh drawn, it selects the shader to draw it with
+	 */
+	[[nodiscard]] ChunkMeshFormat getMeshFormat() const {
+		return lodData[static_cast<size_t>(getDrawnLOD())].format;
+	}
+	/**
+	 * @brief Solid vertices of the mesh drawn, the ones facing away from the camera included
+	 */
+	[[nodiscard]] int32_t getSolidVertexCount() const {
+		return lodData[static_cast<size_t>(getDrawnLOD())].solidVertexCount;
+	}
+	[[nodiscard]] uint32_t getContentVersion() const { return contentVersion; }
+	[[nodiscard]] ChunkHandle getHandle() const { return handle; }
+	void setHandle(ChunkHandle newHandle) { handle = newHandle; }
+	void setDirty() { markSectionsDirty(ChunkMeshData::AllSections); };
+
+	/**
+	 * @brief Invalidates the meshes after a change that only affects some sections
+	 */
+	void markSectionsDirty(uint16_t sectionMask) {
+		renderState = RenderState::dirty;
+		++contentVersion;
+		dirtySections |= sectionMask;
+		for (int32_t section = 0; section < SectionCount; ++section) {
+			if ((sectionMask & (1u << section)) != 0) {
+				sectionConnectivity[section] = SectionConnectivity();
+			}
+		}
 		// Invalidate all LODs when chunk is modified
 		for (auto& lod : lodData) {
 			lod.isGenerated = false;
 		}
-	};
+	}
+
+	/**
+	 * @brief Sections to remesh for the next full LOD build, which are then considered clean
+	 *
+	 * @details All sections when there is no full LOD mesh to patch yet.
+	 */
+	[[nodiscard]] uint16_t takeDirtySections() {
+		const bool canPatch = lodData[static_cast<size_t>(LODLevel::Full)].mesh && dirtySections != 0;
+		const uint16_t sectionMask = canPatch ? dirtySections : ChunkMeshData::AllSections;
+		dirtySections = 0;
+		return sectionMask;
+	}
+
+	/**
+	 * @brief Gives back sections taken by a build whose result was dropped
+	 */
+	void restoreDirtySections(uint16_t sectionMask) { dirtySections |= sectionMask; }
+
+	/**
+	 * @brief Sections whose mesh depends on a block at height y: its own section, and the one
+	 *        below or above when the block lies on their boundary
+	 */
+	[[nodiscard]] static uint16_t getSectionsAround(int32_t y) {
+		const int32_t section = y / ChunkSection::Size;
+		const int32_t localY = y % ChunkSection::Size;
+		uint16_t sectionMask = 1u << section;
+		if (localY == 0 && section > 0) {
+			sectionMask |= 1u << (section - 1);
+		}
+		if (localY == ChunkSection::Size - 1 && section < SectionCount - 1) {
+			sectionMask |= 1u << (section + 1);
+		}
+		return sectionMask;
+	}
+
+	/**
+	 * @brief Face directions of a section that may have a face in front of the camera, in
+	 *        BlockMesh face order
+	 *
+	 * @details A face is front-facing when the camera is in front of its plane. The faces of a
+	 *          direction all lie within the bounds of their section, so a direction whose normal
+	 *          points away from the camera over the whole section has no face to draw.
+	 * @param localCamera Camera position relative to the chunk origin
+	 */
+	[[nodiscard]] static std::array<bool, 6> getFrontFacingDirections(const glm::vec3& localCamera,
+																	   int32_t section) {
+		constexpr auto Size = static_cast<float>(HorizontalSize);
+		const auto bottom = static_cast<float>(section * ChunkSection::Size);
+		return {
+			localCamera.y > bottom,                       // top
+			localCamera.x > 0.0f,                         // east
+			localCamera.x < Size,                         // west
+			localCamera.z < Size,                         // north
+			localCamera.z > 0.0f,                         // south
+			localCamera.y < bottom + ChunkSection::Size,  // bottom
+		};
+	}
+
 	void setUseAmbientOcclusion(bool enabled) {
 		if (enabled == useAmbientOcclusion) {
 			return;
@@ -190,20 +353,35 @@ class Chunk {
 		return frustum.IsBoxVisible(aabb.minPoint, aabb.maxPoint);
 	};
 
+	[[nodiscard]] bool isSectionVisible(const Frustum& frustum, int32_t section) const {
+		const auto bottom = static_cast<float>(section * ChunkSection::Size);
+		return frustum.IsBoxVisible(glm::vec3(aabb.minPoint.x, bottom, aabb.minPoint.z),
+									glm::vec3(aabb.maxPoint.x, bottom + ChunkSection::Size, aabb.maxPoint.z));
+	}
+
+	[[nodiscard]] const SectionConnectivity& getSectionConnectivity(int32_t section) const {
+		return sectionConnectivity[section];
+	}
+
+	/**
+	 * @brief Sections drawn by recordSolidDraws and recordSemiTransparentDraws, one bit per section
+	 */
+	[[nodiscard]] uint16_t getVisibleSections() const { return visibleSections; }
+	void setVisibleSections(uint16_t sectionMask) { visibleSections = sectionMask; }
+	void addVisibleSection(int32_t section) { visibleSections |= 1u << section; }
+
 	void placeBlock(BlockData block, const glm::ivec3& position) {
 		placeBlock(block, position.x, position.y, position.z);
 	}
 
 	void placeBlock(BlockData block, int32_t x, int32_t y, int32_t z) {
 		assert(isInBounds(x, y, z));
+		ensureResident();
+		idleTime = 0;
 
-		renderState = RenderState::dirty;
-		getBlock(x, y, z) = block;
-		
-		// Invalidate all LODs when chunk is modified
-		for (auto& lod : lodData) {
-			lod.isGenerated = false;
-		}
+		markSectionsDirty(getSectionsAround(y));
+		sections[y / ChunkSection::Size].set(x, y % ChunkSection::Size, z, block.type);
+		updateHeightmaps(x, z, y, y, block.blockClass);
 	}
 
 	[[nodiscard]] float distanceToPoint(const glm::vec2& point) const {
@@ -230,23 +408,98 @@ class Chunk {
 	}
 	static glm::ivec3 toChunkCoordinates(const glm::ivec3& globalPosition);
 
-	glm::ivec2 getPosition() { return worldPosition; }
+	glm::ivec2 getPosition() const { return worldPosition; }
 
 	// Methods for ChunkPool
 	void reset(glm::ivec2 newPosition);
 	void clear();
 	
 	/**
-	 * @brief Get memory usage statistics
-	 * @return Pair of (current total vertex capacity, peak total vertex usage)
+	 * @brief Get the GPU memory used by the meshes of all LOD levels, in bytes
+	 */
+	[[nodiscard]] size_t getMeshMemoryUsage() const {
+		size_t usage = 0;
+		for (const auto& lod : lodData) {
+			if (lod.mesh) {
+				usage += static_cast<size_t>(lod.mesh.getSize()) * lod.mesh.getBuffer()->getElementSize();
+			}
+		}
+		return usage;
+	}
+
+	/**
+	 * @brief Vertices of the mesh allocation of a LOD level, spare room included, 0 without a mesh
+	 * @details Sizes the buffers of the next build of that level
+	 */
+	[[nodiscard]] int32_t getMeshVertexCapacity(LODLevel lod) const {
+		const auto& data = lodData[static_cast<size_t>(lod)];
+		if (!data.mesh) {
+			return 0;
+		}
+		return data.mesh.getSize() * data.mesh.getBuffer()->getElementVertices();
+	}
+
+	/**
+	 * @brief Get the heap memory used by the block storage, in bytes
+	 */
+	[[nodiscard]] size_t getBlockMemoryUsage() const {
+		size_t usage = 0;
+		for (const auto& section : sections) {
+			usage += section.getMemoryUsage();
+		}
+		return usage;
+	}
+
+	[[nodiscard]] const ChunkSection& getSection(int32_t index) const {
+		ensureResident();
+		return sections[index];
+	}
+
+	/**
+	 * @brief Section as stored, without decompressing the chunk nor marking it as used: only
+	 *        its state, counts and ChunkSection::readColumns may be read while it is compressed
+	 */
+	[[nodiscard]] const ChunkSection& getStoredSection(int32_t index) const { return sections[index]; }
+
+	/**
+	 * @brief Whether a section holds only air, without decompressing the chunk: the non-air
+	 *        count of a section is kept while it is compressed
+	 */
+	[[nodiscard]] bool isSectionEmpty(int32_t index) const { return getStoredSection(index).isEmpty(); }
+
+	/**
+	 * @brief Compresses the mixed sections of the chunk, see ChunkSection::compress
+	 * @return Number of bytes saved
+	 */
+	size_t compressBlocks();
+	[[nodiscard]] bool isCompressed() const { return compressed; }
+
+	[[nodiscard]] float getIdleTime() const { return idleTime; }
+	void addIdleTime(float deltaTime) { idleTime += deltaTime; }
+	void markUsed() { idleTime = 0; }
+
+	/**
+	 * @brief Height of the highest matching block of a column, Heightmap::Empty if there is none
 	 */
-	[[nodiscard]] std::pair<int32_t, int32_t> getMemoryStats() const {
-		int32_t currentCapacity = 0;
-		if (solidVertices) currentCapacity += solidVertices->capacity();
-		if (semiTransparentVertices) currentCapacity += semiTransparentVertices->capacity();
-		return {currentCapacity, peakSolidVertexCount + peakSemiTransparentVertexCount};
+	[[nodiscard]] int32_t getHeight(int32_t x, int32_t z, Heightmap::Type type) const {
+		return type == Heightmap::Type::solid ? solidHeightmap.get(x, z) : nonAirHeightmap.get(x, z);
 	}
 
+	/**
+	 * @brief Rebuilds both heightmaps from the block data
+	 */
+	void recomputeHeightmaps();
+
+	/**
+	 * @brief Fill a whole section with one block type
+	 * 
+	 * @details Used by the generator for sections known to be uniform, avoids going
+	 *          through placeBlock for every block.
+	 */
+	void fillSection(int32_t index, BlockData::BlockType type);
+
 	friend Persistence;
 	friend class ChunkMeshBuilder;
 };
+
+static_assert(ChunkMeshData::SectionCount == Chunk::SectionCount);
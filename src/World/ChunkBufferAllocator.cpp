@@ -0,0 +1,100 @@
+#include "ChunkBufferAllocator.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+ChunkBufferAllocator::ChunkBufferAllocator(int32_t capacity) : capacity(capacity) {
+	if (capacity > 0) {
+		addFreeBlock(0, capacity);
+	}
+}
+
+void ChunkBufferAllocator::addFreeBlock(int32_t offset, int32_t size) {
+	freeByOffset.emplace(offset, size);
+	freeBySize.emplace(size, offset);
+}
+
+void ChunkBufferAllocator::removeFreeBlock(std::map<int32_t, int32_t>::iterator block) {
+	freeBySize.erase({block->second, block->first});
+	freeByOffset.erase(block);
+}
+
+int32_t ChunkBufferAllocator::allocate(int32_t size) {
+	assert(size > 0 && "Cannot allocate an empty range");
+	const auto fit = freeBySize.lower_bound({size, 0});
+	if (fit == freeBySize.end()) {
+		return InvalidAllocation;
+	}
+
+	// The range takes the start of the block, the rest stays free
+	const auto [blockSize, offset] = *fit;
+	removeFreeBlock(freeByOffset.find(offset));
+	if (blockSize > size) {
+		addFreeBlock(offset + size, blockSize - size);
+	}
+
+	int32_t allocation;
+	if (!freeIds.empty()) {
+		allocation = freeIds.back();
+		freeIds.pop_back();
+	} else {
+		allocation = static_cast<int32_t>(allocations.size());
+		allocations.emplace_back();
+	}
+	allocations[allocation] = {offset, size};
+	usedSize += size;
+	return allocation;
+}
+
+void ChunkBufferAllocator::free(int32_t allocation) {
+	assert(allocation >= 0 && allocation < static_cast<int32_t>(allocations.size()));
+	Range range = allocations[allocation];
+	assert(range.size > 0 && "Allocation already freed");
+	allocations[allocation] = {};
+	freeIds.push_back(allocation);
+	usedSize -= range.size;
+
+	// Merge with the free blocks right after and right before the range
+	auto next = freeByOffset.find(range.offset + range.size);
+	if (next != freeByOffset.end()) {
+		range.size += next->second;
+		removeFreeBlock(next);
+	}
+	auto previous = freeByOffset.lower_bound(range.offset);
+	if (previous != freeByOffset.begin()) {
+		--previous;
+		if (previous->first + previous->second == range.offset) {
+			range.offset = previous->first;
+			range.size += previous->second;
+			removeFreeBlock(previous);
+		}
+	}
+	addFreeBlock(range.offset, range.size);
+}
+
+std::vector<ChunkBufferAllocator::Move> ChunkBufferAllocator::defragment(int32_t newCapacity) {
+	assert(newCapacity >= usedSize && "The live ranges don't fit in the new capacity");
+	std::vector<Move> moves;
+	moves.reserve(getAllocationCount());
+	for (int32_t allocation = 0; allocation < static_cast<int32_t>(allocations.size()); ++allocation) {
+		if (allocations[allocation].size > 0) {
+			moves.push_back({allocation, allocations[allocation].offset, 0, allocations[allocation].size});
+		}
+	}
+	std::sort(moves.begin(), moves.end(), [](const Move& a, const Move& b) { return a.from < b.from; });
+
+	int32_t offset = 0;
+	for (Move& move : moves) {
+		move.to = offset;
+		allocations[move.allocation].offset = offset;
+		offset += move.size;
+	}
+
+	capacity = newCapacity;
+	freeByOffset.clear();
+	freeBySize.clear();
+	if (capacity > usedSize) {
+		addFreeBlock(usedSize, capacity - usedSize);
+	}
+	return moves;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file ChunkBufferAllocator.hpp
+ * @brief Free-list sub-allocator of the ranges of a shared chunk mesh buffer
+ *
+ * @details Chunk meshes live at offsets in one large GPU buffer per mesh format (see
+ *          ChunkMegaBuffer). This class only does the bookkeeping, in elements of the buffer
+ *          (vertices or face records): free blocks are indexed by offset, to merge a freed range
+ *          with its neighbors, and by size, to pick the smallest block that fits. When no block
+ *          fits, defragment packs the live ranges at the start of a buffer of a new capacity and
+ *          returns the copies that move the data there.
+ *
+ *          Allocations are designated by an id whose offset may change on defragmentation, so
+ *          their owners never have to be updated.
+ *
+ * @note No GL call is made here, the allocator can be exercised without a context.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+class ChunkBufferAllocator {
+   public:
+	static constexpr int32_t InvalidAllocation = -1;
+
+	/**
+	 * @brief Copy of a live range from its old offset to its new one, see defragment
+	 */
+	struct Move {
+		int32_t allocation;
+		int32_t from;
+		int32_t to;
+		int32_t size;
+	};
+
+   private:
+	struct Range {
+		int32_t offset = 0;
+		int32_t size = 0;
+	};
+
+	int32_t capacity = 0;
+	int32_t usedSize = 0;
+
+	// Free blocks by offset (to their size) and by (size, offset)
+	std::map<int32_t, int32_t> freeByOffset;
+	std::set<std::pair<int32_t, int32_t>> freeBySize;
+
+	// Ranges of the allocation ids, size 0 for unused ids
+	std::vector<Range> allocations;
+	std::vector<int32_t> freeIds;
+
+	void addFreeBlock(int32_t offset, int32_t size);
+	void removeFreeBlock(std::map<int32_t, int32_t>::iterator block);
+
+   public:
+	explicit ChunkBufferAllocator(int32_t capacity = 0);
+
+	/**
+	 * @brief Reserves size elements in the smallest free block that fits
+	 * @return The allocation id, InvalidAllocation if no free block is large enough
+	 */
+	[[nodiscard]] int32_t allocate(int32_t size);
+
+	/**
+	 * @brief Gives a range back, it is merged with the free blocks around it
+	 */
+	void free(int32_t allocation);
+
+	/**
+	 * @brief Packs the live ranges at the start of a buffer of newCapacity elements, in offset
+	 *        order, leaving a single free block at the end
+	 *
+	 * @param newCapacity At least getUsedSize()
+	 * @return One copy per live range, including the ones that keep their offset: the data is
+	 *         expected to be copied to a new buffer
+	 */
+	std::vector<Move> defragment(int32_t newCapacity);
+
+	[[nodiscard]] int32_t getOffset(int32_t allocation) const { return allocations[allocation].offset; }
+	[[nodiscard]] int32_t getSize(int32_t allocation) const { return allocations[allocation].size; }
+
+	[[nodiscard]] int32_t getCapacity() const { return capacity; }
+	[[nodiscard]] int32_t getUsedSize() const { return usedSize; }
+	[[nodiscard]] int32_t getFreeSize() const { return capacity - usedSize; }
+	[[nodiscard]] int32_t getAllocationCount() const {
+		return static_cast<int32_t>(allocations.size() - freeIds.size());
+	}
+
+	/**
+	 * @brief Largest range that can be allocated without defragmenting
+	 */
+	[[nodiscard]] int32_t getLargestFreeBlock() const {
+		return freeBySize.empty() ? 0 : freeBySize.rbegin()->first;
+	}
+
+	/**
+	 * @brief Number of free blocks, 1 or 0 right after a defragmentation
+	 */
+	[[nodiscard]] int32_t getFreeBlockCount() const { return static_cast<int32_t>(freeByOffset.size()); }
+};
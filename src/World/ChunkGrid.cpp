@@ -0,0 +1,67 @@
+#include "ChunkGrid.hpp"
+
+std::vector<ChunkHandle> ChunkGrid::resize(int32_t newRadius) {
+	TRACE_FUNCTION();
+	std::vector<ChunkHandle> previousSlots;
+	previousSlots.swap(slots);
+
+	radius = std::max(newRadius, 0);
+	size = 2 * radius + 1;
+	slots.assign(static_cast<size_t>(size) * size, ChunkHandle());
+	chunkCount = 0;
+
+	// Chunks are re-inserted with the new modulo, the ones outside the new window are returned
+	std::vector<ChunkHandle> evicted;
+	for (ChunkHandle handle : previousSlots) {
+		const Chunk* chunk = table.get(handle);
+		if (!chunk) {
+			continue;
+		}
+
+		if (isInWindow(chunk->getPosition())) {
+			insert(*chunk);
+		} else {
+			evicted.push_back(handle);
+		}
+	}
+	return evicted;
+}
+
+std::vector<ChunkHandle> ChunkGrid::recenter(const glm::ivec2& worldPosition) {
+	std::vector<ChunkHandle> outside;
+	const glm::ivec2 newCenter = toChunkIndex(worldPosition);
+	if (newCenter == center) {
+		return outside;
+	}
+
+	center = newCenter;
+	forEach([this, &outside](const Chunk& chunk) {
+		if (!isInWindow(chunk.getPosition())) {
+			outside.push_back(chunk.getHandle());
+		}
+	});
+	return outside;
+}
+
+void ChunkGrid::insert(const Chunk& chunk) {
+	ChunkHandle& slot = slots[getSlotIndex(chunk.getPosition())];
+	const Chunk* occupant = table.get(slot);
+	assert((!occupant || occupant->getPosition() == chunk.getPosition()) &&
+		   "Chunk grid slot already in use");
+	if (!occupant) {
+		chunkCount++;
+	}
+	slot = chunk.getHandle();
+}
+
+bool ChunkGrid::remove(const glm::ivec2& worldPosition) {
+	ChunkHandle& slot = slots[getSlotIndex(worldPosition)];
+	const Chunk* occupant = table.get(slot);
+	if (!occupant || occupant->getPosition() != worldPosition) {
+		return false;
+	}
+
+	slot = ChunkHandle();
+	chunkCount--;
+	return true;
+}
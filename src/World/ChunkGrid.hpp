@@ -0,0 +1,114 @@
+/**
+ * @file ChunkGrid.hpp
+ * @brief Fixed-size toroidal storage for the loaded chunks
+ *
+ * @details Loaded chunks always form a square around the player, so they are stored in a dense
+ *          2D array of (2 * radius + 1)^2 slots addressed by chunk index modulo the grid size.
+ *          When the player moves, the chunks entering the window reuse the slots of the chunks
+ *          leaving it on the opposite side and nothing has to be moved. Lookups are an index
+ *          computation and one position check, and iteration walks a contiguous array. Slots
+ *          hold ChunkHandles, the chunks themselves are owned by the ChunkTable.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+#include "../Utils/Utils.hpp"
+#include "Chunk.hpp"
+#include "ChunkTable.hpp"
+
+class ChunkGrid {
+	const ChunkTable& table;
+	int32_t radius = 0;
+	int32_t size = 1;
+	glm::ivec2 center{0};  // Chunk index of the window center
+	std::vector<ChunkHandle> slots;
+	size_t chunkCount = 0;
+
+	/**
+	 * @brief Chunk index of a chunk world position (world positions are multiples of the chunk size)
+	 */
+	[[nodiscard]] static glm::ivec2 toChunkIndex(const glm::ivec2& worldPosition) {
+		return {(worldPosition.x - Util::positiveMod(worldPosition.x, Chunk::HorizontalSize)) /
+					Chunk::HorizontalSize,
+				(worldPosition.y - Util::positiveMod(worldPosition.y, Chunk::HorizontalSize)) /
+					Chunk::HorizontalSize};
+	}
+
+	[[nodiscard]] size_t getSlotIndex(const glm::ivec2& worldPosition) const {
+		const glm::ivec2 index = toChunkIndex(worldPosition);
+		return Util::positiveMod(index.x, size) + Util::positiveMod(index.y, size) * size;
+	}
+
+   public:
+	explicit ChunkGrid(const ChunkTable& table, int32_t radius = 0) : table(table) { resize(radius); }
+
+	/**
+	 * @brief Changes the window radius (in chunks)
+	 * @return Chunks that no longer fit in the window; they are removed from the grid
+	 */
+	std::vector<ChunkHandle> resize(int32_t newRadius);
+
+	/**
+	 * @brief Moves the window center to the chunk containing a world position
+	 *
+	 * @details Slots don't depend on the center, so this only reports the chunks that ended up
+	 *          outside of the window. They stay in the grid until the caller removes them.
+	 */
+	std::vector<ChunkHandle> recenter(const glm::ivec2& worldPosition);
+
+	/**
+	 * @brief Whether a chunk world position lies inside the window
+	 */
+	[[nodiscard]] bool isInWindow(const glm::ivec2& worldPosition) const {
+		const glm::ivec2 offset = glm::abs(toChunkIndex(worldPosition) - center);
+		return offset.x <= radius && offset.y <= radius;
+	}
+
+	/**
+	 * @brief Chunk stored at a world position, nullptr if it is not loaded
+	 */
+	[[nodiscard]] Chunk* find(const glm::ivec2& worldPosition) const {
+		Chunk* chunk = table.get(slots[getSlotIndex(worldPosition)]);
+		return chunk && chunk->getPosition() == worldPosition ? chunk : nullptr;
+	}
+
+	[[nodiscard]] bool contains(const glm::ivec2& worldPosition) const {
+		return find(worldPosition) != nullptr;
+	}
+
+	/**
+	 * @brief Chunk currently occupying the slot a world position maps to, whatever its position
+	 */
+	[[nodiscard]] Chunk* getSlotOccupant(const glm::ivec2& worldPosition) const {
+		return table.get(slots[getSlotIndex(worldPosition)]);
+	}
+
+	/**
+	 * @brief Stores a chunk of the table at its position
+	 * @note The slot must be free or already hold this position, see getSlotOccupant
+	 */
+	void insert(const Chunk& chunk);
+
+	/**
+	 * @brief Removes the chunk stored at a world position
+	 * @return true if a chunk was removed
+	 */
+	bool remove(const glm::ivec2& worldPosition);
+
+	/**
+	 * @brief Calls function(Chunk&) for every stored chunk
+	 */
+	template <typename Function>
+	void forEach(Function&& function) const {
+		for (ChunkHandle handle : slots) {
+			if (Chunk* chunk = table.get(handle)) {
+				function(*chunk);
+			}
+		}
+	}
+
+	[[nodiscard]] size_t getChunkCount() const { return chunkCount; }
+	[[nodiscard]] bool isEmpty() const { return chunkCount == 0; }
+	[[nodiscard]] int32_t getRadius() const { return radius; }
+};
@@ -0,0 +1,48 @@
+/**
+ * @file ChunkHandle.hpp
+ * @brief 32-bit reference to a chunk stored in the ChunkTable
+ *
+ * @details A handle packs the index of a ChunkTable slot with the generation of that slot. The
+ *          generation is bumped whenever the chunk of the slot is removed, so a handle kept by a
+ *          region or a mesh task after its chunk was unloaded no longer resolves, instead of
+ *          pointing to freed or recycled memory. The generation never wraps: a slot is retired
+ *          once it has used all of them.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class ChunkHandle {
+   public:
+	static constexpr uint32_t IndexBits = 20;
+	static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+	static constexpr uint32_t GenerationMask = (1u << (32 - IndexBits)) - 1;
+
+	/**
+	 * @brief Largest slot index a table can hand out (IndexMask is reserved for invalid handles)
+	 */
+	static constexpr uint32_t MaxIndex = IndexMask - 1;
+
+   private:
+	uint32_t value = ~0u;
+
+   public:
+	constexpr ChunkHandle() = default;
+	constexpr ChunkHandle(uint32_t index, uint32_t generation)
+		: value((index & IndexMask) | ((generation & GenerationMask) << IndexBits)) {}
+
+	[[nodiscard]] constexpr uint32_t getIndex() const { return value & IndexMask; }
+	[[nodiscard]] constexpr uint32_t getGeneration() const { return value >> IndexBits; }
+	[[nodiscard]] constexpr bool isValid() const { return getIndex() != IndexMask; }
+	[[nodiscard]] constexpr uint32_t getValue() const { return value; }
+
+	constexpr bool operator==(const ChunkHandle& other) const = default;
+
+	struct Hash {
+		size_t operator()(const ChunkHandle& handle) const noexcept { return handle.value; }
+	};
+};
+
+static_assert(sizeof(ChunkHandle) == 4, "ChunkHandle must stay 32 bits");
@@ -0,0 +1,128 @@
+#include "ChunkMegaBuffer.hpp"
+
+#include "../Core/PerformanceMonitor.hpp"
+
+namespace {
+	// Chunk origin of each draw, see ChunkDrawList
+	constexpr uint32_t OriginLocation = 3;
+}
+
+ChunkMegaBuffer::ChunkMegaBuffer(ChunkMeshFormat format, int32_t capacity)
+	: format(format),
+	  elementSize(format == ChunkMeshFormat::faceRecords ? sizeof(FaceRecord) : sizeof(BlockVertex)),
+	  allocator(capacity) {
+	buffer = createBuffer(capacity * elementSize);
+	glGenBuffers(1, &originBuffer);
+	glGenBuffers(1, &indirectBuffer);
+
+	glGenVertexArrays(1, &vertexArray);
+	glBindVertexArray(vertexArray);
+	bindMeshAttributes();
+	glBindBuffer(GL_ARRAY_BUFFER, originBuffer);
+	glVertexAttribIPointer(OriginLocation, 2, GL_INT, sizeof(glm::ivec2), nullptr);
+	glEnableVertexAttribArray(OriginLocation);
+	glVertexAttribDivisor(OriginLocation, 1);  // One origin per draw, selected by baseInstance
+	glBindVertexArray(0);
+}
+
+ChunkMegaBuffer::~ChunkMegaBuffer() {
+	glDeleteVertexArrays(1, &vertexArray);
+	glDeleteBuffers(1, &buffer);
+	glDeleteBuffers(1, &originBuffer);
+	glDeleteBuffers(1, &indirectBuffer);
+}
+
+uint32_t ChunkMegaBuffer::createBuffer(int32_t byteSize) {
+	uint32_t id;
+	glGenBuffers(1, &id);
+	glBindBuffer(GL_ARRAY_BUFFER, id);
+	glBufferData(GL_ARRAY_BUFFER, byteSize, nullptr, GL_DYNAMIC_DRAW);
+	return id;
+}
+
+void ChunkMegaBuffer::bindMeshAttributes() {
+	// Face records have no vertex attribute, the buffer is bound as a storage buffer when drawing
+	if (format != ChunkMeshFormat::vertices) {
+		return;
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+	const std::vector<VertexAttribute> attributes = BlockVertex::vertexAttributes();
+	for (uint32_t i = 0; i < attributes.size(); i++) {
+		glVertexAttribIPointer(i, attributes[i].componentCount, attributes[i].type, sizeof(BlockVertex),
+							   reinterpret_cast<void*>(static_cast<uintptr_t>(attributes[i].offset)));
+		glEnableVertexAttribArray(i);
+	}
+}
+
+int32_t ChunkMegaBuffer::allocate(int32_t size) {
+	int32_t allocation = allocator.allocate(size);
+	if (allocation == ChunkBufferAllocator::InvalidAllocation) {
+		relocate(size);
+		allocation = allocator.allocate(size);
+		assert(allocation != ChunkBufferAllocator::InvalidAllocation);
+	}
+	return allocation;
+}
+
+void ChunkMegaBuffer::relocate(int32_t size) {
+	TRACE_FUNCTION();
+	PERF_TIMER("ChunkMegaBuffer::relocate");
+
+	// Compacting is enough while the buffer stays at most 3/4 full, the buffer doubles otherwise
+	const int32_t capacity = allocator.getCapacity();
+	const int32_t required = allocator.getUsedSize() + size;
+	int32_t newCapacity = capacity;
+	if (required > capacity / 4 * 3) {
+		newCapacity = std::max(capacity * 2, required + required / 3);
+	}
+
+	const uint32_t newBuffer = createBuffer(newCapacity * elementSize);
+	std::vector<ChunkBufferAllocator::Move> moves = allocator.defragment(newCapacity);
+
+	glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+	for (size_t i = 0; i < moves.size();) {
+		// Ranges that were already contiguous are copied at once
+		const int32_t from = moves[i].from;
+		const int32_t to = moves[i].to;
+		int32_t copySize = moves[i].size;
+		for (++i; i < moves.size() && moves[i].from == from + copySize; ++i) {
+			copySize += moves[i].size;
+		}
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(from) * elementSize,
+							static_cast<GLintptr>(to) * elementSize, static_cast<GLsizeiptr>(copySize) * elementSize);
+	}
+
+	glDeleteBuffers(1, &buffer);
+	buffer = newBuffer;
+	glBindVertexArray(vertexArray);
+	bindMeshAttributes();
+	glBindVertexArray(0);
+	relocationCount++;
+}
+
+void ChunkMegaBuffer::draw(const ChunkDrawList& drawList) {
+	TRACE_FUNCTION();
+	if (drawList.isEmpty()) {
+		return;
+	}
+
+	// Both tables are rewritten for every pass, orphaning the previous storage
+	glBindBuffer(GL_ARRAY_BUFFER, originBuffer);
+	glBufferData(GL_ARRAY_BUFFER, drawList.origins.size() * sizeof(glm::ivec2), drawList.origins.data(),
+				 GL_STREAM_DRAW);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER, drawList.commands.size() * sizeof(ChunkDrawList::Command),
+				 drawList.commands.data(), GL_STREAM_DRAW);
+
+	// Face records are read by world_faces.vert from a storage buffer, gl_VertexID / 6 being
+	// the absolute index of the record
+	if (format == ChunkMeshFormat::faceRecords) {
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, buffer);
+	}
+
+	glBindVertexArray(vertexArray);
+	glMultiDrawArraysIndirect(GL_TRIANGLES, nullptr, drawList.getCommandCount(), 0);
+	glBindVertexArray(0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
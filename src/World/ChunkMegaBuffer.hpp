@@ -0,0 +1,208 @@
+/**
+ * @file ChunkMegaBuffer.hpp
+ * @brief Single GPU buffer holding the meshes of all chunks of one mesh format
+ *
+ * @details Instead of one vertex array per chunk and LOD, every chunk mesh is a range of a shared
+ *          buffer handed out by a ChunkBufferAllocator. A pass then collects the ranges of all the
+ *          visible chunks in a ChunkDrawList and draws them with one glMultiDrawArraysIndirect:
+ *          each command reads the origin of its chunk from a per-draw table, as an instanced
+ *          attribute (location 3) selected by its baseInstance. Vertices and face records stay
+ *          chunk-local, the vertex shaders add the origin.
+ *
+ *          When no free block is large enough, the live ranges are copied into a new buffer,
+ *          packed in offset order (see ChunkBufferAllocator::defragment). The buffer is only
+ *          enlarged when compacting would leave it nearly full.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+#include "ChunkBufferAllocator.hpp"
+#include "ChunkMeshBuilder.hpp"
+
+/**
+ * @brief Draws of a pass for one ChunkMegaBuffer, see ChunkMegaBuffer::draw
+ */
+class ChunkDrawList {
+   public:
+	/**
+	 * @brief Layout expected by glMultiDrawArraysIndirect
+	 */
+	struct Command {
+		uint32_t count;
+		uint32_t instanceCount;
+		uint32_t first;
+		uint32_t baseInstance;
+	};
+
+   private:
+	std::vector<glm::ivec2> origins;
+	std::vector<Command> commands;
+	int32_t vertexCount = 0;
+
+	friend class ChunkMegaBuffer;
+
+   public:
+	void clear() {
+		origins.clear();
+		commands.clear();
+		vertexCount = 0;
+	}
+
+	/**
+	 * @brief Starts the draws of a chunk, the ranges added next are drawn at its origin
+	 */
+	void addChunk(const glm::ivec2& origin) { origins.push_back(origin); }
+
+	/**
+	 * @brief Adds a range of vertices, first being absolute in the buffer
+	 */
+	void addRange(int32_t first, int32_t count) {
+		assert(!origins.empty() && "A chunk must be added before its ranges");
+		// Ranges that follow each other in the buffer are merged
+		if (!commands.empty() && commands.back().baseInstance == origins.size() - 1 &&
+			commands.back().first + commands.back().count == static_cast<uint32_t>(first)) {
+			commands.back().count += count;
+		} else {
+			commands.push_back({static_cast<uint32_t>(count), 1, static_cast<uint32_t>(first),
+								static_cast<uint32_t>(origins.size() - 1)});
+		}
+		vertexCount += count;
+	}
+
+	[[nodiscard]] bool isEmpty() const { return commands.empty(); }
+	[[nodiscard]] int32_t getCommandCount() const { return static_cast<int32_t>(commands.size()); }
+	[[nodiscard]] int32_t getVertexCount() const { return vertexCount; }
+};
+
+class ChunkMegaBuffer {
+	ChunkMeshFormat format;
+	int32_t elementSize;
+	ChunkBufferAllocator allocator;
+
+	uint32_t buffer = 0;
+	uint32_t vertexArray = 0;
+	uint32_t originBuffer = 0;
+	uint32_t indirectBuffer = 0;
+
+	int32_t relocationCount = 0;
+
+	static uint32_t createBuffer(int32_t byteSize);
+	void bindMeshAttributes();
+
+	/**
+	 * @brief Copies the live ranges into a new buffer with room for size more elements
+	 */
+	void relocate(int32_t size);
+
+   public:
+	/**
+	 * @param capacity Initial capacity, in elements (vertices or face records)
+	 */
+	ChunkMegaBuffer(ChunkMeshFormat format, int32_t capacity);
+	~ChunkMegaBuffer();
+
+	/**
+	 * @brief Reserves size elements, compacting or growing the buffer if needed
+	 * @return The allocation id, see ChunkBufferAllocator
+	 */
+	[[nodiscard]] int32_t allocate(int32_t size);
+	void free(int32_t allocation) { allocator.free(allocation); }
+
+	/**
+	 * @brief Uploads size elements of data, from dataOffset, at elementOffset in an allocation
+	 */
+	template <typename T>
+	void write(int32_t allocation,
+			   const std::vector<T>& data,
+			   int32_t size,
+			   int32_t dataOffset = 0,
+			   int32_t elementOffset = 0) {
+		assert(sizeof(T) == static_cast<size_t>(elementSize) && "Data doesn't match the buffer format");
+		assert(dataOffset + size <= static_cast<int32_t>(data.size()) && "Data is out of bounds");
+		assert(elementOffset + size <= allocator.getSize(allocation) && "Allocation is out of bounds");
+		glBindBuffer(GL_ARRAY_BUFFER, buffer);
+		glBufferSubData(GL_ARRAY_BUFFER,
+						static_cast<GLintptr>(allocator.getOffset(allocation) + elementOffset) * elementSize,
+						static_cast<GLsizeiptr>(size) * elementSize, &data[dataOffset]);
+	}
+
+	/**
+	 * @brief Issues the draws of a list in one call, with the shader of the format bound
+	 */
+	void draw(const ChunkDrawList& drawList);
+
+	[[nodiscard]] ChunkMeshFormat getFormat() const { return format; }
+
+	/**
+	 * @brief Vertices drawn per element: face records are expanded to 6 vertices each
+	 */
+	[[nodiscard]] int32_t getElementVertices() const {
+		return format == ChunkMeshFormat::faceRecords ? FaceRecord::VerticesPerFace : 1;
+	}
+	[[nodiscard]] int32_t getElementSize() const { return elementSize; }
+	[[nodiscard]] int32_t getOffset(int32_t allocation) const { return allocator.getOffset(allocation); }
+	[[nodiscard]] int32_t getSize(int32_t allocation) const { return allocator.getSize(allocation); }
+	[[nodiscard]] const ChunkBufferAllocator& getAllocator() const { return allocator; }
+
+	/**
+	 * @brief Number of times the ranges were copied to a new buffer
+	 */
+	[[nodiscard]] int32_t getRelocationCount() const { return relocationCount; }
+
+	ChunkMegaBuffer(const ChunkMegaBuffer&) = delete;
+	ChunkMegaBuffer& operator=(const ChunkMegaBuffer&) = delete;
+};
+
+/**
+ * @brief Range of a chunk mesh in a ChunkMegaBuffer, given back when destroyed
+ *
+ * @details An empty mesh is a valid allocation without range.
+ */
+class ChunkMeshAllocation {
+	ChunkMegaBuffer* buffer = nullptr;
+	int32_t allocation = ChunkBufferAllocator::InvalidAllocation;
+
+   public:
+	ChunkMeshAllocation() = default;
+	ChunkMeshAllocation(ChunkMegaBuffer& buffer, int32_t size)
+		: buffer(&buffer), allocation(size > 0 ? buffer.allocate(size) : ChunkBufferAllocator::InvalidAllocation) {}
+	~ChunkMeshAllocation() { reset(); }
+
+	ChunkMeshAllocation(ChunkMeshAllocation&& other) noexcept
+		: buffer(std::exchange(other.buffer, nullptr)),
+		  allocation(std::exchange(other.allocation, ChunkBufferAllocator::InvalidAllocation)) {}
+	ChunkMeshAllocation& operator=(ChunkMeshAllocation&& other) noexcept {
+		if (this != &other) {
+			reset();
+			buffer = std::exchange(other.buffer, nullptr);
+			allocation = std::exchange(other.allocation, ChunkBufferAllocator::InvalidAllocation);
+		}
+		return *this;
+	}
+	ChunkMeshAllocation(const ChunkMeshAllocation&) = delete;
+	ChunkMeshAllocation& operator=(const ChunkMeshAllocation&) = delete;
+
+	void reset() {
+		if (buffer && allocation != ChunkBufferAllocator::InvalidAllocation) {
+			buffer->free(allocation);
+		}
+		buffer = nullptr;
+		allocation = ChunkBufferAllocator::InvalidAllocation;
+	}
+
+	explicit operator bool() const { return buffer != nullptr; }
+
+	[[nodiscard]] ChunkMegaBuffer* getBuffer() const { return buffer; }
+	[[nodiscard]] int32_t getId() const { return allocation; }
+
+	/**
+	 * @brief Offset and size of the range, in elements, 0 for an empty mesh
+	 */
+	[[nodiscard]] int32_t getOffset() const {
+		return allocation != ChunkBufferAllocator::InvalidAllocation ? buffer->getOffset(allocation) : 0;
+	}
+	[[nodiscard]] int32_t getSize() const {
+		return allocation != ChunkBufferAllocator::InvalidAllocation ? buffer->getSize(allocation) : 0;
+	}
+};
@@ -0,0 +1,44 @@
+#include "ChunkMeshBufferPool.hpp"
+
+std::unique_ptr<ChunkMeshBuffers> ChunkMeshBufferPool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!freeBuffers.empty()) {
+            std::unique_ptr<ChunkMeshBuffers> buffers = std::move(freeBuffers.back());
+            freeBuffers.pop_back();
+            hitCount++;
+            return buffers;
+        }
+        missCount++;
+    }
+
+    // Allocated outside of the lock, workers may be releasing buffers meanwhile
+    return std::make_unique<ChunkMeshBuffers>();
+}
+
+void ChunkMeshBufferPool::release(std::unique_ptr<ChunkMeshBuffers> buffers) {
+    if (!buffers) {
+        return;
+    }
+    buffers->meshData.clear();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (freeBuffers.size() < MaxFreeBuffers) {
+        freeBuffers.push_back(std::move(buffers));
+    }
+}
+
+size_t ChunkMeshBufferPool::getFreeCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return freeBuffers.size();
+}
+
+size_t ChunkMeshBufferPool::getHitCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hitCount;
+}
+
+size_t ChunkMeshBufferPool::getMissCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return missCount;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file ChunkMeshBufferPool.hpp
+ * @brief Recycles the snapshot and mesh buffers of finished mesh tasks
+ *
+ * @details A mesh task needs a ChunkSnapshot and a ChunkMeshData whose vectors grow while the
+ *          mesh is built. Instead of allocating them for every task and freeing them once the
+ *          mesh is uploaded, finished tasks hand their buffers back to the pool and the next
+ *          task reuses them with the capacity they already have. In steady state the vectors are
+ *          large enough for any chunk and building a mesh no longer allocates.
+ *
+ * @note Thread-safe: buffers are acquired on the main thread and may be released on a worker.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+#include "ChunkMeshBuilder.hpp"
+#include "ChunkSnapshot.hpp"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Input and output buffers of one mesh task
+ */
+struct ChunkMeshBuffers {
+    ChunkSnapshot snapshot;
+    ChunkMeshData meshData;
+};
+
+class ChunkMeshBufferPool {
+    /**
+     * @brief Free buffers kept at most, the ones released past it are freed. The tasks of a
+     *        loading burst can outnumber it, steady state only needs one per task in flight.
+     */
+    static constexpr size_t MaxFreeBuffers = 64;
+
+    std::vector<std::unique_ptr<ChunkMeshBuffers>> freeBuffers;
+    mutable std::mutex mutex;
+    size_t hitCount = 0;
+    size_t missCount = 0;
+
+   public:
+    /**
+     * @brief Hands out buffers for a task, recycling released ones when possible. The snapshot
+     *        is overwritten by ChunkSnapshot::capture and the mesh data by the builder.
+     */
+    std::unique_ptr<ChunkMeshBuffers> acquire();
+
+    /**
+     * @brief Gives the buffers of a finished task back, their capacity is kept
+     */
+    void release(std::unique_ptr<ChunkMeshBuffers> buffers);
+
+    [[nodiscard]] size_t getFreeCount() const;
+
+    /**
+     * @brief Acquisitions served by recycled buffers / by allocating new ones
+     */
+    [[nodiscard]] size_t getHitCount() const;
+    [[nodiscard]] size_t getMissCount() const;
+};
@@ -1,145 +1,883 @@
 #include "ChunkMeshBuilder.hpp"
-#include "Chunk.hpp"
-#include "World.hpp"
-#include "../Core/Assets.hpp"
+#include "BlockRegistry.hpp"
+#include "ChunkSnapshot.hpp"
 #include "../Core/PerformanceMonitor.hpp"
+#include <algorithm>
+#include <bit>
+#include <type_traits>
 
-bool ChunkMeshBuilder::hasNonAirAt(const glm::ivec3& pos, const Chunk& chunk, const World& world) {
-    const BlockData* block = chunk.getBlockAtOptimized(pos, world);
-    return block != nullptr && block->blockClass != BlockData::BlockClass::air;
-}
-
-uint8_t ChunkMeshBuilder::calculateOcclusionLevel(const glm::ivec3& blockPos,
-                                                  const glm::ivec3& vertOffset,
-                                                  const Chunk& chunk,
-                                                  const World& world,
-                                                  bool useAmbientOcclusion) {
-    if (!useAmbientOcclusion) {
-        return 3; // No occlusion
+namespace {
+    // Direction offsets for face checking, with the matching BlockMesh face index
+    // and the index difference to the neighbor in the snapshot
+    struct FaceDirection {
+        glm::ivec3 offset;
+        int32_t face;
+        int32_t stride;
+    };
+    constexpr FaceDirection makeFace(glm::ivec3 offset) {
+        return FaceDirection{offset, BlockRegistry::getFaceIndex(offset), ChunkSnapshot::getStride(offset)};
     }
+    // In BlockMesh face order, the order of the direction groups of the mesh slots
+    constexpr std::array<FaceDirection, 6> facesToCheck = {{
+        makeFace({0, 1, 0}),
+        makeFace({1, 0, 0}),
+        makeFace({-1, 0, 0}),
+        makeFace({0, 0, -1}),
+        makeFace({0, 0, 1}),
+        makeFace({0, -1, 0}),
+    }};
+    static_assert([] {
+        for (size_t i = 0; i < facesToCheck.size(); ++i) {
+            if (facesToCheck[i].face != static_cast<int32_t>(i)) {
+                return false;
+            }
+        }
+        return true;
+    }());
     
-    glm::ivec3 direction = glm::sign(glm::vec3(vertOffset) - glm::vec3(.5));
+    // World axis followed by the u and v texture coordinates of each face (BlockMesh order)
+    constexpr std::array<int32_t, 6> faceUAxis = {2, 2, 2, 0, 0, 2};
+    constexpr std::array<int32_t, 6> faceVAxis = {0, 1, 1, 1, 1, 0};
     
-    uint8_t side1 = hasNonAirAt(blockPos + direction * glm::ivec3(1, 1, 0), chunk, world) ? 1 : 0;
-    uint8_t side2 = hasNonAirAt(blockPos + direction * glm::ivec3(0, 1, 1), chunk, world) ? 1 : 0;
-    if (side1 && side2) {
-        return 0;
+    /**
+     * @brief Appends a face covering extent blocks from origin, as 6 vertices or as one face record
+     *
+     * @param occlusionLevels Occlusion level of each vertex of the face, BlockMesh order
+     */
+    void appendFace(ChunkMeshData& meshData,
+                    bool semiTransparent,
+                    int32_t face,
+                    const glm::ivec3& origin,
+                    const glm::ivec3& extent,
+                    uint8_t textureLayer,
+                    const std::array<uint8_t, 6>& occlusionLevels) {
+        if (meshData.format == ChunkMeshFormat::faceRecords) {
+            std::array<uint8_t, FaceRecord::CornerCount> cornerOcclusion{};
+            for (size_t i = 0; i < BlockMesh::vertices[face].size(); ++i) {
+                cornerOcclusion[FaceRecord::getCorner(BlockMesh::vertices[face][i].getUv())] = occlusionLevels[i];
+            }
+            // A record only scales its face along u and v: the face of a box that is thicker
+            // than a block along the normal (reduced LOD cells) starts at the far side of the box
+            glm::ivec3 recordOrigin = origin;
+            const int32_t normalAxis = 3 - faceUAxis[face] - faceVAxis[face];
+            recordOrigin[normalAxis] += BlockMesh::vertices[face][0].getPosition()[normalAxis] * (extent[normalAxis] - 1);
+            auto& faces = semiTransparent ? meshData.semiTransparentFaces : meshData.solidFaces;
+            faces.emplace_back(recordOrigin, face, textureLayer, cornerOcclusion,
+                               extent[faceUAxis[face]], extent[faceVAxis[face]]);
+            return;
+        }
+        
+        auto& vertices = semiTransparent ? meshData.semiTransparentVertices : meshData.solidVertices;
+        for (size_t i = 0; i < BlockMesh::vertices[face].size(); ++i) {
+            BlockVertex vert = BlockMesh::vertices[face][i];
+            const glm::ivec3 position = origin + vert.getPosition() * extent;
+            vert.setPosition(position.x, position.y, position.z);
+            vert.setUvScale(extent[faceUAxis[face]], extent[faceVAxis[face]]);
+            vert.setTextureIndex(textureLayer);
+            vert.setOcclusionLevel(occlusionLevels[i]);
+            vertices.push_back(vert);
+        }
+    }
+
+    /**
+     * @brief Closes the group of a face direction in the section being emitted, the directions
+     *        must be emitted in facesToCheck order
+     */
+    void endFaceGroup(ChunkMeshData& meshData, int32_t face) {
+        const bool records = meshData.format == ChunkMeshFormat::faceRecords;
+        meshData.solidFaceEnds[face] =
+            static_cast<int32_t>(records ? meshData.solidFaces.size() : meshData.solidVertices.size());
+        meshData.semiTransparentFaceEnds[face] = static_cast<int32_t>(
+            records ? meshData.semiTransparentFaces.size() : meshData.semiTransparentVertices.size());
+    }
+
+    constexpr int32_t PaddedSize = ChunkSection::Size + 2;
+    constexpr uint32_t SectionBits = (1u << ChunkSection::Size) - 1;
+
+    // Slot of each kind of block in ColumnMasks, the block classes followed by the void blocks
+    constexpr size_t VoidSlot = 4;
+
+    /**
+     * @brief Occupancy of one padded column of a section, one mask per block class plus the void
+     *        blocks. Bit i is the block at section-local height i - 1, so bits 0 and 17 come from
+     *        the sections below and above.
+     */
+    using ColumnMasks = std::array<uint32_t, VoidSlot + 1>;
+
+    /**
+     * @brief Column masks of a section and of its one block border, x and z in [-1, 16]
+     */
+    struct SectionOccupancy {
+        std::array<ColumnMasks, PaddedSize * PaddedSize> columns;
+
+        // Blocks of any class but air of each column, read by the ambient occlusion
+        std::array<uint32_t, PaddedSize * PaddedSize> nonAir;
+
+        static constexpr int32_t getColumn(int32_t x, int32_t z) {
+            return (x + 1) + (z + 1) * PaddedSize;
+        }
+    };
+
+    /**
+     * @brief Visible faces of a section for each direction (BlockMesh face order),
+     *        one section-local Y bit per block for each x + z * 16 column
+     */
+    using SectionFaceMasks = std::array<std::array<uint16_t, ChunkSection::Size * ChunkSection::Size>, 6>;
+
+    /**
+     * @brief ColumnMasks slot of every block type, filled once from the registry
+     */
+    const std::array<uint8_t, 256>& getMaskSlots() {
+        static const std::array<uint8_t, 256> slots = [] {
+            std::array<uint8_t, 256> result;
+            result.fill(VoidSlot);
+            for (size_t type = 0; type < BlockData::TypeCount; ++type) {
+                result[type] = static_cast<uint8_t>(
+                    BlockRegistry::getInstance().getClass(static_cast<BlockData::BlockType>(type)));
+            }
+            return result;
+        }();
+        return slots;
+    }
+
+    void buildOccupancy(const ChunkSnapshot& snapshot, int32_t sectionIndex, SectionOccupancy& occupancy) {
+        const std::array<uint8_t, 256>& slots = getMaskSlots();
+        const int32_t bottomY = sectionIndex * ChunkSection::Size - 1;
+        occupancy.columns.fill(ColumnMasks{});
+
+        // A padded layer of the section is a contiguous 18x18 block of the snapshot, laid out
+        // like the columns, so the snapshot is read in order
+        static_assert(PaddedSize == ChunkSnapshot::HorizontalSize);
+        for (int32_t bit = 0; bit < PaddedSize; ++bit) {
+            const int32_t layerStart = ChunkSnapshot::getIndex(-1, bottomY + bit, -1);
+            for (int32_t column = 0; column < PaddedSize * PaddedSize; ++column) {
+                const auto type = static_cast<uint8_t>(snapshot.get(layerStart + column));
+                occupancy.columns[column][slots[type]] |= 1u << bit;
+            }
+        }
+
+        for (size_t column = 0; column < occupancy.columns.size(); ++column) {
+            const ColumnMasks& masks = occupancy.columns[column];
+            occupancy.nonAir[column] = masks[static_cast<size_t>(BlockData::BlockClass::solid)] |
+                                       masks[static_cast<size_t>(BlockData::BlockClass::semiTransparent)] |
+                                       masks[static_cast<size_t>(BlockData::BlockClass::transparent)];
+        }
+    }
+
+    /**
+     * @brief Derives the visible faces of a section from its occupancy
+     *
+     * @details Same rules as ChunkMeshBuilder::isFaceVisible, applied to a whole column at once:
+     *          faces between blocks of the same class, of transparent blocks against solid blocks,
+     *          or against the void are hidden. Each class gets the mask of the neighbors hiding
+     *          its faces, so a direction only costs a shift (vertical neighbors) and a few ANDs.
+     *
+     * @return false if the section has no visible face at all
+     */
+    bool buildFaceMasks(const SectionOccupancy& occupancy, SectionFaceMasks& faceMasks) {
+        using BlockClass = BlockData::BlockClass;
+        struct ColumnFaces {
+            uint32_t solid, semiTransparent, transparent;
+            uint32_t hidesSolid, hidesSemiTransparent, hidesTransparent;
+        };
+        std::array<ColumnFaces, PaddedSize * PaddedSize> columns;
+        for (size_t column = 0; column < columns.size(); ++column) {
+            const ColumnMasks& masks = occupancy.columns[column];
+            const uint32_t solid = masks[static_cast<size_t>(BlockClass::solid)];
+            const uint32_t semiTransparent = masks[static_cast<size_t>(BlockClass::semiTransparent)];
+            const uint32_t transparent = masks[static_cast<size_t>(BlockClass::transparent)];
+            columns[column] = {solid, semiTransparent, transparent,
+                               solid | masks[VoidSlot],
+                               semiTransparent | masks[VoidSlot],
+                               transparent | solid | masks[VoidSlot]};
+        }
+
+        // Neighbor masks are aligned on the block bits before the test, only bits 1 to 16 are kept
+        const auto getVisible = [](const ColumnFaces& block, const ColumnFaces& neighbor, int32_t shift) {
+            const auto align = [shift](uint32_t mask) { return shift > 0 ? mask >> shift : mask << -shift; };
+            const uint32_t visible = (block.solid & ~align(neighbor.hidesSolid)) |
+                                     (block.semiTransparent & ~align(neighbor.hidesSemiTransparent)) |
+                                     (block.transparent & ~align(neighbor.hidesTransparent));
+            return static_cast<uint16_t>((visible >> 1) & SectionBits);
+        };
+
+        constexpr int32_t top = BlockRegistry::getFaceIndex({0, 1, 0});
+        constexpr int32_t bottom = BlockRegistry::getFaceIndex({0, -1, 0});
+        constexpr int32_t east = BlockRegistry::getFaceIndex({1, 0, 0});
+        constexpr int32_t west = BlockRegistry::getFaceIndex({-1, 0, 0});
+        constexpr int32_t south = BlockRegistry::getFaceIndex({0, 0, 1});
+        constexpr int32_t north = BlockRegistry::getFaceIndex({0, 0, -1});
+
+        uint32_t anyVisible = 0;
+        for (int32_t z = 0; z < ChunkSection::Size; ++z) {
+            for (int32_t x = 0; x < ChunkSection::Size; ++x) {
+                const int32_t column = SectionOccupancy::getColumn(x, z);
+                const ColumnFaces& block = columns[column];
+                const int32_t index = x + z * ChunkSection::Size;
+                faceMasks[top][index] = getVisible(block, block, 1);
+                faceMasks[bottom][index] = getVisible(block, block, -1);
+                faceMasks[east][index] = getVisible(block, columns[column + 1], 0);
+                faceMasks[west][index] = getVisible(block, columns[column - 1], 0);
+                faceMasks[south][index] = getVisible(block, columns[column + PaddedSize], 0);
+                faceMasks[north][index] = getVisible(block, columns[column - PaddedSize], 0);
+                anyVisible |= faceMasks[top][index] | faceMasks[bottom][index] | faceMasks[east][index] |
+                              faceMasks[west][index] | faceMasks[south][index] | faceMasks[north][index];
+            }
+        }
+        return anyVisible != 0;
+    }
+
+    /**
+     * @brief Bit of a block in the 3x3x3 neighborhood cube of getNeighborhood, offset in [-1, 1]
+     */
+    constexpr int32_t getCubeBit(const glm::ivec3& offset) {
+        return (offset.y + 1) + 3 * ((offset.x + 1) + 3 * (offset.z + 1));
+    }
+
+    /**
+     * @brief Non-air blocks around a block, one bit per block of the 3x3x3 cube centered on it
+     *
+     * @details Each column of the cube is 3 consecutive bits of the column masks, so the cube
+     *          costs 9 shifts whatever the number of faces and corners that read it.
+     *
+     * @param localPos Section-local position of the block
+     */
+    uint32_t getNeighborhood(const SectionOccupancy& occupancy, const glm::ivec3& localPos) {
+        uint32_t cube = 0;
+        for (int32_t dz = -1; dz <= 1; ++dz) {
+            for (int32_t dx = -1; dx <= 1; ++dx) {
+                const uint32_t column = occupancy.nonAir[SectionOccupancy::getColumn(localPos.x + dx, localPos.z + dz)];
+                // Bit localPos.y of a padded column is the block below the center
+                cube |= ((column >> localPos.y) & 0x7u) << getCubeBit({dx, -1, dz});
+            }
+        }
+        return cube;
+    }
+
+    /**
+     * @brief Cube bits read by the ambient occlusion of each face: the two sides and the corner
+     *        block of each face corner, and the corner of each vertex (FaceRecord::getCorner)
+     */
+    struct FaceOcclusionBits {
+        std::array<std::array<uint8_t, 3>, FaceRecord::CornerCount> cornerBits;
+        std::array<uint8_t, 6> vertexCorners;
+    };
+
+    /**
+     * @brief FaceOcclusionBits of every face, filled once from the BlockMesh vertices
+     *
+     * @details The blocks are those of the per-vertex rule this replaces: with a vertex offset of
+     *          0 or 1 on each axis and direction = offset * 2 - 1, the sides are at direction *
+     *          (1, 1, 0) and direction * (0, 1, 1) and the corner at direction.
+     */
+    const std::array<FaceOcclusionBits, 6>& getFaceOcclusionBits() {
+        static const std::array<FaceOcclusionBits, 6> faces = [] {
+            std::array<FaceOcclusionBits, 6> result{};
+            for (size_t face = 0; face < result.size(); ++face) {
+                for (size_t i = 0; i < BlockMesh::vertices[face].size(); ++i) {
+                    const BlockVertex& vertex = BlockMesh::vertices[face][i];
+                    const int32_t corner = FaceRecord::getCorner(vertex.getUv());
+                    const glm::ivec3 direction = vertex.getPosition() * 2 - 1;
+                    result[face].vertexCorners[i] = static_cast<uint8_t>(corner);
+                    result[face].cornerBits[corner] = {
+                        static_cast<uint8_t>(getCubeBit(direction * glm::ivec3(1, 1, 0))),
+                        static_cast<uint8_t>(getCubeBit(direction * glm::ivec3(0, 1, 1))),
+                        static_cast<uint8_t>(getCubeBit(direction))};
+                }
+            }
+            return result;
+        }();
+        return faces;
+    }
+
+    /**
+     * @brief Occlusion level from 0 (fully occluded) to 3 (no occlusion) of a corner, indexed by
+     *        side1 | side2 << 1 | corner << 2. Two occluding sides hide the corner block.
+     */
+    constexpr std::array<uint8_t, 8> cornerOcclusionLevels = {3, 2, 2, 0, 2, 1, 1, 0};
+
+    /**
+     * @brief Occlusion level of each vertex of a face, fixed when ambient occlusion is off and
+     *        for bottom faces. The 4 corners are computed once and shared by the 6 vertices.
+     */
+    std::array<uint8_t, 6> getOcclusionLevels(const SectionOccupancy& occupancy,
+                                              const glm::ivec3& localPos,
+                                              int32_t face,
+                                              bool useAmbientOcclusion) {
+        std::array<uint8_t, 6> occlusionLevels;
+        if (!useAmbientOcclusion) {
+            occlusionLevels.fill(3);
+            return occlusionLevels;
+        }
+        if (face == BlockRegistry::getFaceIndex({0, -1, 0})) {
+            occlusionLevels.fill(0);
+            return occlusionLevels;
+        }
+        
+        const FaceOcclusionBits& bits = getFaceOcclusionBits()[face];
+        const uint32_t cube = getNeighborhood(occupancy, localPos);
+        std::array<uint8_t, FaceRecord::CornerCount> corners;
+        for (size_t corner = 0; corner < corners.size(); ++corner) {
+            const auto& [side1, side2, diagonal] = bits.cornerBits[corner];
+            corners[corner] = cornerOcclusionLevels[((cube >> side1) & 1) | ((cube >> side2) & 1) << 1 |
+                                                    ((cube >> diagonal) & 1) << 2];
+        }
+        for (size_t i = 0; i < occlusionLevels.size(); ++i) {
+            occlusionLevels[i] = corners[bits.vertexCorners[i]];
+        }
+        return occlusionLevels;
+    }
+
+    bool isSemiTransparentPass(BlockData::BlockClass blockClass) {
+        return blockClass == BlockData::BlockClass::semiTransparent ||
+               blockClass == BlockData::BlockClass::transparent;
+    }
+
+    /**
+     * @brief Render pass of every block type (1 for the semi-transparent pass), filled once from
+     *        the registry
+     */
+    const std::array<uint8_t, 256>& getPassIndices() {
+        static const std::array<uint8_t, 256> passes = [] {
+            std::array<uint8_t, 256> result{};
+            for (size_t type = 0; type < BlockData::TypeCount; ++type) {
+                result[type] = isSemiTransparentPass(
+                    BlockRegistry::getInstance().getClass(static_cast<BlockData::BlockType>(type)));
+            }
+            return result;
+        }();
+        return passes;
+    }
+
+    /**
+     * @brief Emits one quad per visible face of a section towards one direction, visiting only the
+     *        set bits of the masks
+     */
+    void emitDirectionFaces(const ChunkSnapshot& snapshot,
+                            int32_t sectionIndex,
+                            const SectionOccupancy& occupancy,
+                            const SectionFaceMasks& faceMasks,
+                            int32_t face,
+                            bool useAmbientOcclusion,
+                            ChunkMeshData& outMeshData) {
+        const BlockRegistry::Table<uint8_t>& faceLayers = BlockRegistry::getInstance().getFaceLayers(face);
+        const std::array<uint8_t, 256>& passes = getPassIndices();
+        const int32_t sectionBase = sectionIndex * ChunkSection::Size;
+
+        for (int32_t z = 0; z < ChunkSection::Size; ++z) {
+            for (int32_t x = 0; x < ChunkSection::Size; ++x) {
+                uint32_t bits = faceMasks[face][x + z * ChunkSection::Size];
+                while (bits != 0) {
+                    const int32_t localY = std::countr_zero(bits);
+                    bits &= bits - 1;
+
+                    const glm::ivec3 blockPos = {x, sectionBase + localY, z};
+                    const auto type = static_cast<uint8_t>(snapshot.get(ChunkSnapshot::getIndex(blockPos.x, blockPos.y, blockPos.z)));
+                    appendFace(outMeshData, passes[type] != 0, face, blockPos, glm::ivec3(1), faceLayers[type],
+                               getOcclusionLevels(occupancy, {x, localY, z}, face, useAmbientOcclusion));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Merges the visible faces of a section towards one direction into rectangles, plane
+     *        by plane
+     */
+    void emitDirectionGreedyFaces(const ChunkSnapshot& snapshot,
+                                  int32_t sectionIndex,
+                                  const SectionOccupancy& occupancy,
+                                  const SectionFaceMasks& faceMasks,
+                                  int32_t face,
+                                  bool useAmbientOcclusion,
+                                  ChunkMeshData& outMeshData) {
+        constexpr int32_t Size = ChunkSection::Size;
+        const glm::ivec3 offset = facesToCheck[face].offset;
+        const BlockRegistry::Table<uint8_t>& faceLayers = BlockRegistry::getInstance().getFaceLayers(face);
+        const std::array<uint8_t, 256>& passes = getPassIndices();
+        const glm::ivec3 sectionOrigin = {0, sectionIndex * Size, 0};
+
+        // Planes are perpendicular to the face normal, faces are merged along axisA and axisB
+        const int32_t normalAxis = offset.x != 0 ? 0 : (offset.y != 0 ? 1 : 2);
+        const int32_t axisA = (normalAxis + 1) % 3;
+        const int32_t axisB = (normalAxis + 2) % 3;
+
+        // Faces of the current plane that can be merged, 0 when there is none, otherwise
+        // 1 + (texture layer | occlusion level << 8 | semi-transparent pass << 10)
+        std::array<uint32_t, Size * Size> mask;
+
+        // Planes holding at least one visible face
+        uint32_t planes = 0;
+        for (int32_t z = 0; z < Size; ++z) {
+            for (int32_t x = 0; x < Size; ++x) {
+                const uint32_t bits = faceMasks[face][x + z * Size];
+                if (bits != 0) {
+                    planes |= normalAxis == 1 ? bits : 1u << (normalAxis == 0 ? x : z);
+                }
+            }
+        }
+
+        for (; planes != 0; planes &= planes - 1) {
+            const int32_t plane = std::countr_zero(planes);
+            bool hasMergeableFaces = false;
+            for (int32_t b = 0; b < Size; ++b) {
+                for (int32_t a = 0; a < Size; ++a) {
+                    uint32_t& cell = mask[a + b * Size];
+                    cell = 0;
+
+                    glm::ivec3 localPos(0);
+                    localPos[normalAxis] = plane;
+                    localPos[axisA] = a;
+                    localPos[axisB] = b;
+                    if (((faceMasks[face][localPos.x + localPos.z * Size] >> localPos.y) & 1) == 0) {
+                        continue;
+                    }
+
+                    const glm::ivec3 blockPos = sectionOrigin + localPos;
+                    const auto type = static_cast<uint8_t>(snapshot.get(ChunkSnapshot::getIndex(blockPos.x, blockPos.y, blockPos.z)));
+                    const uint8_t pass = passes[type];
+                    const uint8_t textureLayer = faceLayers[type];
+                    const std::array<uint8_t, 6> occlusionLevels =
+                        getOcclusionLevels(occupancy, localPos, face, useAmbientOcclusion);
+                    const bool uniformOcclusion = std::all_of(occlusionLevels.begin(), occlusionLevels.end(),
+                        [&](uint8_t level) { return level == occlusionLevels[0]; });
+                    if (!uniformOcclusion) {
+                        // Merging would stretch the occlusion gradient over the whole quad
+                        appendFace(outMeshData, pass != 0, face, blockPos, glm::ivec3(1), textureLayer,
+                                   occlusionLevels);
+                        continue;
+                    }
+
+                    cell = 1 + (textureLayer | (occlusionLevels[0] << 8) | (static_cast<uint32_t>(pass) << 10));
+                    hasMergeableFaces = true;
+                }
+            }
+
+            if (!hasMergeableFaces) {
+                continue;
+            }
+
+            // Grow each remaining face along axisA first, then along axisB while whole rows match
+            for (int32_t b = 0; b < Size; ++b) {
+                for (int32_t a = 0; a < Size;) {
+                    const uint32_t key = mask[a + b * Size];
+                    if (key == 0) {
+                        ++a;
+                        continue;
+                    }
+
+                    int32_t width = 1;
+                    while (a + width < Size && mask[a + width + b * Size] == key) {
+                        ++width;
+                    }
+
+                    int32_t height = 1;
+                    while (b + height < Size &&
+                           std::all_of(&mask[a + (b + height) * Size], &mask[a + width + (b + height) * Size],
+                                       [key](uint32_t other) { return other == key; })) {
+                        ++height;
+                    }
+
+                    for (int32_t row = b; row < b + height; ++row) {
+                        std::fill_n(&mask[a + row * Size], width, 0u);
+                    }
+
+                    glm::ivec3 origin = sectionOrigin;
+                    origin[normalAxis] += plane;
+                    origin[axisA] += a;
+                    origin[axisB] += b;
+                    glm::ivec3 extent(1);
+                    extent[axisA] = width;
+                    extent[axisB] = height;
+
+                    const uint32_t faceData = key - 1;
+                    std::array<uint8_t, 6> occlusionLevels;
+                    occlusionLevels.fill(static_cast<uint8_t>((faceData >> 8) & 0x03));
+                    appendFace(outMeshData, ((faceData >> 10) & 1) != 0, face, origin, extent, faceData & 0xFF,
+                               occlusionLevels);
+
+                    a += width;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Emits the faces of a section in every direction, closing the group of each one
+     */
+    void emitSection(const ChunkSnapshot& snapshot,
+                     int32_t sectionIndex,
+                     const SectionOccupancy& occupancy,
+                     const SectionFaceMasks& faceMasks,
+                     bool useGreedyMeshing,
+                     bool useAmbientOcclusion,
+                     ChunkMeshData& outMeshData) {
+        for (const FaceDirection& direction : facesToCheck) {
+            if (useGreedyMeshing) {
+                emitDirectionGreedyFaces(snapshot, sectionIndex, occupancy, faceMasks, direction.face,
+                                         useAmbientOcclusion, outMeshData);
+            } else {
+                emitDirectionFaces(snapshot, sectionIndex, occupancy, faceMasks, direction.face, useAmbientOcclusion,
+                                   outMeshData);
+            }
+            endFaceGroup(outMeshData, direction.face);
+        }
+    }
+
+    /**
+     * @brief Block standing for a box of the snapshot in the reduced LOD meshes
+     *
+     * @details The box is filled when at least half of its loaded blocks are not air. It then
+     *          takes the block class with the most blocks, and the most frequent type of that
+     *          class in the highest layer of the box where the class appears, so that hills keep
+     *          their grass on top. Void if no block of the box is loaded.
+     */
+    BlockData::BlockType downsampleBox(const ChunkSnapshot& snapshot, const glm::ivec3& min, const glm::ivec3& size) {
+        const BlockRegistry& registry = BlockRegistry::getInstance();
+        std::array<int32_t, BlockData::TypeCount> typeCounts{};
+        int32_t loadedCount = 0;
+        for (int32_t y = min.y; y < min.y + size.y; ++y) {
+            for (int32_t z = min.z; z < min.z + size.z; ++z) {
+                for (int32_t x = min.x; x < min.x + size.x; ++x) {
+                    const BlockData::BlockType type = snapshot.get(ChunkSnapshot::getIndex(x, y, z));
+                    if (type != ChunkSnapshot::Void) {
+                        ++typeCounts[static_cast<size_t>(type)];
+                        ++loadedCount;
+                    }
+                }
+            }
+        }
+
+        if (loadedCount == 0) {
+            return ChunkSnapshot::Void;
+        }
+        const int32_t nonAirCount = loadedCount - typeCounts[static_cast<size_t>(BlockData::BlockType::air)];
+        if (nonAirCount * 2 < loadedCount) {
+            return BlockData::BlockType::air;
+        }
+
+        std::array<int32_t, 4> classCounts{};
+        for (size_t type = 0; type < BlockData::TypeCount; ++type) {
+            classCounts[static_cast<size_t>(registry.getClass(static_cast<BlockData::BlockType>(type)))] +=
+                typeCounts[type];
+        }
+        classCounts[static_cast<size_t>(BlockData::BlockClass::air)] = 0;
+        const auto dominantClass = static_cast<BlockData::BlockClass>(
+            std::max_element(classCounts.begin(), classCounts.end()) - classCounts.begin());
+
+        // Surface block: most frequent type of the dominant class in its highest layer
+        for (int32_t y = min.y + size.y - 1; y >= min.y; --y) {
+            std::array<int32_t, BlockData::TypeCount> layerCounts{};
+            bool found = false;
+            for (int32_t z = min.z; z < min.z + size.z; ++z) {
+                for (int32_t x = min.x; x < min.x + size.x; ++x) {
+                    const BlockData::BlockType type = snapshot.get(ChunkSnapshot::getIndex(x, y, z));
+                    if (type != ChunkSnapshot::Void && registry.getClass(type) == dominantClass) {
+                        ++layerCounts[static_cast<size_t>(type)];
+                        found = true;
+                    }
+                }
+            }
+            if (found) {
+                return static_cast<BlockData::BlockType>(
+                    std::max_element(layerCounts.begin(), layerCounts.end()) - layerCounts.begin());
+            }
+        }
+        return BlockData::BlockType::air;
+    }
+
+    /**
+     * @brief Appends the slots of a section to the upload layout and moves its faces there
+     */
+    template <typename T>
+    void appendSectionSlots(std::vector<T>& layout,
+                            std::vector<T>& solidData,
+                            std::vector<T>& semiTransparentData,
+                            const std::array<int32_t, 6>& solidFaceEnds,
+                            const std::array<int32_t, 6>& semiTransparentFaceEnds,
+                            ChunkMeshSlot& solidSlot,
+                            ChunkMeshSlot& semiTransparentSlot,
+                            bool withSpareRoom) {
+        // Vertices or records per face, the unit of the slots
+        constexpr int32_t faceSize = std::is_same_v<T, FaceRecord> ? 1 : FaceRecord::VerticesPerFace;
+        // Both slots of a section with faces get spare room, an edit may add its first face to
+        // either pass; sections without any face get none and need a full rebuild to gain some
+        const bool hasFaces = !solidData.empty() || !semiTransparentData.empty();
+        
+        auto appendSlot = [&](std::vector<T>& data, const std::array<int32_t, 6>& faceEnds, ChunkMeshSlot& slot) {
+            slot.first = static_cast<int32_t>(layout.size());
+            slot.size = static_cast<int32_t>(data.size());
+            for (size_t face = 0; face < faceEnds.size(); ++face) {
+                slot.faceSizes[face] = faceEnds[face] - (face > 0 ? faceEnds[face - 1] : 0);
+            }
+            slot.capacity = slot.size;
+            if (withSpareRoom && hasFaces) {
+                slot.capacity += slot.size / 4 + ChunkMeshData::SlotSpareFaces * faceSize;
+            }
+            layout.insert(layout.end(), data.begin(), data.end());
+            layout.resize(slot.first + slot.capacity);
+            data.clear();
+        };
+        appendSlot(solidData, solidFaceEnds, solidSlot);
+        appendSlot(semiTransparentData, semiTransparentFaceEnds, semiTransparentSlot);
+    }
+}
+
+bool ChunkMeshBuilder::isFaceVisible(BlockData::BlockClass blockClass, BlockData::BlockType neighborType) {
+    if (neighborType == ChunkSnapshot::Void) {
+        return false;
     }
     
-    uint8_t corner = hasNonAirAt(blockPos + direction * glm::ivec3(1, 1, 1), chunk, world) ? 1 : 0;
-    return 3 - (side1 + side2 + corner);
+    const BlockData::BlockClass neighborClass = BlockRegistry::getInstance().getClass(neighborType);
+    bool isSameClass = neighborClass == blockClass;
+    bool isTransparentNextToOpaque =
+        neighborClass == BlockData::BlockClass::solid &&
+        blockClass == BlockData::BlockClass::transparent;
+    return !isSameClass && !isTransparentNextToOpaque;
 }
 
-void ChunkMeshBuilder::buildMesh(const Chunk& chunk, 
-                                const World& world,
-                                const Assets& assets,
+void ChunkMeshBuilder::buildMesh(const ChunkSnapshot& snapshot,
                                 bool useAmbientOcclusion,
                                 ChunkMeshData& outMeshData,
-                                LODLevel lod) {
+                                LODLevel lod,
+                                bool useGreedyMeshing,
+                                ChunkMeshFormat format,
+                                uint16_t sectionMask) {
     TRACE_FUNCTION();
-    PERF_TIMER("ChunkMeshBuilder::buildMesh");
     
     // Clear output data
     outMeshData.clear();
+    outMeshData.format = format;
+    outMeshData.sectionMask = lod == LODLevel::Full ? sectionMask : ChunkMeshData::AllSections;
+    computeConnectivity(snapshot, outMeshData);
     
-    // Reserve estimated capacity
-    int32_t estimatedVertices = estimateVertexCount(chunk);
-    outMeshData.reserve(estimatedVertices);
-    
-    // Direction offsets for face checking
-    const std::array<glm::ivec3, 6> offsetsToCheck = {{
-        {1, 0, 0},
-        {-1, 0, 0},
-        {0, 1, 0},
-        {0, -1, 0},
-        {0, 0, 1},
-        {0, 0, -1},
-    }};
+    // Reserve the size of the previous mesh of the chunk, or an estimate for a first build. A
+    // reduced LOD face covers cellSize x cellSize block faces.
+    if (outMeshData.sizeHint > 0) {
+        outMeshData.reserve(outMeshData.sizeHint);
+    } else {
+        const int32_t cellSize = LODSelector::getCellSize(lod);
+        int32_t estimatedVertices = estimateVertexCount(snapshot) / (cellSize * cellSize);
+        estimatedVertices = estimatedVertices * std::popcount(outMeshData.sectionMask) / Chunk::SectionCount;
+        outMeshData.reserve(estimatedVertices);
+    }
     
-    // Get block skip factor based on LOD
-    int skipFactor = LODSelector::getBlockSkipFactor(lod);
+    if (lod != LODLevel::Full) {
+        buildReducedMesh(snapshot, lod, outMeshData);
+        finishMesh(outMeshData);
+        updateVertexCounts(outMeshData);
+        PerformanceMonitor::getInstance().recordCount(
+            "Mesh Vertices per Chunk (reduced LOD)",
+            outMeshData.solidVertexCount + outMeshData.semiTransparentVertexCount);
+        return;
+    }
     
-    // Iterate through all blocks in the chunk with LOD-based stepping
     {
-        PERF_TIMER("ChunkMeshBuilder::blockIteration");
-        for (int32_t x = Chunk::HorizontalSize - 1; x >= 0; x -= skipFactor) {
-            for (int32_t y = Chunk::VerticalSize - 1; y >= 0; y -= skipFactor) {
-                for (int32_t z = Chunk::HorizontalSize - 1; z >= 0; z -= skipFactor) {
-                glm::ivec3 blockPos = {x, y, z};
-                const BlockData* blockData = chunk.getBlockAt(blockPos);
-                if (!blockData || blockData->blockClass == BlockData::BlockClass::air) {
+        PERF_TIMER(useGreedyMeshing ? "ChunkMeshBuilder::buildGreedyMesh" : "ChunkMeshBuilder::buildMesh");
+        SectionOccupancy occupancy;
+        SectionFaceMasks faceMasks;
+        for (int32_t sectionIndex = Chunk::SectionCount - 1; sectionIndex >= 0; --sectionIndex) {
+            if ((outMeshData.sectionMask & (1u << sectionIndex)) == 0 ||
+                snapshot.getSectionState(sectionIndex) == ChunkSection::State::empty) {
+                continue;
+            }
+            
+            buildOccupancy(snapshot, sectionIndex, occupancy);
+            if (!buildFaceMasks(occupancy, faceMasks)) {
+                continue;
+            }
+            
+            emitSection(snapshot, sectionIndex, occupancy, faceMasks, useGreedyMeshing, useAmbientOcclusion,
+                        outMeshData);
+            finishSection(outMeshData, sectionIndex);
+        }
+    }
+    
+    finishMesh(outMeshData);
+    updateVertexCounts(outMeshData);
+    PerformanceMonitor::getInstance().recordCount(
+        useGreedyMeshing ? "Mesh Vertices per Chunk (greedy)" : "Mesh Vertices per Chunk (per face)",
+        outMeshData.solidVertexCount + outMeshData.semiTransparentVertexCount);
+}
+
+void ChunkMeshBuilder::buildReducedMesh(const ChunkSnapshot& snapshot,
+                                        LODLevel lod,
+                                        ChunkMeshData& outMeshData) {
+    PERF_TIMER("ChunkMeshBuilder::buildReducedMesh");
+    const BlockRegistry& registry = BlockRegistry::getInstance();
+    
+    const int32_t cellSize = LODSelector::getCellSize(lod);
+    const int32_t cellsAcross = Chunk::HorizontalSize / cellSize;
+    const int32_t cellsHigh = Chunk::VerticalSize / cellSize;
+    
+    // Downsampled chunk surrounded by one ring of neighbor cells. The snapshot only holds one
+    // column of each neighbor, so the ring cells are downsampled from that column alone.
+    const int32_t gridSize = cellsAcross + 2;
+    std::vector<BlockData::BlockType> cells(gridSize * gridSize * cellsHigh, ChunkSnapshot::Void);
+    auto getCellIndex = [gridSize](const glm::ivec3& cell) {
+        return (cell.x + 1) + (cell.z + 1) * gridSize + cell.y * gridSize * gridSize;
+    };
+    
+    for (int32_t cellY = 0; cellY < cellsHigh; ++cellY) {
+        const int32_t sectionIndex = cellY * cellSize / ChunkSection::Size;
+        const ChunkSection::State state = snapshot.getSectionState(sectionIndex);
+        for (int32_t cellZ = -1; cellZ <= cellsAcross; ++cellZ) {
+            for (int32_t cellX = -1; cellX <= cellsAcross; ++cellX) {
+                const bool outsideX = cellX < 0 || cellX == cellsAcross;
+                const bool outsideZ = cellZ < 0 || cellZ == cellsAcross;
+                if (outsideX && outsideZ) {
                     continue;
                 }
                 
-                const auto& [type, blockClass] = *blockData;
+                glm::ivec3 min = glm::ivec3(cellX, cellY, cellZ) * cellSize;
+                glm::ivec3 size(cellSize);
+                if (outsideX) {
+                    min.x = cellX < 0 ? -1 : Chunk::HorizontalSize;
+                    size.x = 1;
+                }
+                if (outsideZ) {
+                    min.z = cellZ < 0 ? -1 : Chunk::HorizontalSize;
+                    size.z = 1;
+                }
                 
-                // Check each face
-                for (const glm::ivec3& offset : offsetsToCheck) {
-                    const BlockData* neighborBlock = chunk.getBlockAtOptimized(blockPos + offset, world);
-                    if (neighborBlock == nullptr) {
-                        continue;
-                    }
-                    
-                    bool isSameClass = neighborBlock->blockClass == blockClass;
-                    bool isTransparentNextToOpaque =
-                        neighborBlock->blockClass == BlockData::BlockClass::solid &&
-                        blockClass == BlockData::BlockClass::transparent;
-                    if (isSameClass || isTransparentNextToOpaque) {
-                        continue;
-                    }
-                    
-                    // Generate vertices for this face
-                    // For lower LODs, we simply skip blocks rather than scaling vertices
-                    for (const auto& vertex : BlockMesh::getVerticesFromDirection(offset)) {
-                        BlockVertex vert = vertex;
-                        vert.offset(x, y, z);
-                        vert.setType(offset, type, assets);
-                        
-                        uint8_t occlusionLevel = 3;
-                        if (useAmbientOcclusion && lod == LODLevel::Full) {
-                            // Only calculate ambient occlusion for full LOD
-                            if (offset.y == -1) {
-                                occlusionLevel = 0;
-                            } else {
-                                occlusionLevel = calculateOcclusionLevel(
-                                    blockPos, vert.getPosition() - blockPos, chunk, world, useAmbientOcclusion);
-                            }
+                BlockData::BlockType& cell = cells[getCellIndex({cellX, cellY, cellZ})];
+                if (!outsideX && !outsideZ && state == ChunkSection::State::empty) {
+                    cell = BlockData::BlockType::air;
+                } else if (!outsideX && !outsideZ && state == ChunkSection::State::uniform) {
+                    cell = snapshot.get(ChunkSnapshot::getIndex(min.x, min.y, min.z));
+                } else {
+                    cell = downsampleBox(snapshot, min, size);
+                }
+            }
+        }
+    }
+    
+    // One face of cellSize x cellSize blocks per visible cell face, without ambient occlusion,
+    // grouped by direction within each section
+    std::array<uint8_t, 6> occlusionLevels;
+    occlusionLevels.fill(3);
+    const int32_t cellsPerSection = ChunkSection::Size / cellSize;
+    for (int32_t sectionIndex = Chunk::SectionCount - 1; sectionIndex >= 0; --sectionIndex) {
+        for (const auto& [offset, face, stride] : facesToCheck) {
+            for (int32_t cellY = (sectionIndex + 1) * cellsPerSection - 1; cellY >= sectionIndex * cellsPerSection; --cellY) {
+                for (int32_t cellZ = 0; cellZ < cellsAcross; ++cellZ) {
+                    for (int32_t cellX = 0; cellX < cellsAcross; ++cellX) {
+                        const glm::ivec3 cellPos(cellX, cellY, cellZ);
+                        const BlockData::BlockType type = cells[getCellIndex(cellPos)];
+                        if (type == ChunkSnapshot::Void) {
+                            continue;
+                        }
+                        const BlockData::BlockClass blockClass = registry.getClass(type);
+                        if (blockClass == BlockData::BlockClass::air) {
+                            continue;
                         }
-                        vert.setOcclusionLevel(occlusionLevel);
                         
-                        // Add to appropriate vertex list
-                        if (blockClass == BlockData::BlockClass::semiTransparent ||
-                            blockClass == BlockData::BlockClass::transparent) {
-                            outMeshData.semiTransparentVertices.push_back(vert);
-                            outMeshData.semiTransparentVertexCount++;
-                        } else {
-                            outMeshData.solidVertices.push_back(vert);
-                            outMeshData.solidVertexCount++;
+                        const glm::ivec3 neighborPos = cellPos + offset;
+                        const BlockData::BlockType neighborType = neighborPos.y < 0 || neighborPos.y >= cellsHigh
+                                                                      ? ChunkSnapshot::Void
+                                                                      : cells[getCellIndex(neighborPos)];
+                        if (!isFaceVisible(blockClass, neighborType)) {
+                            continue;
                         }
+                        
+                        appendFace(outMeshData, isSemiTransparentPass(blockClass), face, cellPos * cellSize,
+                                   glm::ivec3(cellSize), registry.getFaceLayer(type, face), occlusionLevels);
                     }
                 }
             }
+            endFaceGroup(outMeshData, face);
         }
+        finishSection(outMeshData, sectionIndex);
+    }
+}
+
+void ChunkMeshBuilder::updateVertexCounts(ChunkMeshData& meshData) {
+    const int32_t elementVertices = meshData.format == ChunkMeshFormat::faceRecords ? FaceRecord::VerticesPerFace : 1;
+    meshData.solidVertexCount = 0;
+    meshData.semiTransparentVertexCount = 0;
+    for (int32_t section = 0; section < ChunkMeshData::SectionCount; ++section) {
+        meshData.solidVertexCount += meshData.solidSlots[section].size * elementVertices;
+        meshData.semiTransparentVertexCount += meshData.semiTransparentSlots[section].size * elementVertices;
+    }
+}
+
+void ChunkMeshBuilder::finishSection(ChunkMeshData& meshData, int32_t sectionIndex) {
+    const bool withSpareRoom = meshData.sectionMask == ChunkMeshData::AllSections;
+    if (meshData.format == ChunkMeshFormat::faceRecords) {
+        appendSectionSlots(meshData.faces, meshData.solidFaces, meshData.semiTransparentFaces,
+                           meshData.solidFaceEnds, meshData.semiTransparentFaceEnds,
+                           meshData.solidSlots[sectionIndex], meshData.semiTransparentSlots[sectionIndex], withSpareRoom);
+    } else {
+        appendSectionSlots(meshData.vertices, meshData.solidVertices, meshData.semiTransparentVertices,
+                           meshData.solidFaceEnds, meshData.semiTransparentFaceEnds,
+                           meshData.solidSlots[sectionIndex], meshData.semiTransparentSlots[sectionIndex], withSpareRoom);
+    }
+    meshData.solidFaceEnds.fill(0);
+    meshData.semiTransparentFaceEnds.fill(0);
+}
+
+void ChunkMeshBuilder::finishMesh(ChunkMeshData& meshData) {
+    if (meshData.sectionMask != ChunkMeshData::AllSections) {
+        return;
+    }
+    if (meshData.format == ChunkMeshFormat::faceRecords && meshData.faces.empty()) {
+        meshData.faces.emplace_back();
+    } else if (meshData.format == ChunkMeshFormat::vertices && meshData.vertices.empty()) {
+        meshData.vertices.emplace_back();
+    }
+}
+
+void ChunkMeshBuilder::computeConnectivity(const ChunkSnapshot& snapshot, ChunkMeshData& meshData) {
+    PERF_TIMER("ChunkMeshBuilder::computeConnectivity");
+    const BlockRegistry& registry = BlockRegistry::getInstance();
+    SectionConnectivity::SolidColumns solid;
+    for (int32_t sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex) {
+        if ((meshData.sectionMask & (1u << sectionIndex)) == 0) {
+            continue;
+        }
+        
+        // Empty and uniform sections are either fully open or fully closed
+        const int32_t bottomY = sectionIndex * ChunkSection::Size;
+        const ChunkSection::State state = snapshot.getSectionState(sectionIndex);
+        if (state != ChunkSection::State::mixed) {
+            const bool isSolid = state == ChunkSection::State::uniform &&
+                                 registry.getClass(snapshot.get(ChunkSnapshot::getIndex(0, bottomY, 0))) ==
+                                     BlockData::BlockClass::solid;
+            meshData.sectionConnectivity[sectionIndex] = SectionConnectivity(
+                isSolid ? SectionConnectivity::NoneConnected : SectionConnectivity::AllConnected);
+            continue;
         }
+        
+        solid.fill(0);
+        for (int32_t y = 0; y < ChunkSection::Size; ++y) {
+            const int32_t rowStart = ChunkSnapshot::getIndex(0, bottomY + y, 0);
+            for (int32_t z = 0; z < ChunkSection::Size; ++z) {
+                for (int32_t x = 0; x < ChunkSection::Size; ++x) {
+                    const BlockData::BlockType type = snapshot.get(rowStart + x + z * ChunkSnapshot::HorizontalSize);
+                    if (registry.getClass(type) == BlockData::BlockClass::solid) {
+                        solid[x + z * ChunkSection::Size] |= 1u << y;
+                    }
+                }
+            }
+        }
+        meshData.sectionConnectivity[sectionIndex] = SectionConnectivity::compute(solid);
     }
 }
 
-int32_t ChunkMeshBuilder::estimateVertexCount(const Chunk& chunk) {
+int32_t ChunkMeshBuilder::estimateVertexCount(const ChunkSnapshot& snapshot) {
     // Simple estimation: count non-air blocks and multiply by average faces
+    // Sections keep their non-air count up to date, so no block needs to be visited
     int32_t nonAirBlocks = 0;
-    
-    // Use same iteration order as buildMesh for cache efficiency
-    for (int32_t x = 0; x < Chunk::HorizontalSize; ++x) {
-        for (int32_t y = 0; y < Chunk::VerticalSize; ++y) {
-            for (int32_t z = 0; z < Chunk::HorizontalSize; ++z) {
-                const BlockData* block = chunk.getBlockAt({x, y, z});
-                if (block && block->blockClass != BlockData::BlockClass::air) {
-                    nonAirBlocks++;
-                }
-            }
+    for (int32_t sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex) {
+        if (snapshot.getSectionState(sectionIndex) == ChunkSection::State::uniform) {
+            // Only the shell of a uniform section can be visible
+            constexpr int32_t inner = ChunkSection::Size - 2;
+            nonAirBlocks += ChunkSection::BlockCount - inner * inner * inner;
+        } else {
+            nonAirBlocks += snapshot.getSectionNonAirCount(sectionIndex);
         }
     }
     
     // Assume average of 3 visible faces per block, 4 vertices per face
     return nonAirBlocks * 3 * 4;
-}
\ No newline at end of file
+}
@@ -3,49 +3,165 @@
  * @brief Thread-safe mesh building for chunks
  * 
  * @details Separates mesh generation logic from the Chunk class to enable
- *          multithreaded mesh building. The builder can work on chunk data
- *          without modifying the chunk itself.
+ *          multithreaded mesh building. The builder only reads a ChunkSnapshot,
+ *          never the live chunks of the world.
  */
 
 #pragma once
 
 #include "../Common.hpp"
 #include "../Rendering/BlockVertex.hpp"
+#include "../Rendering/FaceRecord.hpp"
 #include "BlockTypes.hpp"
 #include "LODLevel.hpp"
+#include "SectionConnectivity.hpp"
+#include <array>
 #include <vector>
 
-class Chunk;
-class World;
-class Assets;
+class ChunkSnapshot;
+
+/**
+ * @brief How the faces of a chunk mesh are sent to the GPU
+ */
+enum class ChunkMeshFormat : uint8_t {
+    vertices,     // 6 BlockVertex per face, read as vertex attributes
+    faceRecords   // 1 FaceRecord per face, expanded by the vertex shader
+};
+
+/**
+ * @brief Range of a chunk mesh buffer holding one section for one render pass, in vertices or
+ *        face records depending on the mesh format
+ */
+struct ChunkMeshSlot {
+    int32_t first = 0;
+    int32_t capacity = 0;
+    int32_t size = 0;
+    
+    /**
+     * @brief Elements of each face direction: the faces of a slot are grouped by direction in
+     *        BlockMesh face order, so the directions facing away from the camera can be skipped
+     */
+    std::array<int32_t, 6> faceSizes{};
+};
 
 /**
  * @brief Data structure containing the result of mesh building
  * 
- * @details This structure can be passed between threads safely
+ * @details This structure can be passed between threads safely.
+ *          The builder lays the mesh out exactly as it is uploaded: for each section from top
+ *          to bottom, its solid slot then its semi-transparent slot, each with spare room so
+ *          that later edits of the section can be written in place. The main thread hands the
+ *          vertex or face record vector to the GPU without copying it. Partial meshes (see
+ *          sectionMask) have no spare room, their slots only locate the data of each section.
+ *          The counts are always in vertices, 6 per face record, since that is what the draw
+ *          calls take.
  */
 struct ChunkMeshData {
+    /**
+     * @brief Sections of a chunk (Chunk::SectionCount, checked in Chunk.hpp), one bit each in
+     *        section masks
+     */
+    static constexpr int32_t SectionCount = 16;
+    static constexpr uint16_t AllSections = 0xFFFF;
+    
+    /**
+     * @brief Spare room of the slots of a section with faces, as a number of faces added to a
+     *        quarter of their size, so that most edits fit in place
+     */
+    static constexpr int32_t SlotSpareFaces = 8;
+    
+    ChunkMeshFormat format = ChunkMeshFormat::vertices;
+    
+    /**
+     * @brief Sections the mesh was built for, the others are left out
+     */
+    uint16_t sectionMask = AllSections;
+    
+    /**
+     * @brief Faces of the section being emitted, per render pass, moved to the upload layout
+     *        once the section is done
+     */
     std::vector<BlockVertex> solidVertices;
     std::vector<BlockVertex> semiTransparentVertices;
+    std::vector<FaceRecord> solidFaces;
+    std::vector<FaceRecord> semiTransparentFaces;
+    
+    /**
+     * @brief Size of the per-pass vectors of the section being emitted once each face direction
+     *        is done, to split the slots of the section by direction
+     */
+    std::array<int32_t, 6> solidFaceEnds{};
+    std::array<int32_t, 6> semiTransparentFaceEnds{};
+    
+    /**
+     * @brief Upload layout, in the vector matching the format
+     */
+    std::vector<BlockVertex> vertices;
+    std::vector<FaceRecord> faces;
+    std::array<ChunkMeshSlot, SectionCount> solidSlots{};
+    std::array<ChunkMeshSlot, SectionCount> semiTransparentSlots{};
+    
     int32_t solidVertexCount = 0;
     int32_t semiTransparentVertexCount = 0;
     
     /**
-     * @brief Clear all data
+     * @brief Which faces of each section of sectionMask see each other, at every LOD, for the
+     *        visibility walk of World::findVisibleSections
+     */
+    std::array<SectionConnectivity, SectionCount> sectionConnectivity{};
+    
+    /**
+     * @brief Vertices the upload layout is expected to hold, from the previous mesh of the
+     *        chunk, or 0 to estimate it from the snapshot. An input of the builder, kept by clear().
+     */
+    int32_t sizeHint = 0;
+    
+    /**
+     * @brief Clear all data, the capacity of the vectors is kept for the next build
      */
     void clear() {
         solidVertices.clear();
         semiTransparentVertices.clear();
+        solidFaces.clear();
+        semiTransparentFaces.clear();
+        solidFaceEnds.fill(0);
+        semiTransparentFaceEnds.fill(0);
+        vertices.clear();
+        faces.clear();
+        solidSlots.fill({});
+        semiTransparentSlots.fill({});
         solidVertexCount = 0;
         semiTransparentVertexCount = 0;
+        sectionConnectivity.fill({});
     }
     
     /**
-     * @brief Reserve capacity for vertices
+     * @brief Reserve capacity for vertices, or for the matching number of faces
      */
     void reserve(size_t capacity) {
-        solidVertices.reserve(capacity);
-        semiTransparentVertices.reserve(capacity);
+        if (format == ChunkMeshFormat::faceRecords) {
+            faces.reserve(capacity / FaceRecord::VerticesPerFace);
+        } else {
+            vertices.reserve(capacity);
+        }
+    }
+    
+    /**
+     * @brief Capacity of each vector, a build that changes one of them allocated memory
+     */
+    [[nodiscard]] std::array<size_t, 6> getCapacities() const {
+        return {solidVertices.capacity(), semiTransparentVertices.capacity(), solidFaces.capacity(),
+                semiTransparentFaces.capacity(), vertices.capacity(), faces.capacity()};
+    }
+    
+    /**
+     * @brief Size of the mesh once uploaded, spare room included, in bytes
+     */
+    [[nodiscard]] size_t getByteSize() const {
+        if (format == ChunkMeshFormat::faceRecords) {
+            return faces.size() * sizeof(FaceRecord);
+        }
+        return vertices.size() * sizeof(BlockVertex);
     }
 };
 
@@ -54,64 +170,92 @@ struct ChunkMeshData {
  * @brief Builds mesh data for chunks in a thread-safe manner
  * 
  * @details This class extracts the mesh building logic from Chunk to allow
- *          for parallel mesh generation. It reads chunk data but doesn't
- *          modify the chunk state.
+ *          for parallel mesh generation. Its input is a snapshot taken on the
+ *          main thread, so it has nothing to synchronize with.
  */
 class ChunkMeshBuilder {
 private:
     /**
-     * @brief Checks if a block at the given position is not air
-     * 
-     * @param pos Position to check (can be outside chunk bounds)
-     * @param chunk The chunk containing the block
-     * @param world World reference for checking adjacent chunks
-     * @return true if the block exists and is not air, false otherwise
+     * @brief Whether the face of a block towards a neighbor must be drawn
      */
-    static bool hasNonAirAt(const glm::ivec3& pos, const Chunk& chunk, const World& world);
+    static bool isFaceVisible(BlockData::BlockClass blockClass, BlockData::BlockType neighborType);
     
     /**
-     * @brief Calculates ambient occlusion level for a vertex
+     * @brief buildMesh for the reduced LODs
      * 
-     * @param blockPos Position of the block
-     * @param vertOffset Offset of the vertex from the block position
-     * @param chunk The chunk containing the block
-     * @param world World reference for checking adjacent chunks
-     * @param useAmbientOcclusion Whether to calculate AO or return default
-     * @return Occlusion level from 0 (fully occluded) to 3 (no occlusion)
-     */
-    static uint8_t calculateOcclusionLevel(const glm::ivec3& blockPos,
-                                          const glm::ivec3& vertOffset,
-                                          const Chunk& chunk,
-                                          const World& world,
-                                          bool useAmbientOcclusion);
+     * @details The chunk is downsampled into cells of LODSelector::getCellSize blocks along each
+     *          axis, each cell becoming a single block (see downsampleBox in the source file),
+     *          and every visible cell face is emitted as one quad covering the whole cell side.
+     *          Unlike skipping blocks, this leaves no holes in the terrain. No ambient occlusion.
+     */
+    static void buildReducedMesh(const ChunkSnapshot& snapshot,
+                                 LODLevel lod,
+                                 ChunkMeshData& outMeshData);
+    
+    /**
+     * @brief Sets the vertex counts from the emitted vertices or face records
+     */
+    static void updateVertexCounts(ChunkMeshData& meshData);
+    
+    /**
+     * @brief Moves the faces emitted for a section into its slots of the upload layout
+     */
+    static void finishSection(ChunkMeshData& meshData, int32_t sectionIndex);
+    
+    /**
+     * @brief Fills the section connectivity of the sections of the mesh from the snapshot, at
+     *        block resolution whatever the LOD
+     */
+    static void computeConnectivity(const ChunkSnapshot& snapshot, ChunkMeshData& meshData);
+    
+    /**
+     * @brief Gives the upload layout of a full mesh at least one element, so that the chunk
+     *        always has a valid buffer to bind
+     */
+    static void finishMesh(ChunkMeshData& meshData);
 
 public:
     /**
      * @brief Build mesh data for a chunk
      * 
-     * @details This method is thread-safe and doesn't modify the chunk.
+     * @details This method is thread-safe and only reads the snapshot.
      *          It generates vertex data that can be uploaded to the GPU later.
      * 
-     * @param chunk The chunk to build mesh for
-     * @param world The world containing the chunk
-     * @param assets Assets for texture lookups
+     *          At full LOD the faces are culled with bitmasks: each section is turned into
+     *          18-bit column masks (the 16 blocks plus the blocks below and above) per block
+     *          class, the visible faces of a whole column towards each direction come out of a
+     *          few shifts and ANDs with the neighbor column, and vertices are only emitted for
+     *          the set bits. Ambient occlusion reads the same masks.
+     * 
+     *          With greedy meshing, visible faces are collected per 16x16 plane of each section,
+     *          then adjacent faces sharing the same texture layer, render pass and ambient
+     *          occlusion are merged into rectangles. Faces whose corners have different
+     *          occlusion levels are kept as they are, so the result looks exactly like the
+     *          per-face mesh.
+     * 
+     * @param snapshot Snapshot of the chunk to build mesh for
      * @param useAmbientOcclusion Whether to calculate ambient occlusion
      * @param outMeshData Output mesh data
+     * @param useGreedyMeshing Merge coplanar faces into larger quads (full LOD only)
+     * @param format Emit BlockVertex or FaceRecord data
+     * @param sectionMask Sections to mesh, to update only the sections touched by an edit
+     *                    (full LOD only)
      * 
      * @note This method can be called from any thread
      */
-    static void buildMesh(const Chunk& chunk, 
-                         const World& world,
-                         const Assets& assets,
+    static void buildMesh(const ChunkSnapshot& snapshot,
                          bool useAmbientOcclusion,
                          ChunkMeshData& outMeshData,
-                         LODLevel lod = LODLevel::Full);
+                         LODLevel lod = LODLevel::Full,
+                         bool useGreedyMeshing = false,
+                         ChunkMeshFormat format = ChunkMeshFormat::vertices,
+                         uint16_t sectionMask = ChunkMeshData::AllSections);
     
     /**
      * @brief Estimate the number of vertices a chunk might need
      * 
-     * @param chunk The chunk to estimate for
+     * @param snapshot Snapshot of the chunk to estimate for
      * @return Estimated vertex count
      */
-    static int32_t estimateVertexCount(const Chunk& chunk);
+    static int32_t estimateVertexCount(const ChunkSnapshot& snapshot);
 };
\ No newline at end of file
@@ -9,9 +9,10 @@
 #pragma once
 
 #include "../Common.hpp"
-#include "ChunkMeshBuilder.hpp"
+#include "ChunkMeshBufferPool.hpp"
 #include "LODLevel.hpp"
 #include <atomic>
+#include <chrono>
 #include <memory>
 
 /**
@@ -21,7 +22,8 @@ enum class MeshTaskStatus {
     Pending,    // Task created but not started
     Building,   // Task is being processed
     Complete,   // Task completed successfully
-    Failed      // Task failed
+    Failed,     // Task failed
+    Cancelled   // Task dropped before it started
 };
 
 /**
@@ -29,14 +31,24 @@ enum class MeshTaskStatus {
  * @brief Represents a mesh building task that can be processed asynchronously
  * 
  * @details This class encapsulates all data needed to build a chunk mesh
- *          on a worker thread. It includes the input data (chunk position)
- *          and output data (mesh vertices).
+ *          on a worker thread. It includes the input data (a snapshot of the
+ *          chunk and its border, taken at submission) and output data (mesh
+ *          vertices). Both come from a ChunkMeshBufferPool and go back to it
+ *          when the task is destroyed.
  */
 class ChunkMeshTask {
 private:
     glm::ivec2 chunkPosition;
     std::atomic<MeshTaskStatus> status{MeshTaskStatus::Pending};
-    ChunkMeshData meshData;
+    ChunkMeshBufferPool& bufferPool;
+    std::unique_ptr<ChunkMeshBuffers> buffers;
+    uint32_t contentVersion = 0;
+    bool useAmbientOcclusion = true;
+    bool useGreedyMeshing = false;
+    ChunkMeshFormat meshFormat = ChunkMeshFormat::vertices;
+    uint16_t sectionMask = ChunkMeshData::AllSections;
+    bool urgent = false;
+    std::chrono::steady_clock::time_point submitTime = std::chrono::steady_clock::now();
     LODLevel lodLevel;
     
     // Optional error message if task failed
@@ -48,15 +60,60 @@ public:
      * 
      * @param position The chunk position
      * @param lod The LOD level for this task
+     * @param pool Pool the snapshot and mesh buffers are taken from
      */
-    explicit ChunkMeshTask(const glm::ivec2& position, LODLevel lod = LODLevel::Full) 
-        : chunkPosition(position), lodLevel(lod) {}
+    ChunkMeshTask(const glm::ivec2& position, LODLevel lod, ChunkMeshBufferPool& pool)
+        : chunkPosition(position), bufferPool(pool), buffers(pool.acquire()), lodLevel(lod) {}
+    
+    ~ChunkMeshTask() { bufferPool.release(std::move(buffers)); }
+    
+    ChunkMeshTask(const ChunkMeshTask&) = delete;
+    ChunkMeshTask& operator=(const ChunkMeshTask&) = delete;
     
     /**
      * @brief Get the chunk position
      */
     [[nodiscard]] glm::ivec2 getChunkPosition() const { return chunkPosition; }
     
+    /**
+     * @brief Input of the mesh builder, filled on the main thread before the task is queued
+     */
+    [[nodiscard]] const ChunkSnapshot& getSnapshot() const { return buffers->snapshot; }
+    [[nodiscard]] ChunkSnapshot& getSnapshot() { return buffers->snapshot; }
+
+    /**
+     * @brief Chunk content version the snapshot was taken at
+     */
+    [[nodiscard]] uint32_t getContentVersion() const { return contentVersion; }
+    void setContentVersion(uint32_t version) { contentVersion = version; }
+
+    [[nodiscard]] bool getUseAmbientOcclusion() const { return useAmbientOcclusion; }
+    void setUseAmbientOcclusion(bool enabled) { useAmbientOcclusion = enabled; }
+    
+    [[nodiscard]] bool getUseGreedyMeshing() const { return useGreedyMeshing; }
+    void setUseGreedyMeshing(bool enabled) { useGreedyMeshing = enabled; }
+    
+    [[nodiscard]] ChunkMeshFormat getMeshFormat() const { return meshFormat; }
+    void setMeshFormat(ChunkMeshFormat format) { meshFormat = format; }
+    
+    /**
+     * @brief Sections to mesh, all of them unless the task updates the sections touched by edits
+     */
+    [[nodiscard]] uint16_t getSectionMask() const { return sectionMask; }
+    void setSectionMask(uint16_t mask) { sectionMask = mask; }
+    [[nodiscard]] bool isPartial() const { return sectionMask != ChunkMeshData::AllSections; }
+    
+    /**
+     * @brief Urgent tasks make a player edit visible and are scheduled before any other
+     */
+    [[nodiscard]] bool isUrgent() const { return urgent; }
+    void setUrgent(bool isUrgent) { urgent = isUrgent; }
+    
+    /**
+     * @brief When the task was created, to measure how long a change takes to become visible
+     */
+    [[nodiscard]] std::chrono::steady_clock::time_point getSubmitTime() const { return submitTime; }
+    
     /**
      * @brief Get the current status
      */
@@ -70,8 +127,8 @@ public:
     /**
      * @brief Get the mesh data (only valid if status is Complete)
      */
-    [[nodiscard]] const ChunkMeshData& getMeshData() const { return meshData; }
-    [[nodiscard]] ChunkMeshData& getMeshData() { return meshData; }
+    [[nodiscard]] const ChunkMeshData& getMeshData() const { return buffers->meshData; }
+    [[nodiscard]] ChunkMeshData& getMeshData() { return buffers->meshData; }
     
     /**
      * @brief Set error message (for Failed status)
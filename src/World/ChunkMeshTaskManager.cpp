@@ -1,13 +1,15 @@
 #include "ChunkMeshTaskManager.hpp"
 #include "Chunk.hpp"
 #include "ChunkMeshBuilder.hpp"
+#include "ChunkTable.hpp"
 #include "World.hpp"
-#include "../Core/Assets.hpp"
+#include "../Core/PerformanceMonitor.hpp"
+#include <algorithm>
 #include <thread>
 #include <iostream>
 
-ChunkMeshTaskManager::ChunkMeshTaskManager(const World& world, const Assets& assets) 
-    : world(world), assets(assets) {
+ChunkMeshTaskManager::ChunkMeshTaskManager(const World& world, const ChunkTable& chunkTable) 
+    : world(world), chunkTable(chunkTable) {
     // Create thread pool with N-1 threads (leaving one core for the main thread)
     unsigned int numCores = std::thread::hardware_concurrency();
     unsigned int numThreads = std::max(1u, numCores > 1 ? numCores - 1 : 1);
@@ -18,47 +20,212 @@ ChunkMeshTaskManager::ChunkMeshTaskManager(const World& world, const Assets& ass
 }
 
 ChunkMeshTaskManager::~ChunkMeshTaskManager() {
+    // Drop the tasks that have not started, their jobs find nothing left to build
+    {
+        std::lock_guard<std::mutex> pendingLock(pendingMutex);
+        std::lock_guard<std::mutex> activeLock(activeMutex);
+        for (const PendingTask& pending : pendingTasks) {
+            activeTasks.erase(pending.handle);
+        }
+        pendingTasks.clear();
+    }
+    
     // Wait for all active tasks to complete
     while (getActiveTaskCount() > 0) {
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
+
+    // The jobs of cancelled tasks are still queued and the pool runs them before its workers
+    // exit: stop it while the pending heap and the mutexes they lock are still alive
+    threadPool.reset();
 }
 
-void ChunkMeshTaskManager::submitChunk(Chunk* chunk) {
-    if (!chunk || !chunk->needsMeshRebuild()) {
+void ChunkMeshTaskManager::submitChunk(Chunk* chunk, LODLevel lod, bool urgent) {
+    if (!chunk || !chunk->needsMeshRebuild(lod)) {
         return;
     }
     
-    // Check if chunk is already being processed
-    if (isChunkProcessing(chunk)) {
-        return;
+    const ChunkHandle handle = chunk->getHandle();
+    std::shared_ptr<ChunkMeshTask> activeTask;
+    {
+        std::lock_guard<std::mutex> lock(activeMutex);
+        if (auto it = activeTasks.find(handle); it != activeTasks.end()) {
+            activeTask = it->second;
+        }
     }
     
-    // Create a new task - always use Full LOD for now
-    // TODO: Implement proper LOD strategy
-    auto task = std::make_shared<ChunkMeshTask>(chunk->getPosition(), LODLevel::Full);
+    if (activeTask) {
+        // A task still waiting with the right level and data is kept, one that is already
+        // running finishes and is dropped on completion if the chunk changed meanwhile
+        const bool upToDate = activeTask->getContentVersion() == chunk->getContentVersion() &&
+                              activeTask->getLODLevel() == lod;
+        if (upToDate) {
+            if (urgent && !activeTask->isUrgent()) {
+                activeTask->setUrgent(true);
+                std::lock_guard<std::mutex> lock(pendingMutex);
+                for (PendingTask& pending : pendingTasks) {
+                    if (pending.task == activeTask) {
+                        pending.priority = computePriority(*chunk, *activeTask);
+                    }
+                }
+                std::make_heap(pendingTasks.begin(), pendingTasks.end());
+            }
+            return;
+        }
+        if (!cancelPendingTask(handle, activeTask)) {
+            return;
+        }
+        
+        // The replaced task took the dirty sections of the chunk, the new one takes them over
+        if (activeTask->getLODLevel() == LODLevel::Full) {
+            chunk->restoreDirtySections(activeTask->getSectionMask());
+        }
+        urgent = urgent || activeTask->isUrgent();
+    }
+    
+    auto task = std::make_shared<ChunkMeshTask>(chunk->getPosition(), lod, bufferPool);
+    {
+        PERF_TIMER("ChunkMeshTaskManager::captureSnapshot");
+        task->getSnapshot().capture(*chunk, world);
+    }
+    task->setUseAmbientOcclusion(world.getUseAmbientOcclusion());
+    task->setUseGreedyMeshing(world.getUseGreedyMeshing());
+    task->setMeshFormat(world.getMeshFormat());
+    task->setContentVersion(chunk->getContentVersion());
+    if (lod == LODLevel::Full) {
+        // After an edit only the touched sections are remeshed and patched into the chunk buffer
+        task->setSectionMask(chunk->takeDirtySections());
+    }
+    task->setUrgent(urgent || task->isPartial());
+    
+    // The buffers are sized from the previous mesh of the chunk, partial meshes only hold a few
+    // sections of it
+    task->getMeshData().sizeHint = task->isPartial() ? 0 : chunk->getMeshVertexCapacity(lod);
     
     // Add to active tasks
     {
         std::lock_guard<std::mutex> lock(activeMutex);
-        activeTasks[chunk] = task;
+        activeTasks[handle] = task;
     }
     
-    // Submit to thread pool
-    threadPool->enqueue([this, chunk, task]() {
-        processMeshTask(chunk, task);
+    // Queue it by priority, the job only picks the best pending task when a worker is free
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pendingTasks.push_back({computePriority(*chunk, *task), handle, task});
+        std::push_heap(pendingTasks.begin(), pendingTasks.end());
+    }
+    threadPool->enqueue([this]() {
+        runNextTask();
     });
 }
 
-void ChunkMeshTaskManager::processMeshTask(Chunk* chunk, std::shared_ptr<ChunkMeshTask> task) {
+void ChunkMeshTaskManager::updatePriorities(const glm::vec2& playerXZ, const Frustum& frustum) {
+    PERF_TIMER("ChunkMeshTaskManager::updatePriorities");
+    viewPosition = playerXZ;
+    viewFrustum = frustum;
+    hasView = true;
+    
+    std::vector<PendingTask> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        for (PendingTask& pending : pendingTasks) {
+            const Chunk* chunk = chunkTable.get(pending.handle);
+            if (chunk) {
+                pending.priority = computePriority(*chunk, *pending.task);
+            } else {
+                cancelled.push_back(pending);
+            }
+        }
+        
+        // Tasks of unloaded chunks are dropped before they waste a worker
+        if (!cancelled.empty()) {
+            std::erase_if(pendingTasks, [this](const PendingTask& pending) {
+                return chunkTable.get(pending.handle) == nullptr;
+            });
+        }
+        std::make_heap(pendingTasks.begin(), pendingTasks.end());
+    }
+    
+    if (!cancelled.empty()) {
+        std::lock_guard<std::mutex> lock(activeMutex);
+        for (const PendingTask& pending : cancelled) {
+            pending.task->setStatus(MeshTaskStatus::Cancelled);
+            if (auto it = activeTasks.find(pending.handle); it != activeTasks.end() && it->second == pending.task) {
+                activeTasks.erase(it);
+            }
+        }
+        cancelledTasks += cancelled.size();
+    }
+}
+
+float ChunkMeshTaskManager::computePriority(const Chunk& chunk, const ChunkMeshTask& task) const {
+    // Groups are far enough apart for the distance, in blocks, never to mix them
+    constexpr float GroupSpacing = 1.0e6f;
+    if (task.isUrgent()) {
+        return chunk.distanceToPoint(viewPosition);
+    }
+    const bool visible = !hasView || chunk.isVisible(viewFrustum);
+    return (visible ? 1.0f : 2.0f) * GroupSpacing + chunk.distanceToPoint(viewPosition);
+}
+
+bool ChunkMeshTaskManager::cancelPendingTask(ChunkHandle handle, const std::shared_ptr<ChunkMeshTask>& task) {
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        auto it = std::find_if(pendingTasks.begin(), pendingTasks.end(),
+                               [&task](const PendingTask& pending) { return pending.task == task; });
+        if (it == pendingTasks.end()) {
+            return false;
+        }
+        pendingTasks.erase(it);
+        std::make_heap(pendingTasks.begin(), pendingTasks.end());
+    }
+    
+    task->setStatus(MeshTaskStatus::Cancelled);
+    {
+        std::lock_guard<std::mutex> lock(activeMutex);
+        if (auto it = activeTasks.find(handle); it != activeTasks.end() && it->second == task) {
+            activeTasks.erase(it);
+        }
+    }
+    cancelledTasks++;
+    return true;
+}
+
+void ChunkMeshTaskManager::runNextTask() {
+    PendingTask next;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        // Cancelled tasks leave their job behind, it has nothing to do
+        if (pendingTasks.empty()) {
+            return;
+        }
+        std::pop_heap(pendingTasks.begin(), pendingTasks.end());
+        next = std::move(pendingTasks.back());
+        pendingTasks.pop_back();
+    }
+    
+    processMeshTask(next.handle, std::move(next.task));
+}
+
+void ChunkMeshTaskManager::processMeshTask(ChunkHandle handle, std::shared_ptr<ChunkMeshTask> task) {
     // Set task status to processing
     task->setStatus(MeshTaskStatus::Building);
     
     try {
-        // Build the mesh using ChunkMeshBuilder
-        // Get ambient occlusion setting from world (thread-safe getter)
-        bool useAmbientOcclusion = world.getUseAmbientOcclusion();
-        ChunkMeshBuilder::buildMesh(*chunk, world, assets, useAmbientOcclusion, task->getMeshData(), task->getLODLevel());
+        // Build the mesh from the snapshot, the chunk itself is never read here
+        const auto capacities = task->getMeshData().getCapacities();
+        ChunkMeshBuilder::buildMesh(task->getSnapshot(), task->getUseAmbientOcclusion(),
+                                    task->getMeshData(), task->getLODLevel(),
+                                    task->getUseGreedyMeshing(), task->getMeshFormat(),
+                                    task->getSectionMask());
+        
+        // Recycled buffers stop growing once they fit the largest chunks
+        const auto newCapacities = task->getMeshData().getCapacities();
+        for (size_t i = 0; i < capacities.size(); ++i) {
+            if (newCapacities[i] != capacities[i]) {
+                grownBuffers++;
+            }
+        }
         
         // Mark as completed
         task->setStatus(MeshTaskStatus::Complete);
@@ -66,7 +233,7 @@ void ChunkMeshTaskManager::processMeshTask(Chunk* chunk, std::shared_ptr<ChunkMe
         // Add to completed queue
         {
             std::lock_guard<std::mutex> lock(completedMutex);
-            completedTasks.push({chunk, task});
+            completedTasks.push({handle, task});
         }
         
         totalProcessed++;
@@ -79,12 +246,14 @@ void ChunkMeshTaskManager::processMeshTask(Chunk* chunk, std::shared_ptr<ChunkMe
     // Remove from active tasks
     {
         std::lock_guard<std::mutex> lock(activeMutex);
-        activeTasks.erase(chunk);
+        if (auto it = activeTasks.find(handle); it != activeTasks.end() && it->second == task) {
+            activeTasks.erase(it);
+        }
     }
 }
 
 void ChunkMeshTaskManager::processCompletedTasks() {
-    std::queue<std::pair<Chunk*, std::shared_ptr<ChunkMeshTask>>> tasksToProcess;
+    std::queue<std::pair<ChunkHandle, std::shared_ptr<ChunkMeshTask>>> tasksToProcess;
     
     // Quickly swap the completed queue to minimize lock time
     {
@@ -94,19 +263,65 @@ void ChunkMeshTaskManager::processCompletedTasks() {
     
     // Process all completed tasks
     while (!tasksToProcess.empty()) {
-        auto [chunk, task] = tasksToProcess.front();
+        auto [handle, task] = tasksToProcess.front();
         tasksToProcess.pop();
         
-        if (task->isComplete()) {
-            // Apply the mesh data to the chunk (must be done on main thread for OpenGL)
-            chunk->applyMeshData(task->getMeshData(), task->getLODLevel());
+        if (!task->isComplete()) {
+            continue;
+        }
+        
+        // The chunk was unloaded while the mesh was built, its handle no longer resolves
+        Chunk* chunk = chunkTable.get(handle);
+        if (!chunk) {
+            wastedBuilds++;
+            continue;
         }
+        
+        if (task->getContentVersion() != chunk->getContentVersion()) {
+            // The chunk changed while the mesh was built: applying it would mark the chunk
+            // ready with pre-edit geometry, so build it again from fresh data instead. If the
+            // worker has not unregistered the task yet, the chunk stays dirty and the regular
+            // per-frame submission picks it up.
+            wastedBuilds++;
+            if (task->getLODLevel() == LODLevel::Full) {
+                chunk->restoreDirtySections(task->getSectionMask());
+            }
+            submitChunk(chunk, task->getLODLevel());
+            continue;
+        }
+        
+        // Apply the mesh data to the chunk (must be done on main thread for OpenGL)
+        const ChunkMeshData& meshData = task->getMeshData();
+        if (!chunk->applyMeshData(meshData, task->getLODLevel(), world.getMeshBuffer(meshData.format))) {
+            // The edited sections outgrew their slots, the whole chunk buffer is laid out again
+            sectionFallbacks++;
+            chunk->restoreDirtySections(ChunkMeshData::AllSections);
+            submitChunk(chunk, LODLevel::Full);
+            continue;
+        }
+        
+        if (task->isPartial()) {
+            const std::chrono::duration<float, std::milli> latency =
+                std::chrono::steady_clock::now() - task->getSubmitTime();
+            PerformanceMonitor::getInstance().recordTime("Section Remesh Latency", latency.count());
+        }
+    }
+    
+    const auto now = std::chrono::steady_clock::now();
+    const std::chrono::duration<float> window = now - allocationWindowStart;
+    if (window.count() >= 1.0f) {
+        const size_t allocations = getBufferAllocationCount();
+        PerformanceMonitor::getInstance().recordCount(
+            "Mesh Buffer Allocations per Second",
+            static_cast<int32_t>((allocations - allocationWindowCount) / window.count()));
+        allocationWindowStart = now;
+        allocationWindowCount = allocations;
     }
 }
 
 size_t ChunkMeshTaskManager::getPendingTaskCount() const {
     std::lock_guard<std::mutex> lock(pendingMutex);
-    return pendingChunks.size();
+    return pendingTasks.size();
 }
 
 size_t ChunkMeshTaskManager::getActiveTaskCount() const {
@@ -121,5 +336,5 @@ size_t ChunkMeshTaskManager::getCompletedTaskCount() const {
 
 bool ChunkMeshTaskManager::isChunkProcessing(const Chunk* chunk) const {
     std::lock_guard<std::mutex> lock(activeMutex);
-    return activeTasks.find(chunk) != activeTasks.end();
+    return activeTasks.find(chunk->getHandle()) != activeTasks.end();
 }
\ No newline at end of file
@@ -1,26 +1,36 @@
 #pragma once
 
+#include "ChunkHandle.hpp"
+#include "ChunkMeshBufferPool.hpp"
 #include "ChunkMeshTask.hpp"
 #include "../Utils/ThreadPool.hpp"
+#include <Frustum.h>
 #include <queue>
 #include <mutex>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 class Chunk;
+class ChunkTable;
 class World;
-class Assets;
 
 class ChunkMeshTaskManager {
 public:
     // Constructor: creates thread pool with optimal thread count
-    ChunkMeshTaskManager(const World& world, const Assets& assets);
+    ChunkMeshTaskManager(const World& world, const ChunkTable& chunkTable);
     
-    // Destructor: ensures all tasks are completed
+    // Destructor: drops the pending tasks and waits for the running ones
     ~ChunkMeshTaskManager();
     
-    // Submit a chunk for mesh rebuilding
-    void submitChunk(Chunk* chunk);
+    // Submit a chunk for mesh rebuilding at a LOD level (main thread only: snapshots the chunk
+    // and its neighbors). A chunk has at most one task in flight, whatever its level. Urgent
+    // tasks (player edits) are built before any other work.
+    void submitChunk(Chunk* chunk, LODLevel lod = LODLevel::Full, bool urgent = false);
+    
+    // Re-prioritizes the pending tasks for the current camera and cancels the tasks of chunks
+    // that were unloaded (main thread, once per frame)
+    void updatePriorities(const glm::vec2& playerXZ, const Frustum& frustum);
     
     // Process completed tasks (must be called from main thread)
     void processCompletedTasks();
@@ -30,32 +40,88 @@ public:
     size_t getActiveTaskCount() const;
     size_t getCompletedTaskCount() const;
     
+    // Number of builds whose result was dropped because the chunk changed or was unloaded meanwhile
+    size_t getWastedBuildCount() const { return wastedBuilds.load(); }
+    
+    // Number of pending tasks cancelled before they started
+    size_t getCancelledTaskCount() const { return cancelledTasks; }
+    
+    // Number of section updates that outgrew their slots and fell back to a full chunk build
+    size_t getSectionFallbackCount() const { return sectionFallbacks; }
+    
+    // Heap allocations of mesh task buffers: buffers the pool had to create, plus vectors a
+    // build had to grow
+    size_t getBufferAllocationCount() const { return bufferPool.getMissCount() + grownBuffers.load(); }
+    
+    // Buffers of finished tasks, reused by the next ones
+    const ChunkMeshBufferPool& getBufferPool() const { return bufferPool; }
+    
     // Check if a chunk is currently being processed
     bool isChunkProcessing(const Chunk* chunk) const;
 
 private:
-    // References to world and assets (for mesh building)
+    // Pending task with its scheduling priority, the lowest value is built first
+    struct PendingTask {
+        float priority;
+        ChunkHandle handle;
+        std::shared_ptr<ChunkMeshTask> task;
+        
+        bool operator<(const PendingTask& other) const { return priority > other.priority; }
+    };
+    
+    // World the snapshots are taken from
     const World& world;
-    const Assets& assets;
+    
+    // Resolves task handles back to chunks, nullptr once a chunk has been unloaded
+    const ChunkTable& chunkTable;
+    
+    // Snapshot and mesh buffers of the tasks, declared before anything holding tasks so that it
+    // outlives them
+    ChunkMeshBufferPool bufferPool;
     
     // Thread pool for mesh generation
     std::unique_ptr<ThreadPool> threadPool;
     
-    // Pending tasks (chunks waiting to be processed)
-    std::queue<Chunk*> pendingChunks;
+    // Pending tasks, a heap ordered by priority. The thread pool runs one job per submitted task
+    // and each job builds whichever task has the best priority when it starts.
+    std::vector<PendingTask> pendingTasks;
     mutable std::mutex pendingMutex;
     
-    // Active tasks (chunks currently being processed)
-    std::unordered_map<const Chunk*, std::shared_ptr<ChunkMeshTask>> activeTasks;
+    // Camera the priorities are computed for, updated once per frame
+    glm::vec2 viewPosition{0.0f};
+    Frustum viewFrustum;
+    bool hasView = false;
+    
+    // Active tasks (pending or being built), one per chunk
+    std::unordered_map<ChunkHandle, std::shared_ptr<ChunkMeshTask>, ChunkHandle::Hash> activeTasks;
     mutable std::mutex activeMutex;
     
     // Completed tasks (ready to be applied)
-    std::queue<std::pair<Chunk*, std::shared_ptr<ChunkMeshTask>>> completedTasks;
+    std::queue<std::pair<ChunkHandle, std::shared_ptr<ChunkMeshTask>>> completedTasks;
     mutable std::mutex completedMutex;
     
     // Statistics
     std::atomic<size_t> totalProcessed{0};
+    std::atomic<size_t> wastedBuilds{0};
+    size_t cancelledTasks = 0;
+    size_t sectionFallbacks = 0;
+    std::atomic<size_t> grownBuffers{0};
+    
+    // Window over which the buffer allocation rate is measured
+    std::chrono::steady_clock::time_point allocationWindowStart = std::chrono::steady_clock::now();
+    size_t allocationWindowCount = 0;
+    
+    // Scheduling priority of a task, lower is sooner: urgent tasks first, then visible chunks,
+    // then hidden ones, each group ordered by distance
+    float computePriority(const Chunk& chunk, const ChunkMeshTask& task) const;
+    
+    // Removes a task that has not started yet from the pending heap and from the active tasks
+    // @return false if the task already started
+    bool cancelPendingTask(ChunkHandle handle, const std::shared_ptr<ChunkMeshTask>& task);
+    
+    // Thread pool job: builds the pending task with the best priority
+    void runNextTask();
     
     // Process a single chunk mesh generation task
-    void processMeshTask(Chunk* chunk, std::shared_ptr<ChunkMeshTask> task);
-};
\ No newline at end of file
+    void processMeshTask(ChunkHandle handle, std::shared_ptr<ChunkMeshTask> task);
+};
@@ -0,0 +1,44 @@
+#include "ChunkPool.hpp"
+
+void ChunkPool::addSlab(size_t chunkCount) {
+	slabs.emplace_back().reserve(chunkCount);
+	capacity += chunkCount;
+}
+
+void ChunkPool::reserve(size_t chunkCount) {
+	if (chunkCount > capacity) {
+		addSlab(chunkCount - capacity);
+	}
+}
+
+Chunk& ChunkPool::acquire(glm::ivec2 position) {
+	TRACE_FUNCTION();
+	usedCount++;
+	highWaterMark = std::max(highWaterMark, usedCount);
+
+	if (!freeChunks.empty()) {
+		Chunk* chunk = freeChunks.back();
+		freeChunks.pop_back();
+		chunk->reset(position);
+		hitCount++;
+		return *chunk;
+	}
+
+	// Constructed chunks are all in use, take the next unused slot of the slabs
+	missCount++;
+	for (auto& slab : slabs) {
+		if (slab.size() < slab.capacity()) {
+			return slab.emplace_back(position);
+		}
+	}
+	addSlab(OverflowSlabSize);
+	return slabs.back().emplace_back(position);
+}
+
+void ChunkPool::release(Chunk& chunk) {
+	assert(!chunk.getHandle().isValid() && "Chunk is still stored in the chunk table");
+	assert(usedCount > 0);
+	chunk.clear();
+	freeChunks.push_back(&chunk);
+	usedCount--;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file ChunkPool.hpp
+ * @brief Slab storage recycling the memory of unloaded chunks
+ *
+ * @details Chunks are constructed in place inside slabs whose capacity is reserved up front from
+ *          the number of slots of the chunk grid, so a chunk never moves and loading a chunk in
+ *          steady state neither allocates nor copies: an unloaded chunk keeps its slot and is
+ *          handed out again after a section-level reset (sections that are already empty are not
+ *          touched). Slabs are only added when more chunks are alive than what was reserved.
+ *
+ * @note Only used from the main thread.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+#include "Chunk.hpp"
+
+class ChunkPool {
+	/**
+	 * @brief Chunks per slab added when the reserved capacity is exceeded
+	 */
+	static constexpr size_t OverflowSlabSize = 16;
+
+	// Each slab is reserved once and never grows past its capacity, so chunk addresses are stable
+	std::vector<std::vector<Chunk>> slabs;
+	std::vector<Chunk*> freeChunks;
+	size_t capacity = 0;
+	size_t usedCount = 0;
+	size_t highWaterMark = 0;
+	size_t hitCount = 0;
+	size_t missCount = 0;
+
+	void addSlab(size_t chunkCount);
+
+   public:
+	/**
+	 * @brief Makes sure storage for at least chunkCount chunks is allocated
+	 */
+	void reserve(size_t chunkCount);
+
+	/**
+	 * @brief Hands out an empty chunk at a position, recycling a released one when possible
+	 */
+	Chunk& acquire(glm::ivec2 position);
+
+	/**
+	 * @brief Gives a chunk back to the pool, its meshes are released immediately
+	 */
+	void release(Chunk& chunk);
+
+	[[nodiscard]] size_t getFreeCount() const { return freeChunks.size(); }
+	[[nodiscard]] size_t getUsedCount() const { return usedCount; }
+	[[nodiscard]] size_t getCapacity() const { return capacity; }
+
+	/**
+	 * @brief Most chunks alive at the same time
+	 */
+	[[nodiscard]] size_t getHighWaterMark() const { return highWaterMark; }
+
+	/**
+	 * @brief Acquisitions served by a recycled chunk / by constructing a new one
+	 */
+	[[nodiscard]] size_t getHitCount() const { return hitCount; }
+	[[nodiscard]] size_t getMissCount() const { return missCount; }
+};
@@ -16,26 +16,21 @@ ChunkRegion::ChunkRegion(const glm::ivec2& regionPos)
       ) {
 }
 
-void ChunkRegion::addChunk(const Ref<Chunk>& chunk) {
-    assert(containsChunk(chunk->getPosition()) && "Chunk does not belong to this region");
+void ChunkRegion::addChunk(const Chunk& chunk) {
+    assert(containsChunk(chunk.getPosition()) && "Chunk does not belong to this region");
+    assert(chunk.getHandle().isValid() && "Chunk is not stored in the chunk table");
     
     // Check if chunk already exists
-    auto it = std::find_if(chunks.begin(), chunks.end(),
-        [&chunk](const Ref<Chunk>& existing) {
-            return existing->getPosition() == chunk->getPosition();
-        });
+    auto it = std::find(chunks.begin(), chunks.end(), chunk.getHandle());
     
     if (it == chunks.end()) {
-        chunks.push_back(chunk);
+        chunks.push_back(chunk.getHandle());
         dirty = true;
     }
 }
 
-bool ChunkRegion::removeChunk(const glm::ivec2& chunkWorldPos) {
-    auto it = std::find_if(chunks.begin(), chunks.end(),
-        [&chunkWorldPos](const Ref<Chunk>& chunk) {
-            return chunk->getPosition() == chunkWorldPos;
-        });
+bool ChunkRegion::removeChunk(ChunkHandle handle) {
+    auto it = std::find(chunks.begin(), chunks.end(), handle);
     
     if (it != chunks.end()) {
         chunks.erase(it);
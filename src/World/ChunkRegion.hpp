@@ -37,7 +37,7 @@ public:
 private:
     glm::ivec2 regionPosition;  // Position in region coordinates
     AABB boundingBox;
-    std::vector<Ref<Chunk>> chunks;
+    std::vector<ChunkHandle> chunks;
     bool dirty = true;
 
     /**
@@ -56,18 +56,18 @@ public:
     /**
      * @brief Adds a chunk to this region
      * 
-     * @param chunk The chunk to add
+     * @param chunk The chunk to add, it must already be stored in the ChunkTable
      * @note The chunk must be within this region's bounds
      */
-    void addChunk(const Ref<Chunk>& chunk);
+    void addChunk(const Chunk& chunk);
 
     /**
      * @brief Removes a chunk from this region
      * 
-     * @param chunkWorldPos World position of the chunk to remove
+     * @param handle Handle of the chunk to remove
      * @return true if chunk was found and removed
      */
-    bool removeChunk(const glm::ivec2& chunkWorldPos);
+    bool removeChunk(ChunkHandle handle);
 
     /**
      * @brief Checks if the region is visible in the frustum
@@ -80,9 +80,9 @@ public:
     }
 
     /**
-     * @brief Gets all chunks in this region
+     * @brief Gets the handles of all chunks in this region (resolved through the ChunkTable)
      */
-    [[nodiscard]] const std::vector<Ref<Chunk>>& getChunks() const { return chunks; }
+    [[nodiscard]] const std::vector<ChunkHandle>& getChunks() const { return chunks; }
 
     /**
      * @brief Checks if the region has any chunks
@@ -0,0 +1,122 @@
+#include "ChunkSection.hpp"
+
+void ChunkSection::set(int32_t x, int32_t y, int32_t z, BlockData::BlockType type) {
+	assert(!isCompressed());
+	const int32_t index = getIndex(x, y, z);
+	const bool wasAir = storage.get(index) == BlockData::BlockType::air;
+	const bool isAir = type == BlockData::BlockType::air;
+
+	if (isAir && !wasAir && nonAirCount == 1) {
+		// Last solid block removed: drop back to a storage-less empty section
+		fill(BlockData::BlockType::air);
+		return;
+	}
+
+	storage.set(index, type);
+	nonAirCount += static_cast<int32_t>(wasAir) - static_cast<int32_t>(isAir);
+	if (nonAirCount == BlockCount && storage.getBitsPerEntry() != 0 && storage.holdsOnly(type)) {
+		// Last other block replaced: drop back to a storage-less uniform section
+		fill(type);
+	}
+}
+
+void ChunkSection::fill(BlockData::BlockType type) {
+	runs.clear();
+	runs.shrink_to_fit();
+	storage.fill(type);
+	nonAirCount = type == BlockData::BlockType::air ? 0 : BlockCount;
+}
+
+void ChunkSection::recountNonAir() {
+	if (storage.getBitsPerEntry() == 0) {
+		nonAirCount = getUniformType() == BlockData::BlockType::air ? 0 : BlockCount;
+		return;
+	}
+
+	nonAirCount = 0;
+	for (int32_t i = 0; i < BlockCount; ++i) {
+		if (storage.get(i) != BlockData::BlockType::air) {
+			nonAirCount++;
+		}
+	}
+}
+
+bool ChunkSection::compress() {
+	constexpr size_t MaxRunPaletteSize = 16;
+	if (isCompressed() || getState() != State::mixed || storage.getPaletteSize() > MaxRunPaletteSize) {
+		return false;
+	}
+
+	const size_t packedSize = BlockCount * storage.getBitsPerEntry() / 8;
+	std::vector<uint8_t> encoded;
+	encoded.reserve(Size * Size * 2);
+	for (int32_t z = 0; z < Size; ++z) {
+		for (int32_t x = 0; x < Size; ++x) {
+			int32_t y = 0;
+			while (y < Size) {
+				const uint32_t paletteIndex = storage.getPaletteIndex(getIndex(x, y, z));
+				int32_t length = 1;
+				while (y + length < Size &&
+					   storage.getPaletteIndex(getIndex(x, y + length, z)) == paletteIndex) {
+					length++;
+				}
+
+				encoded.push_back(static_cast<uint8_t>((paletteIndex << 4) | (length - 1)));
+				if (encoded.size() >= packedSize) {
+					return false;
+				}
+				y += length;
+			}
+		}
+	}
+
+	encoded.shrink_to_fit();
+	runs = std::move(encoded);
+	storage.releaseIndices();
+	return true;
+}
+
+void ChunkSection::decompress() {
+	if (!isCompressed()) {
+		return;
+	}
+
+	// Indices restart at 0, runs of the first palette entry have nothing to write
+	storage.restoreIndices();
+	size_t run = 0;
+	for (int32_t z = 0; z < Size; ++z) {
+		for (int32_t x = 0; x < Size; ++x) {
+			int32_t y = 0;
+			while (y < Size) {
+				const uint32_t paletteIndex = runs[run] >> 4;
+				const int32_t length = (runs[run] & 0xF) + 1;
+				run++;
+				if (paletteIndex != 0) {
+					for (int32_t i = 0; i < length; ++i) {
+						storage.setPaletteIndex(getIndex(x, y + i, z), paletteIndex);
+					}
+				}
+				y += length;
+			}
+		}
+	}
+	assert(run == runs.size());
+
+	runs.clear();
+	runs.shrink_to_fit();
+}
+
+bool ChunkSection::read(std::istream& stream) {
+	if (!storage.read(stream)) {
+		return false;
+	}
+
+	recountNonAir();
+	if (nonAirCount == 0) {
+		storage.fill(BlockData::BlockType::air);
+	} else if (nonAirCount == BlockCount && storage.holdsOnly(storage.get(0))) {
+		// Saved before its last other block was replaced
+		storage.fill(storage.get(0));
+	}
+	return true;
+}
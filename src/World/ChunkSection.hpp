@@ -0,0 +1,148 @@
+/**
+ * @file ChunkSection.hpp
+ * @brief 16x16x16 vertical slice of a chunk
+ *
+ * @details A chunk is split into VerticalSize / Size sections stacked along Y. Each section
+ *          tracks whether it is entirely air, filled with a single block type or mixed, so
+ *          uniform sections take no per-block storage and can be skipped by the mesher, the
+ *          generator and the persistence layer.
+ *
+ *          Mixed sections of cold chunks can additionally be compressed: their packed indices are
+ *          replaced by runs along Y, which terrain columns (stone, dirt, grass, air) are made of.
+ *          A compressed section must be decompressed before its blocks are read or written.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+#include "BlockTypes.hpp"
+#include "PalettedBlockStorage.hpp"
+
+#include <iosfwd>
+
+class ChunkSection {
+   public:
+	static constexpr int32_t Size = 16;
+	static constexpr int32_t BlockCount = Size * Size * Size;
+
+	enum class State : uint8_t { empty, uniform, mixed };
+
+   private:
+	/**
+	 * @brief Block types, stored in layer order (x changes fastest, then z, then y)
+	 */
+	PalettedBlockStorage storage{BlockCount};
+	int32_t nonAirCount = 0;
+
+	/**
+	 * @brief Packed indices of a compressed section, empty while the section is resident
+	 *
+	 * @details One byte per run: palette index in the high nibble, run length - 1 in the low
+	 *          nibble. Runs follow each (x, z) column from bottom to top, columns in storage order.
+	 */
+	std::vector<uint8_t> runs;
+
+	void recountNonAir();
+
+   public:
+	/**
+	 * @brief Convert local section coordinates to the storage index
+	 */
+	[[nodiscard]] static constexpr int32_t getIndex(int32_t x, int32_t y, int32_t z) {
+		return x + z * Size + y * Size * Size;
+	}
+
+	[[nodiscard]] BlockData::BlockType get(int32_t x, int32_t y, int32_t z) const {
+		assert(!isCompressed());
+		return storage.get(getIndex(x, y, z));
+	}
+
+	/**
+	 * @brief Sets one block, falling back to an empty or uniform section when it replaces the
+	 *        last block of another type
+	 */
+	void set(int32_t x, int32_t y, int32_t z, BlockData::BlockType type);
+
+	/**
+	 * @brief Fill the whole section with one block type, releasing the per-block storage
+	 */
+	void fill(BlockData::BlockType type);
+
+	[[nodiscard]] State getState() const {
+		if (nonAirCount == 0) {
+			return State::empty;
+		}
+		return storage.getBitsPerEntry() == 0 ? State::uniform : State::mixed;
+	}
+
+	[[nodiscard]] bool isEmpty() const { return nonAirCount == 0; }
+
+	/**
+	 * @brief Block type of a uniform section (only meaningful when getState() != mixed)
+	 */
+	[[nodiscard]] BlockData::BlockType getUniformType() const { return storage.get(0); }
+
+	[[nodiscard]] int32_t getNonAirCount() const { return nonAirCount; }
+	[[nodiscard]] size_t getMemoryUsage() const {
+		return storage.getMemoryUsage() + runs.capacity() * sizeof(uint8_t);
+	}
+
+	[[nodiscard]] bool isCompressed() const { return !runs.empty(); }
+
+	/**
+	 * @brief Reads the blocks of the columns [fromX, toX) x [fromZ, toZ), calling
+	 *        write(x, y, z, type) for each of them
+	 *
+	 * @details A compressed section is read from its runs, so that copying a few columns does
+	 *          not need to decompress it.
+	 */
+	template <typename Write>
+	void readColumns(int32_t fromX, int32_t toX, int32_t fromZ, int32_t toZ, const Write& write) const {
+		if (!isCompressed()) {
+			for (int32_t y = 0; y < Size; ++y) {
+				for (int32_t z = fromZ; z < toZ; ++z) {
+					for (int32_t x = fromX; x < toX; ++x) {
+						write(x, y, z, storage.get(getIndex(x, y, z)));
+					}
+				}
+			}
+			return;
+		}
+
+		// Runs of a column have no fixed size, the columns before the range are stepped over
+		size_t run = 0;
+		for (int32_t z = 0; z < toZ; ++z) {
+			for (int32_t x = 0; x < Size; ++x) {
+				const bool isRead = z >= fromZ && x >= fromX && x < toX;
+				for (int32_t y = 0; y < Size; ++run) {
+					const int32_t length = (runs[run] & 0xF) + 1;
+					if (isRead) {
+						const BlockData::BlockType type = storage.getPaletteEntry(runs[run] >> 4);
+						for (int32_t i = 0; i < length; ++i) {
+							write(x, y + i, z, type);
+						}
+					}
+					y += length;
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Replaces the packed indices of a mixed section by runs along Y
+	 * @return false (and nothing changes) if the section is not mixed, has more than 16 palette
+	 *         entries or the runs would not be smaller than the packed indices
+	 */
+	bool compress();
+
+	/**
+	 * @brief Restores the packed indices of a compressed section
+	 */
+	void decompress();
+
+	void write(std::ostream& stream) const {
+		assert(!isCompressed());
+		storage.write(stream);
+	}
+	bool read(std::istream& stream);
+};
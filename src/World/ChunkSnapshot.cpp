@@ -0,0 +1,80 @@
+#include "ChunkSnapshot.hpp"
+
+#include "../Utils/Utils.hpp"
+#include "World.hpp"
+
+void ChunkSnapshot::copyColumns(const Chunk* chunk,
+								int32_t fromX,
+								int32_t toX,
+								int32_t fromZ,
+								int32_t toZ,
+								const glm::ivec2& offset) {
+	for (int32_t sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex) {
+		// Neighbors may be cold, their mixed sections are read from the runs when compressed
+		const ChunkSection* section = chunk ? &chunk->getStoredSection(sectionIndex) : nullptr;
+		const int32_t sectionBase = sectionIndex * ChunkSection::Size;
+		if (section && section->getState() == ChunkSection::State::mixed) {
+			section->readColumns(fromX, toX, fromZ, toZ, [&](int32_t x, int32_t y, int32_t z, BlockType type) {
+				blocks[getIndex(x + offset.x, sectionBase + y, z + offset.y)] = type;
+			});
+			continue;
+		}
+
+		const BlockType fill = section ? section->getUniformType() : Void;
+		for (int32_t localY = 0; localY < ChunkSection::Size; ++localY) {
+			for (int32_t z = fromZ; z < toZ; ++z) {
+				BlockType* row = &blocks[getIndex(offset.x, sectionBase + localY, z + offset.y)];
+				std::fill(row + fromX, row + toX, fill);
+			}
+		}
+	}
+}
+
+void ChunkSnapshot::capture(const Chunk& chunk, const World& world) {
+	std::array<const Chunk*, 9> neighbors{};
+	for (int32_t dx = -1; dx <= 1; ++dx) {
+		for (int32_t dz = -1; dz <= 1; ++dz) {
+			if (dx == 0 && dz == 0) {
+				continue;
+			}
+			const glm::ivec2 offset = glm::ivec2(dx, dz) * Chunk::HorizontalSize;
+			neighbors[(dx + 1) + (dz + 1) * 3] = world.getChunkIfLoaded(chunk.getPosition() + offset);
+		}
+	}
+	capture(chunk, neighbors);
+}
+
+void ChunkSnapshot::capture(const Chunk& chunk, const std::array<const Chunk*, 9>& neighbors) {
+	TRACE_FUNCTION();
+	chunkPosition = chunk.getPosition();
+
+	// Padding layers below and above the world
+	std::fill_n(blocks.begin() + getIndex(-Padding, -Padding, -Padding), LayerSize, Void);
+	std::fill_n(blocks.begin() + getIndex(-Padding, Chunk::VerticalSize, -Padding), LayerSize, Void);
+
+	for (int32_t sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex) {
+		const ChunkSection& section = chunk.getSection(sectionIndex);
+		sectionStates[sectionIndex] = section.getState();
+		sectionNonAirCounts[sectionIndex] = section.getNonAirCount();
+	}
+
+	copyColumns(&chunk, 0, Chunk::HorizontalSize, 0, Chunk::HorizontalSize, {0, 0});
+
+	// Only the column slice of each neighbor that touches this chunk is copied
+	constexpr int32_t Last = Chunk::HorizontalSize - 1;
+	for (int32_t dx = -1; dx <= 1; ++dx) {
+		for (int32_t dz = -1; dz <= 1; ++dz) {
+			if (dx == 0 && dz == 0) {
+				continue;
+			}
+
+			const glm::ivec2 offset = glm::ivec2(dx, dz) * Chunk::HorizontalSize;
+			const Chunk* neighbor = neighbors[(dx + 1) + (dz + 1) * 3];
+			const int32_t fromX = dx < 0 ? Last : 0;
+			const int32_t toX = dx > 0 ? 1 : Chunk::HorizontalSize;
+			const int32_t fromZ = dz < 0 ? Last : 0;
+			const int32_t toZ = dz > 0 ? 1 : Chunk::HorizontalSize;
+			copyColumns(neighbor, fromX, toX, fromZ, toZ, offset);
+		}
+	}
+}
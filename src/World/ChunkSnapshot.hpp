@@ -0,0 +1,97 @@
+/**
+ * @file ChunkSnapshot.hpp
+ * @brief Read-only copy of a chunk and of its border with the neighboring chunks
+ *
+ * @details The mesh builder runs on worker threads while the main thread keeps placing blocks and
+ *          loading or unloading chunks. Instead of reading the live chunks, a mesh task copies the
+ *          block types it needs into a snapshot when it is submitted: the chunk itself plus a one
+ *          block wide border taken from the 8 surrounding chunks, and one padding layer below and
+ *          above the world. Every neighbor and ambient occlusion lookup then becomes a plain array
+ *          read, without bounds checks, hash lookups or locks.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+#include "BlockTypes.hpp"
+#include "Chunk.hpp"
+#include "ChunkSection.hpp"
+
+class World;
+
+class ChunkSnapshot {
+   public:
+	using BlockType = BlockData::BlockType;
+
+	static constexpr int32_t Padding = 1;
+	static constexpr int32_t HorizontalSize = Chunk::HorizontalSize + 2 * Padding;
+	static constexpr int32_t VerticalSize = Chunk::VerticalSize + 2 * Padding;
+	static constexpr int32_t LayerSize = HorizontalSize * HorizontalSize;
+	static constexpr int32_t BlockCount = LayerSize * VerticalSize;
+
+	/**
+	 * @brief Marker for blocks outside of the world or inside a chunk that is not loaded
+	 *
+	 * @details Faces facing a void block are not generated and void blocks don't occlude, which
+	 *          matches what the mesher used to do with the null BlockData of these positions.
+	 */
+	static constexpr BlockType Void = static_cast<BlockType>(0xFF);
+
+   private:
+	glm::ivec2 chunkPosition{0};
+	std::vector<BlockType> blocks;
+	std::array<ChunkSection::State, Chunk::SectionCount> sectionStates{};
+	std::array<int32_t, Chunk::SectionCount> sectionNonAirCounts{};
+
+	/**
+	 * @brief Copies the columns [fromX, toX) x [fromZ, toZ) of a chunk (chunk-local coordinates)
+	 *        to the snapshot, shifted by offset. A null chunk writes Void.
+	 */
+	void copyColumns(const Chunk* chunk,
+					 int32_t fromX,
+					 int32_t toX,
+					 int32_t fromZ,
+					 int32_t toZ,
+					 const glm::ivec2& offset);
+
+   public:
+	ChunkSnapshot() : blocks(BlockCount, Void) {}
+
+	/**
+	 * @brief Copies a chunk and the border of its loaded neighbors
+	 *
+	 * @note Must be called from the main thread, the snapshot can then be read from any thread.
+	 */
+	void capture(const Chunk& chunk, const World& world);
+
+	/**
+	 * @brief Copies a chunk and the border of the given neighbors
+	 *
+	 * @param neighbors Neighbor at (dx, dz) chunks of the chunk at index (dx + 1) + (dz + 1) * 3,
+	 *        nullptr when it is not loaded. The center entry is ignored.
+	 */
+	void capture(const Chunk& chunk, const std::array<const Chunk*, 9>& neighbors);
+
+	/**
+	 * @brief Index of a chunk-local position, valid for x and z in [-1, 16] and y in [-1, 256]
+	 */
+	[[nodiscard]] static constexpr int32_t getIndex(int32_t x, int32_t y, int32_t z) {
+		return (x + Padding) + (z + Padding) * HorizontalSize + (y + Padding) * LayerSize;
+	}
+
+	/**
+	 * @brief Index difference between a block and its neighbor in a direction
+	 */
+	[[nodiscard]] static constexpr int32_t getStride(const glm::ivec3& offset) {
+		return offset.x + offset.z * HorizontalSize + offset.y * LayerSize;
+	}
+
+	[[nodiscard]] BlockType get(int32_t index) const { return blocks[index]; }
+	[[nodiscard]] BlockType get(const glm::ivec3& position) const {
+		return blocks[getIndex(position.x, position.y, position.z)];
+	}
+
+	[[nodiscard]] glm::ivec2 getChunkPosition() const { return chunkPosition; }
+	[[nodiscard]] ChunkSection::State getSectionState(int32_t index) const { return sectionStates[index]; }
+	[[nodiscard]] int32_t getSectionNonAirCount(int32_t index) const { return sectionNonAirCounts[index]; }
+};
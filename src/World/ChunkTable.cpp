@@ -0,0 +1,44 @@
+#include "ChunkTable.hpp"
+
+ChunkHandle ChunkTable::insert(Chunk& chunk) {
+	assert(!chunk.getHandle().isValid() && "Chunk is already stored in a table");
+
+	uint32_t index;
+	if (!freeIndices.empty()) {
+		index = freeIndices.back();
+		freeIndices.pop_back();
+	} else {
+		assert(slots.size() <= ChunkHandle::MaxIndex && "Too many chunks loaded");
+		index = static_cast<uint32_t>(slots.size());
+		slots.emplace_back();
+	}
+
+	Slot& slot = slots[index];
+	slot.chunk = &chunk;
+	chunkCount++;
+
+	const ChunkHandle handle(index, slot.generation);
+	chunk.setHandle(handle);
+	return handle;
+}
+
+Chunk* ChunkTable::remove(ChunkHandle handle) {
+	if (get(handle) == nullptr) {
+		return nullptr;
+	}
+
+	Slot& slot = slots[handle.getIndex()];
+	Chunk* chunk = slot.chunk;
+	slot.chunk = nullptr;
+	chunkCount--;
+
+	// A slot that used its last generation is retired: wrapping to 0 would let the handles of
+	// its first chunk resolve again
+	if (slot.generation < ChunkHandle::GenerationMask) {
+		slot.generation++;
+		freeIndices.push_back(handle.getIndex());
+	}
+
+	chunk->setHandle(ChunkHandle());
+	return chunk;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file ChunkTable.hpp
+ * @brief Registry of the loaded chunks, addressed through generation-checked handles
+ *
+ * @details The world grid, the culling regions and the mesh tasks keep 4 byte ChunkHandles
+ *          instead of pointers. Resolving a handle is an array access plus a generation compare,
+ *          involves no atomic reference counting, and returns nullptr once the chunk has been
+ *          unloaded. The chunks themselves live in the ChunkPool.
+ *
+ * @note Only used from the main thread.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+#include "Chunk.hpp"
+#include "ChunkHandle.hpp"
+
+class ChunkTable {
+	struct Slot {
+		Chunk* chunk = nullptr;
+		uint32_t generation = 0;
+	};
+
+	std::vector<Slot> slots;
+	std::vector<uint32_t> freeIndices;
+	size_t chunkCount = 0;
+
+   public:
+	/**
+	 * @brief Stores a chunk and assigns it its handle
+	 */
+	ChunkHandle insert(Chunk& chunk);
+
+	/**
+	 * @brief Removes a chunk, invalidating every copy of its handle
+	 * @return The chunk that was stored, nullptr if the handle was already stale
+	 */
+	Chunk* remove(ChunkHandle handle);
+
+	/**
+	 * @brief Resolves a handle, nullptr if its chunk has been removed
+	 */
+	[[nodiscard]] Chunk* get(ChunkHandle handle) const {
+		if (!handle.isValid() || handle.getIndex() >= slots.size()) {
+			return nullptr;
+		}
+
+		const Slot& slot = slots[handle.getIndex()];
+		return slot.generation == handle.getGeneration() ? slot.chunk : nullptr;
+	}
+
+	[[nodiscard]] size_t getChunkCount() const { return chunkCount; }
+};
@@ -0,0 +1,72 @@
+/**
+ * @file Heightmap.hpp
+ * @brief Highest block of each column of a chunk
+ *
+ * @details Chunks keep one heightmap for the highest solid block and one for the highest non-air
+ *          block. They are updated when blocks are placed, so "top of this column" queries no
+ *          longer need to scan the column.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+
+#include <istream>
+#include <ostream>
+
+class Heightmap {
+   public:
+	static constexpr int32_t Size = 16;
+
+	/**
+	 * @brief Height of a column that contains no matching block
+	 */
+	static constexpr int16_t Empty = -1;
+
+	enum class Type : uint8_t {
+		solid,	// Highest block of class solid
+		nonAir	// Highest block that is not air (water and leaves included)
+	};
+
+   private:
+	std::array<int16_t, Size * Size> heights;
+
+   public:
+	Heightmap() { heights.fill(Empty); }
+
+	[[nodiscard]] int32_t get(int32_t x, int32_t z) const {
+		assert(x >= 0 && x < Size && z >= 0 && z < Size);
+		return heights[x + z * Size];
+	}
+
+	void set(int32_t x, int32_t z, int32_t height) {
+		assert(x >= 0 && x < Size && z >= 0 && z < Size);
+		heights[x + z * Size] = static_cast<int16_t>(height);
+	}
+
+	void fill(int32_t height) { heights.fill(static_cast<int16_t>(height)); }
+
+	void write(std::ostream& stream) const {
+		stream.write(reinterpret_cast<const char*>(heights.data()), sizeof(heights));
+	}
+
+	/**
+	 * @brief Reads a heightmap, rejecting heights outside [Empty, maxHeight)
+	 */
+	bool read(std::istream& stream, int32_t maxHeight) {
+		std::array<int16_t, Size * Size> newHeights;
+		stream.read(reinterpret_cast<char*>(newHeights.data()), sizeof(newHeights));
+		if (!stream) {
+			return false;
+		}
+
+		for (int16_t height : newHeights) {
+			if (height < Empty || height >= maxHeight) {
+				return false;
+			}
+		}
+
+		heights = newHeights;
+		return true;
+	}
+};
@@ -37,11 +37,11 @@ public:
     }
     
     /**
-     * @brief Get the block skip factor for a LOD level
+     * @brief Get the size of the cells a LOD level merges into one block
      * @param lod The LOD level
-     * @return How many blocks to skip (1 = no skip, 2 = every other, etc.)
+     * @return Edge length of a cell in blocks (1 = every block, 2 = 2x2x2 blocks, etc.)
      */
-    static int getBlockSkipFactor(LODLevel lod) {
+    static int getCellSize(LODLevel lod) {
         switch (lod) {
             case LODLevel::Full:
                 return 1;
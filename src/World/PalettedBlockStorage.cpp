@@ -0,0 +1,170 @@
+#include "PalettedBlockStorage.hpp"
+
+#include "../Utils/Utils.hpp"
+
+#include <istream>
+#include <ostream>
+
+PalettedBlockStorage::PalettedBlockStorage(int32_t entryCount, BlockType fill)
+	: entryCount(entryCount), palette{fill} {}
+
+void PalettedBlockStorage::setPaletteIndex(int32_t index, uint32_t paletteIndex) {
+	if (bitsPerEntry == 0) {
+		assert(paletteIndex == 0);
+		return;
+	}
+
+	const uint32_t entriesPerWord = 64 / bitsPerEntry;
+	const uint32_t shift = (index % entriesPerWord) * bitsPerEntry;
+	const uint64_t mask = ((uint64_t{1} << bitsPerEntry) - 1) << shift;
+	uint64_t& word = words[index / entriesPerWord];
+	word = (word & ~mask) | ((static_cast<uint64_t>(paletteIndex) << shift) & mask);
+}
+
+uint32_t PalettedBlockStorage::findOrInsert(BlockType type) {
+	auto it = std::find(palette.begin(), palette.end(), type);
+	if (it != palette.end()) {
+		return static_cast<uint32_t>(std::distance(palette.begin(), it));
+	}
+
+	palette.push_back(type);
+	const uint8_t requiredBits = bitsForPaletteSize(palette.size());
+	if (requiredBits > bitsPerEntry) {
+		resize(requiredBits);
+	}
+	return static_cast<uint32_t>(palette.size() - 1);
+}
+
+void PalettedBlockStorage::resize(uint8_t newBitsPerEntry) {
+	TRACE_FUNCTION();
+	PalettedBlockStorage widened(entryCount);
+	widened.bitsPerEntry = newBitsPerEntry;
+	widened.words.assign((entryCount + 64 / newBitsPerEntry - 1) / (64 / newBitsPerEntry), 0);
+
+	for (int32_t i = 0; i < entryCount; ++i) {
+		widened.setPaletteIndex(i, getPaletteIndex(i));
+	}
+
+	bitsPerEntry = newBitsPerEntry;
+	words = std::move(widened.words);
+}
+
+void PalettedBlockStorage::set(int32_t index, BlockType type) {
+	assert(index >= 0 && index < entryCount);
+	if (bitsPerEntry == 0 && palette[0] == type) {
+		return;
+	}
+
+	setPaletteIndex(index, findOrInsert(type));
+}
+
+bool PalettedBlockStorage::holdsOnly(BlockType type) const {
+	auto it = std::find(palette.begin(), palette.end(), type);
+	if (it == palette.end()) {
+		return false;
+	}
+	if (bitsPerEntry == 0) {
+		return true;
+	}
+
+	// Compare whole words against the index of the type repeated in every entry
+	const auto paletteIndex = static_cast<uint64_t>(std::distance(palette.begin(), it));
+	uint64_t pattern = 0;
+	for (uint32_t shift = 0; shift < 64; shift += bitsPerEntry) {
+		pattern |= paletteIndex << shift;
+	}
+
+	const int32_t entriesPerWord = 64 / bitsPerEntry;
+	const int32_t fullWords = entryCount / entriesPerWord;
+	for (int32_t i = 0; i < fullWords; ++i) {
+		if (words[i] != pattern) {
+			return false;
+		}
+	}
+
+	const int32_t remainingEntries = entryCount % entriesPerWord;
+	if (remainingEntries == 0) {
+		return true;
+	}
+	const uint64_t mask = (uint64_t{1} << (remainingEntries * bitsPerEntry)) - 1;
+	return (words[fullWords] & mask) == (pattern & mask);
+}
+
+void PalettedBlockStorage::fill(BlockType type) {
+	palette.assign(1, type);
+	bitsPerEntry = 0;
+	words.clear();
+	words.shrink_to_fit();
+}
+
+void PalettedBlockStorage::releaseIndices() {
+	words.clear();
+	words.shrink_to_fit();
+}
+
+void PalettedBlockStorage::restoreIndices() {
+	if (bitsPerEntry == 0) {
+		return;
+	}
+
+	const int32_t entriesPerWord = 64 / bitsPerEntry;
+	words.assign((entryCount + entriesPerWord - 1) / entriesPerWord, 0);
+}
+
+/**
+ * @brief Serializes the storage
+ *
+ * @details Layout: bitsPerEntry (u8), palette size (u8), palette entries (u8 each), then the
+ *          packed words when bitsPerEntry is not 0.
+ */
+void PalettedBlockStorage::write(std::ostream& stream) const {
+	const auto paletteSize = static_cast<uint8_t>(palette.size());
+	stream.write(reinterpret_cast<const char*>(&bitsPerEntry), sizeof(bitsPerEntry));
+	stream.write(reinterpret_cast<const char*>(&paletteSize), sizeof(paletteSize));
+	stream.write(reinterpret_cast<const char*>(palette.data()), paletteSize * sizeof(BlockType));
+	if (bitsPerEntry != 0) {
+		stream.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint64_t));
+	}
+}
+
+bool PalettedBlockStorage::read(std::istream& stream) {
+	uint8_t bits = 0;
+	uint8_t paletteSize = 0;
+	stream.read(reinterpret_cast<char*>(&bits), sizeof(bits));
+	stream.read(reinterpret_cast<char*>(&paletteSize), sizeof(paletteSize));
+	if (!stream || paletteSize == 0 || bits != bitsForPaletteSize(paletteSize)) {
+		return false;
+	}
+
+	std::vector<BlockType> newPalette(paletteSize);
+	stream.read(reinterpret_cast<char*>(newPalette.data()), paletteSize * sizeof(BlockType));
+	for (BlockType type : newPalette) {
+		if (static_cast<size_t>(type) >= BlockData::TypeCount) {
+			return false;
+		}
+	}
+
+	std::vector<uint64_t> newWords;
+	if (bits != 0) {
+		newWords.resize((entryCount + 64 / bits - 1) / (64 / bits));
+		stream.read(reinterpret_cast<char*>(newWords.data()), newWords.size() * sizeof(uint64_t));
+	}
+	if (!stream) {
+		return false;
+	}
+
+	const uint8_t previousBits = bitsPerEntry;
+	bitsPerEntry = bits;
+	words.swap(newWords);
+	for (int32_t i = 0; i < entryCount; ++i) {
+		if (getPaletteIndex(i) >= paletteSize) {
+			// Corrupted indices, keep the previous content
+			bitsPerEntry = previousBits;
+			words.swap(newWords);
+			return false;
+		}
+	}
+
+	palette = std::move(newPalette);
+	return true;
+}
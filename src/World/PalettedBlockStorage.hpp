@@ -0,0 +1,124 @@
+/**
+ * @file PalettedBlockStorage.hpp
+ * @brief Palette-compressed storage for block types
+ *
+ * @details Stores a fixed number of blocks as bit-packed indices into a small palette of block
+ *          types. A storage that only contains one block type needs no index data at all, and
+ *          the index width only grows (1, 2, 4 then 8 bits) when a new block type is inserted.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+#include "BlockTypes.hpp"
+
+#include <iosfwd>
+
+/**
+ * @class PalettedBlockStorage
+ * @brief Bit-packed block storage backed by a per-storage palette
+ *
+ * @details Entries never straddle two words because the index width is always a divisor of 64.
+ *          With 18 block types the width never exceeds 8 bits, so the worst case is 8 times
+ *          smaller than storing a full BlockData per block.
+ */
+class PalettedBlockStorage {
+   public:
+	using BlockType = BlockData::BlockType;
+
+   private:
+	int32_t entryCount;
+	uint8_t bitsPerEntry = 0;
+	std::vector<BlockType> palette;
+	std::vector<uint64_t> words;
+
+	[[nodiscard]] static constexpr uint8_t bitsForPaletteSize(size_t paletteSize) {
+		if (paletteSize <= 1) {
+			return 0;
+		} else if (paletteSize <= 2) {
+			return 1;
+		} else if (paletteSize <= 4) {
+			return 2;
+		} else if (paletteSize <= 16) {
+			return 4;
+		}
+		return 8;
+	}
+
+	/**
+	 * @brief Returns the palette index of a type, inserting it (and widening) when missing
+	 */
+	uint32_t findOrInsert(BlockType type);
+
+	/**
+	 * @brief Re-packs every entry using a new index width
+	 */
+	void resize(uint8_t newBitsPerEntry);
+
+   public:
+	explicit PalettedBlockStorage(int32_t entryCount, BlockType fill = BlockType::air);
+
+	/**
+	 * @brief Index of an entry in the palette (always 0 when bitsPerEntry is 0)
+	 */
+	[[nodiscard]] uint32_t getPaletteIndex(int32_t index) const {
+		if (bitsPerEntry == 0) {
+			return 0;
+		}
+
+		const uint32_t entriesPerWord = 64 / bitsPerEntry;
+		const uint64_t mask = (uint64_t{1} << bitsPerEntry) - 1;
+		const uint64_t word = words[index / entriesPerWord];
+		return static_cast<uint32_t>((word >> ((index % entriesPerWord) * bitsPerEntry)) & mask);
+	}
+
+	/**
+	 * @brief Overwrites the palette index of an entry (must be lower than getPaletteSize())
+	 */
+	void setPaletteIndex(int32_t index, uint32_t paletteIndex);
+
+	[[nodiscard]] BlockType get(int32_t index) const {
+		assert(index >= 0 && index < entryCount);
+		return palette[getPaletteIndex(index)];
+	}
+
+	void set(int32_t index, BlockType type);
+
+	/**
+	 * @brief Whether every entry is of one block type, whatever the palette still holds
+	 */
+	[[nodiscard]] bool holdsOnly(BlockType type) const;
+
+	/**
+	 * @brief Replaces every entry with a single block type and releases the index data
+	 */
+	void fill(BlockType type);
+
+	/**
+	 * @brief Frees the packed indices but keeps the palette and the index width
+	 *
+	 * @details Lets the owner keep the indices in another encoding for a while. No entry may be
+	 *          read or written until restoreIndices() is called and every index is set again.
+	 */
+	void releaseIndices();
+
+	/**
+	 * @brief Reallocates the packed indices released by releaseIndices(), all set to 0
+	 */
+	void restoreIndices();
+
+	[[nodiscard]] int32_t size() const { return entryCount; }
+	[[nodiscard]] uint8_t getBitsPerEntry() const { return bitsPerEntry; }
+	[[nodiscard]] size_t getPaletteSize() const { return palette.size(); }
+	[[nodiscard]] BlockType getPaletteEntry(uint32_t paletteIndex) const { return palette[paletteIndex]; }
+
+	/**
+	 * @brief Heap memory used by the palette and the packed indices, in bytes
+	 */
+	[[nodiscard]] size_t getMemoryUsage() const {
+		return palette.capacity() * sizeof(BlockType) + words.capacity() * sizeof(uint64_t);
+	}
+
+	void write(std::ostream& stream) const;
+	bool read(std::istream& stream);
+};
@@ -0,0 +1,78 @@
+#include "SectionConnectivity.hpp"
+
+#include <bit>
+
+namespace {
+	constexpr int32_t Size = ChunkSection::Size;
+	constexpr uint16_t FullColumn = 0xFFFF;
+
+	/**
+	 * @brief Faces of the section a block lies against, bit = face
+	 */
+	uint8_t getTouchedFaces(int32_t x, int32_t y, int32_t z) {
+		uint8_t faces = 0;
+		faces |= y == Size - 1 ? 1u << 0 : 0;
+		faces |= x == Size - 1 ? 1u << 1 : 0;
+		faces |= x == 0 ? 1u << 2 : 0;
+		faces |= z == 0 ? 1u << 3 : 0;
+		faces |= z == Size - 1 ? 1u << 4 : 0;
+		faces |= y == 0 ? 1u << 5 : 0;
+		return faces;
+	}
+}
+
+SectionConnectivity SectionConnectivity::compute(const SolidColumns& solid) {
+	int32_t solidBlocks = 0;
+	for (uint16_t column : solid) {
+		solidBlocks += std::popcount(column);
+	}
+	if (solidBlocks == 0) {
+		return SectionConnectivity(AllConnected);
+	}
+	if (solidBlocks == ChunkSection::BlockCount) {
+		return SectionConnectivity(NoneConnected);
+	}
+
+	// Solid blocks start as visited, so only the open blocks get filled. Blocks are indexed
+	// x + z * 16 + y * 256, which fits the 16 bit stack entries.
+	SolidColumns visited = solid;
+	std::array<uint16_t, ChunkSection::BlockCount> stack;
+	SectionConnectivity connectivity(NoneConnected);
+	for (int32_t column = 0; column < Size * Size; ++column) {
+		while (visited[column] != FullColumn) {
+			// Seed a region at the lowest open block of the column
+			const int32_t seedY = std::countr_one(visited[column]);
+			visited[column] |= 1u << seedY;
+			int32_t stackSize = 0;
+			stack[stackSize++] = static_cast<uint16_t>(column + seedY * Size * Size);
+
+			uint8_t faces = 0;
+			while (stackSize > 0) {
+				const int32_t block = stack[--stackSize];
+				const int32_t x = block % Size;
+				const int32_t z = (block / Size) % Size;
+				const int32_t y = block / (Size * Size);
+				faces |= getTouchedFaces(x, y, z);
+
+				for (int32_t face = 0; face < FaceCount; ++face) {
+					const glm::ivec3 neighbor = glm::ivec3(x, y, z) + getFaceDirection(face);
+					if (glm::any(glm::lessThan(neighbor, glm::ivec3(0))) ||
+						glm::any(glm::greaterThanEqual(neighbor, glm::ivec3(Size)))) {
+						continue;
+					}
+					uint16_t& neighborColumn = visited[neighbor.x + neighbor.z * Size];
+					if ((neighborColumn & (1u << neighbor.y)) == 0) {
+						neighborColumn |= 1u << neighbor.y;
+						stack[stackSize++] = static_cast<uint16_t>(neighbor.x + neighbor.z * Size + neighbor.y * Size * Size);
+					}
+				}
+			}
+
+			connectivity.connectFaces(faces);
+			if (connectivity.bits == AllConnected) {
+				return connectivity;
+			}
+		}
+	}
+	return connectivity;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file SectionConnectivity.hpp
+ * @brief Which faces of a 16x16x16 section can see each other through its non-opaque blocks
+ *
+ * @details One bit per pair of faces (15 pairs), set when a path of non-solid blocks joins the
+ *          two faces. A line of sight entering a section through a face can only leave it
+ *          through a face connected to it, so walking the sections from the camera and only
+ *          crossing connected faces (see World::findVisibleSections) reaches every section that
+ *          may be seen: caves are skipped from the surface and the surface from the caves.
+ *
+ *          Faces use the BlockMesh order: 0 top, 1 east (+x), 2 west (-x), 3 north (-z),
+ *          4 south (+z), 5 bottom, the opposite of a face being 5 - face.
+ *
+ * @note Computed by the mesher from a ChunkSnapshot, no GL call is made.
+ */
+
+#pragma once
+
+#include "../Common.hpp"
+#include "ChunkSection.hpp"
+
+class SectionConnectivity {
+   public:
+	static constexpr int32_t FaceCount = 6;
+	static constexpr uint16_t AllConnected = 0x7FFF;
+	static constexpr uint16_t NoneConnected = 0;
+
+	/**
+	 * @brief Solid blocks of a section, one section-local Y bit per block for each x + z * 16
+	 *        column
+	 */
+	using SolidColumns = std::array<uint16_t, ChunkSection::Size * ChunkSection::Size>;
+
+	[[nodiscard]] static constexpr int32_t getOppositeFace(int32_t face) { return FaceCount - 1 - face; }
+
+	[[nodiscard]] static constexpr glm::ivec3 getFaceDirection(int32_t face) {
+		constexpr std::array<glm::ivec3, FaceCount> directions = {
+			glm::ivec3{0, 1, 0}, glm::ivec3{1, 0, 0},  glm::ivec3{-1, 0, 0},
+			glm::ivec3{0, 0, -1}, glm::ivec3{0, 0, 1}, glm::ivec3{0, -1, 0},
+		};
+		return directions[face];
+	}
+
+   private:
+	// Sections are considered open until their connectivity is computed
+	uint16_t bits = AllConnected;
+
+	[[nodiscard]] static constexpr int32_t getPairBit(int32_t from, int32_t to) {
+		constexpr auto pairBits = [] {
+			std::array<std::array<int8_t, FaceCount>, FaceCount> result{};
+			int8_t bit = 0;
+			for (int32_t a = 0; a < FaceCount; ++a) {
+				result[a][a] = -1;
+				for (int32_t b = a + 1; b < FaceCount; ++b) {
+					result[a][b] = result[b][a] = bit++;
+				}
+			}
+			return result;
+		}();
+		return pairBits[from][to];
+	}
+
+   public:
+	constexpr SectionConnectivity() = default;
+	explicit constexpr SectionConnectivity(uint16_t bits) : bits(bits) {}
+
+	/**
+	 * @brief Flood fills the non-solid blocks of a section, the faces touched by a same region
+	 *        are connected to each other
+	 */
+	[[nodiscard]] static SectionConnectivity compute(const SolidColumns& solid);
+
+	/**
+	 * @brief Connects every pair of the faces of a mask (bit = face)
+	 */
+	constexpr void connectFaces(uint8_t faceMask) {
+		for (int32_t a = 0; a < FaceCount; ++a) {
+			if ((faceMask & (1u << a)) == 0) {
+				continue;
+			}
+			for (int32_t b = a + 1; b < FaceCount; ++b) {
+				if ((faceMask & (1u << b)) != 0) {
+					bits |= 1u << getPairBit(a, b);
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Whether a face can be seen from another one, always true for the same face
+	 */
+	[[nodiscard]] constexpr bool isConnected(int32_t from, int32_t to) const {
+		return from == to || (bits & (1u << getPairBit(from, to))) != 0;
+	}
+
+	[[nodiscard]] constexpr uint16_t getBits() const { return bits; }
+
+	constexpr bool operator==(const SectionConnectivity& other) const = default;
+};
@@ -12,32 +12,50 @@
 
 #include <ranges>
 
-// ChunkPool implementation
-Ref<Chunk> ChunkPool::acquire(glm::ivec2 pos) {
-	if (!available.empty()) {
-		auto chunk = std::shared_ptr<Chunk>(available.front().release());
-		available.pop();
-		chunk->reset(pos);
-		// Debug: log pool reuse
-		// printf("ChunkPool: Reused chunk for position (%d, %d), pool size: %zu\n", pos.x, pos.y,
-		// available.size());
-		return chunk;
-	}
-	// Debug: log new allocation
-	// printf("ChunkPool: New allocation for position (%d, %d)\n", pos.x, pos.y);
-	return std::make_shared<Chunk>(pos);
-}
-
-void ChunkPool::release(const Ref<Chunk>& chunk) {
-	if (available.size() < MAX_SIZE) {
-		chunk->clear();
-		available.push(std::unique_ptr<Chunk>(new Chunk(*chunk)));
-		// Debug: log pool release
-		// printf("ChunkPool: Released chunk, pool size: %zu\n", available.size());
-	} else {
-		// Debug: log pool full
-		// printf("ChunkPool: Pool full, discarding chunk\n");
-	}
+namespace {
+	/**
+	 * @brief Draws the batches of the chunk render queues
+	 *
+	 * @details The shader id of a batch is the mesh format of its chunks, it selects the buffer
+	 *          to draw from and, with the pass, the shader program. Each batch is one multi-draw.
+	 */
+	class ChunkRenderBackend : public RenderQueue::Backend {
+		using ShaderTable = std::array<std::array<const ShaderProgram*, 2>, 2>;
+
+		ShaderTable shaders;
+		const std::array<std::unique_ptr<ChunkMegaBuffer>, 2>& meshBuffers;
+		ChunkDrawList drawList;
+
+	   public:
+		ChunkRenderBackend(const ShaderTable& shaders, const std::array<std::unique_ptr<ChunkMegaBuffer>, 2>& meshBuffers)
+			: shaders(shaders), meshBuffers(meshBuffers) {}
+
+		void bindShader(RenderQueue::Pass pass, uint8_t shader) override {
+			shaders[static_cast<size_t>(pass)][shader]->bind();
+		}
+
+		void setState(uint8_t previousBits, uint8_t bits) override {
+			if (((previousBits ^ bits) & RenderQueue::NoCulling) != 0) {
+				if ((bits & RenderQueue::NoCulling) != 0) {
+					glDisable(GL_CULL_FACE);
+				} else {
+					glEnable(GL_CULL_FACE);
+				}
+			}
+		}
+
+		void draw(const RenderQueue::State& state, std::span<const RenderQueue::Command> commands) override {
+			drawList.clear();
+			for (size_t i = 0; i < commands.size(); ++i) {
+				// The commands of a chunk are contiguous, they share an entry of the origin table
+				if (i == 0 || commands[i].origin != commands[i - 1].origin) {
+					drawList.addChunk(commands[i].origin);
+				}
+				drawList.addRange(commands[i].first, commands[i].count);
+			}
+			meshBuffers[state.shader]->draw(drawList);
+		}
+	};
 }
 
 World::World(Window& window,
@@ -51,42 +69,72 @@ World::World(Window& window,
 	  persistence(persistence),
 	  generator(seed) {
 	TRACE_FUNCTION();
+	meshBuffers[static_cast<size_t>(ChunkMeshFormat::vertices)] =
+		std::make_unique<ChunkMegaBuffer>(ChunkMeshFormat::vertices, InitialMeshBufferVertices);
+	meshBuffers[static_cast<size_t>(ChunkMeshFormat::faceRecords)] =
+		std::make_unique<ChunkMegaBuffer>(ChunkMeshFormat::faceRecords, InitialMeshBufferFaces);
+
 	opaqueShader = assets.loadShaderProgram("assets/shaders/world_opaque");
 	transparentShader = assets.loadShaderProgram("assets/shaders/world_transparent");
 	blendShader = assets.loadShaderProgram("assets/shaders/world_blend");
+	const Ref<const Shader> faceVertexShader = assets.loadShader("assets/shaders/world_faces.vert");
+	opaqueFaceShader = std::make_shared<ShaderProgram>(
+		faceVertexShader, assets.loadShader("assets/shaders/world_opaque.frag"));
+	transparentFaceShader = std::make_shared<ShaderProgram>(
+		faceVertexShader, assets.loadShader("assets/shaders/world_transparent.frag"));
+
+	// Texture slots never change, only the textures bound to them do (see renderOpaque and
+	// renderTransparent). The rest comes from the FrameUniforms block.
+	for (const auto& shader : {opaqueShader, opaqueFaceShader, transparentShader, transparentFaceShader}) {
+		shader->bind();
+		shader->set(shader->getUniform<int32_t>("atlas"), AtlasTextureSlot);
+		shader->set(shader->getUniform<int32_t>("opaqueDepth"), OpaqueDepthTextureSlot);
+	}
+	glUseProgram(0);
 
 	// On charge la texture atlas (unique) générée par TextureAtlas
 	setTextureAtlas(assets.getAtlasTexture());
 	
 	// Initialize mesh task manager after World is partially constructed
-	meshTaskManager = std::make_unique<ChunkMeshTaskManager>(*this, assets);
-	
-	// Initialize regions for any existing chunks (from persistence)
-	for (const auto& [pos, chunk] : chunks) {
-		addChunkToRegion(chunk);
-	}
+	meshTaskManager = std::make_unique<ChunkMeshTaskManager>(*this, chunkTable);
+
+	chunks.resize(getGridRadius(viewDistance));
+	chunkPool.reserve(getGridCapacity(viewDistance));
+}
+
+World::~World() {
+	TRACE_FUNCTION();
+	// Chunks are only serialized when they are unloaded, save the ones still loaded
+	chunks.forEach([this](const Chunk& chunk) { persistence->commitChunk(chunk); });
 }
 
-Ref<Chunk> World::generateOrLoadChunk(glm::ivec2 position) {
+Chunk& World::generateOrLoadChunk(glm::ivec2 position) {
 	TRACE_FUNCTION();
-	Ref<Chunk> chunk = persistence->getChunk(position);
-	if (chunk != nullptr) {
-		return chunk;
+	Chunk& chunk = chunkPool.acquire(position);
+	if (!persistence->loadChunk(chunk)) {
+		generator.populateChunk(chunk);
 	}
-	chunk = chunkPool.acquire(position);
-	generator.populateChunk(chunk);
-	persistence->commitChunk(chunk);
 	return chunk;
 }
 
-void World::unloadChunk(const Ref<Chunk>& chunk) {
+void World::unloadChunk(ChunkHandle handle) {
+	Chunk* chunk = chunkTable.get(handle);
+	if (!chunk) {
+		return;
+	}
+
 	const auto chunkPos = chunk->getPosition();
-	removeChunkFromRegion(chunkPos);
-	chunks.erase(chunkPos);
+	removeChunkFromRegion(*chunk);
+	chunks.remove(chunkPos);
 
 	// Informer les WorldBehavior que les blocs de ce chunk sont supprimés
+	// (les sections vides ne contiennent que de l'air, rien à notifier)
 	for (int32_t x = 0; x < Chunk::HorizontalSize; ++x) {
 		for (int32_t y = 0; y < Chunk::VerticalSize; ++y) {
+			if (chunk->isSectionEmpty(y / ChunkSection::Size)) {
+				y += ChunkSection::Size - 1;
+				continue;
+			}
 			for (int32_t z = 0; z < Chunk::HorizontalSize; ++z) {
 				for (const auto& worldBehavior : behaviors) {
 					glm::ivec3 blockPos = {x, y, z};
@@ -98,8 +146,45 @@ void World::unloadChunk(const Ref<Chunk>& chunk) {
 		}
 	}
 
-	// Release chunk to pool for reuse
-	chunkPool.release(chunk);
+	persistence->commitChunk(*chunk);
+
+	// Invalidate the handle (pending mesh results are dropped) and release chunk to pool for reuse
+	chunkTable.remove(handle);
+	chunkPool.release(*chunk);
+}
+
+void World::unloadChunks(const std::vector<ChunkHandle>& chunksToUnload) {
+	for (ChunkHandle handle : chunksToUnload) {
+		unloadChunk(handle);
+	}
+}
+
+void World::setViewDistance(int32_t distance) {
+	if (distance == viewDistance) {
+		return;
+	}
+
+	viewDistance = distance;
+	unloadChunks(chunks.resize(getGridRadius(viewDistance)));
+	chunkPool.reserve(getGridCapacity(viewDistance));
+}
+
+void World::setUseGreedyMeshing(bool enabled) {
+	if (enabled == useGreedyMeshing) {
+		return;
+	}
+
+	useGreedyMeshing = enabled;
+	chunks.forEach([](Chunk& chunk) { chunk.setDirty(); });
+}
+
+void World::setMeshFormat(ChunkMeshFormat format) {
+	if (format == meshFormat) {
+		return;
+	}
+
+	meshFormat = format;
+	chunks.forEach([](Chunk& chunk) { chunk.setDirty(); });
 }
 
 void World::update(const glm::vec3& playerPosition, float deltaTime) {
@@ -113,14 +198,18 @@ void World::update(const glm::vec3& playerPosition, float deltaTime) {
 	glm::vec2 playerChunkPosition = getChunkIndex(playerPosition);
 
 	// Décharger les chunks trop lointains
-	auto chunksCopy = chunks;
+	std::vector<ChunkHandle> chunksToUnload;
 	float unloadDistance = static_cast<float>(viewDistance + 1) * Chunk::HorizontalSize + Chunk::HorizontalSize / 2.0f;
-	for (const auto& [chunkPosition, chunk] : chunksCopy) {
-		if (glm::abs(glm::distance(glm::vec2(chunkPosition), playerChunkPosition)) >
+	chunks.forEach([&](const Chunk& chunk) {
+		if (glm::abs(glm::distance(glm::vec2(chunk.getPosition()), playerChunkPosition)) >
 			unloadDistance) {
-			unloadChunk(chunk);
+			chunksToUnload.push_back(chunk.getHandle());
 		}
-	}
+	});
+	unloadChunks(chunksToUnload);
+
+	// Recentrer la grille sur le joueur, les chunks hors de la fenêtre sont déchargés
+	unloadChunks(chunks.recenter(glm::ivec2(playerChunkPosition)));
 
 	// Charger de nouveaux chunks si le joueur s’approche
 	float loadDistance = static_cast<float>(viewDistance) * 16 + 8.0f;
@@ -132,12 +221,14 @@ void World::update(const glm::vec3& playerPosition, float deltaTime) {
 
 			float distance = glm::abs(glm::distance(glm::vec2(position), playerChunkPosition));
 			if (distance <= loadDistance) {
-				auto chunk = generateOrLoadChunk(position);
-				addChunk(position, chunk);
+				addChunk(position, generateOrLoadChunk(position));
 			}
 		}
 	}
 
+	// Compresser les chunks restés longtemps hors de vue
+	compressColdChunks(glm::vec2(playerPosition.x, playerPosition.z), deltaTime);
+
 	// Process completed mesh generation tasks
 	// This must be done in the main thread for OpenGL operations
 	{
@@ -151,16 +242,37 @@ void World::update(const glm::vec3& playerPosition, float deltaTime) {
 	}
 }
 
+void World::compressColdChunks(glm::vec2 playerXZ, float deltaTime) {
+	PERF_TIMER("World::compressColdChunks");
+	int32_t budget = coldChunkCompressionBudget;
+	chunks.forEach([&](Chunk& chunk) {
+		if (chunk.distanceToPoint(playerXZ) < ColdChunkMinDistance) {
+			chunk.markUsed();
+			return;
+		}
+
+		chunk.addIdleTime(deltaTime);
+		if (budget > 0 && !chunk.isCompressed() && chunk.getIdleTime() >= coldChunkIdleTime) {
+			budget--;
+			chunk.compressBlocks();
+			if (!chunk.isCompressed()) {
+				// Nothing worth compressing, check again after another idle period
+				chunk.markUsed();
+			}
+		}
+	});
+}
+
 void World::sortChunkIndices(glm::vec3 playerPos, const Ref<ChunkIndexVector>& chunkIndices) {
 	chunkIndices->clear();
-	if (chunkIndices->capacity() < chunks.size()) {
-		chunkIndices->reserve(chunks.size());
+	if (chunkIndices->capacity() < chunks.getChunkCount()) {
+		chunkIndices->reserve(chunks.getChunkCount());
 	}
 
 	glm::vec2 playerXZ = glm::vec2(playerPos.x, playerPos.z);
-	for (const auto& [key, value] : chunks) {
-		chunkIndices->emplace_back(key, value->distanceToPoint(playerXZ));
-	}
+	chunks.forEach([&](const Chunk& chunk) {
+		chunkIndices->emplace_back(chunk.getPosition(), chunk.distanceToPoint(playerXZ));
+	});
 
 	// Tri du plus proche au plus lointain
 	std::sort(chunkIndices->begin(), chunkIndices->end(), [](const auto& a, const auto& b) {
@@ -172,10 +284,10 @@ void World::rebuildChunks(const Ref<ChunkIndexVector>& chunkIndices, const Frust
 	// Submit chunks to the mesh task manager instead of rebuilding directly
 	// Iterate from closest to farthest (chunkIndices is sorted in reverse)
 	for (auto& index : std::ranges::reverse_view(*chunkIndices)) {
-		const auto& chunk = chunks[index.first];
-		if (chunk->needsMeshRebuild() && chunk->isVisible(frustum)) {
+		Chunk* chunk = chunks.find(glm::ivec2(index.first));
+		if (chunk && chunk->needsMeshRebuild() && chunk->isVisible(frustum)) {
 			// Submit to thread pool for async mesh generation
-			meshTaskManager->submitChunk(chunk.get());
+			meshTaskManager->submitChunk(chunk, chunk->getCurrentLOD());
 		}
 	}
 }
@@ -185,7 +297,7 @@ void World::renderOpaque(glm::mat4 transform, glm::vec3 playerPos, const Frustum
 	PERF_TIMER("World::renderOpaque");
 
 	// 1) Hierarchical culling
-	static std::vector<Ref<Chunk>> visibleChunks;
+	static std::vector<Chunk*> visibleChunks;
 	int32_t culledChunks;
 	{
 		PERF_TIMER("World::hierarchicalCulling");
@@ -195,40 +307,51 @@ void World::renderOpaque(glm::mat4 transform, glm::vec3 playerPos, const Frustum
 	// Record metrics
 	PerformanceMonitor::getInstance().recordCount("Chunks Visible", visibleChunks.size());
 	PerformanceMonitor::getInstance().recordCount("Chunks Culled", culledChunks);
-	PerformanceMonitor::getInstance().recordCount("Chunks Loaded", chunks.size());
-	PerformanceMonitor::getInstance().recordCount("Chunk Pool Size", chunkPool.size());
+	PerformanceMonitor::getInstance().recordCount("Chunks Loaded", chunks.getChunkCount());
+	PerformanceMonitor::getInstance().recordCount("Chunk Pool Size", chunkPool.getFreeCount());
+	PerformanceMonitor::getInstance().recordCount("Chunk Pool Capacity", chunkPool.getCapacity());
+	PerformanceMonitor::getInstance().recordCount("Chunk Pool High Water", chunkPool.getHighWaterMark());
+	PerformanceMonitor::getInstance().recordCount("Chunk Pool Hits", chunkPool.getHitCount());
+	PerformanceMonitor::getInstance().recordCount("Chunk Pool Misses", chunkPool.getMissCount());
 	
 	// Calculate memory usage
-	size_t totalVertexMemory = 0;
-	for (const auto& [pos, chunk] : chunks) {
-		auto [capacity, peak] = chunk->getMemoryStats();
-		totalVertexMemory += capacity * sizeof(BlockVertex);
+	size_t totalMeshMemory = 0;
+	size_t totalBlockMemory = 0;
+	size_t compressedChunks = 0;
+	chunks.forEach([&](const Chunk& chunk) {
+		totalMeshMemory += chunk.getMeshMemoryUsage();
+		totalBlockMemory += chunk.getBlockMemoryUsage();
+		compressedChunks += chunk.isCompressed() ? 1 : 0;
+	});
+	PerformanceMonitor::getInstance().recordCount("Chunks Compressed", compressedChunks);
+	PerformanceMonitor::getInstance().recordCount("Chunks Resident", chunks.getChunkCount() - compressedChunks);
+	PerformanceMonitor::getInstance().recordCount("Mesh Memory (MB)", totalMeshMemory / (1024 * 1024));
+	PerformanceMonitor::getInstance().recordCount("Block Memory (MB)", totalBlockMemory / (1024 * 1024));
+	if (!chunks.isEmpty()) {
+		PerformanceMonitor::getInstance().recordCount("Block Memory per Chunk (KB)",
+													  totalBlockMemory / chunks.getChunkCount() / 1024);
 	}
-	PerformanceMonitor::getInstance().recordCount("Vertex Memory (MB)", totalVertexMemory / (1024 * 1024));
 	
 	// 2) Sort visible chunks by distance
 	glm::vec2 playerXZ = glm::vec2(playerPos.x, playerPos.z);
 	std::sort(visibleChunks.begin(), visibleChunks.end(), 
-		[&playerXZ](const Ref<Chunk>& a, const Ref<Chunk>& b) {
+		[&playerXZ](const Chunk* a, const Chunk* b) {
 			return a->distanceToPoint(playerXZ) < b->distanceToPoint(playerXZ);
 		});
 	
-	// 3) Submit visible chunks that need rebuilding to mesh task manager
+	// 3) Submit visible chunks that need rebuilding to mesh task manager, the tasks still waiting
+	//    are re-prioritized for the current camera first
 	{
 		PERF_TIMER("World::meshSubmit");
-		for (const auto& chunk : visibleChunks) {
+		meshTaskManager->updatePriorities(playerXZ, frustum);
+		for (Chunk* chunk : visibleChunks) {
 			// Calculate distance for LOD determination
 			float distanceInChunks = chunk->distanceToPoint(playerXZ) / static_cast<float>(Chunk::HorizontalSize);
 			LODLevel requiredLOD = LODSelector::selectLOD(distanceInChunks);
 			
-			// Submit task for the required LOD if not generated
-			if (!chunk->isLODGenerated(requiredLOD)) {
-				// For now, always generate Full LOD first
-				// TODO: Implement proper LOD generation strategy
-				if (!chunk->isLODGenerated(LODLevel::Full)) {
-					meshTaskManager->submitChunk(chunk.get());
-				}
-			}
+			// Build the LOD this chunk is drawn at, the meshes of the other levels stay cached
+			// until the chunk changes
+			meshTaskManager->submitChunk(chunk, requiredLOD);
 		}
 	}
 	
@@ -243,37 +366,78 @@ void World::renderOpaque(glm::mat4 transform, glm::vec3 playerPos, const Frustum
 	
 	// Record mesh task statistics
 	PerformanceMonitor::getInstance().recordCount("Active Mesh Tasks", meshTaskManager->getActiveTaskCount());
+	PerformanceMonitor::getInstance().recordCount("Pending Mesh Tasks", meshTaskManager->getPendingTaskCount());
+	PerformanceMonitor::getInstance().recordCount("Mesh Tasks Cancelled", meshTaskManager->getCancelledTaskCount());
 	PerformanceMonitor::getInstance().recordCount("Completed Mesh Tasks", meshTaskManager->getCompletedTaskCount());
+	PerformanceMonitor::getInstance().recordCount("Mesh Builds Wasted", meshTaskManager->getWastedBuildCount());
+	PerformanceMonitor::getInstance().recordCount("Section Remesh Fallbacks",
+												  static_cast<int32_t>(meshTaskManager->getSectionFallbackCount()));
+	PerformanceMonitor::getInstance().recordCount("Mesh Buffer Pool Size",
+												  meshTaskManager->getBufferPool().getFreeCount());
+	PerformanceMonitor::getInstance().recordCount("Mesh Buffer Pool Misses",
+												  meshTaskManager->getBufferPool().getMissCount());
+
+	// 5) Sections the camera can see through open blocks, the transparent pass reuses them
+	int32_t sectionsReached = 0;
+	if (useCaveCulling) {
+		sectionsReached = findVisibleSections(playerPos, frustum);
+	} else {
+		chunks.forEach([](Chunk& chunk) { chunk.setVisibleSections(ChunkMeshData::AllSections); });
+	}
+	const auto occludedChunks = std::count_if(visibleChunks.begin(), visibleChunks.end(),
+											  [](const Chunk* chunk) { return chunk->getVisibleSections() == 0; });
+	PerformanceMonitor::getInstance().recordCount("Visibility Graph Sections Reached", sectionsReached);
+	PerformanceMonitor::getInstance().recordCount("Chunks Occluded", static_cast<int32_t>(occludedChunks));
 
-	int totalFrames = 32;
-	int32_t currentFrame = static_cast<int32_t>(textureAnimation) % totalFrames;
-
-	// 5) Configure shader
-	opaqueShader->bind();
+	// 6) Shaders only need their textures, the frame data is in the FrameUniforms block
 	if (textureAtlas) {
-		opaqueShader->setTexture("atlas", textureAtlas, 0);
+		textureAtlas->bindToSlot(AtlasTextureSlot);
 	}
-	opaqueShader->setUInt("textureAnimation", currentFrame);
-	opaqueShader->setVec3("lightDirection", glm::normalize(glm::vec3(1, 1, 1)));
 
-	// 6) Render visible chunks
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	// 7) Record the draws of the visible chunks, front to back
+	static RenderQueue renderQueue;
+	renderQueue.clear();
+
+	int32_t solidVerticesSubmitted = 0;
+	int32_t solidVerticesTotal = 0;
+	for (Chunk* chunk : visibleChunks) {
+		chunk->markUsed();
 
-	for (const auto& chunk : visibleChunks) {
 		// Select appropriate LOD based on distance
 		float distanceInChunks = chunk->distanceToPoint(playerXZ) / static_cast<float>(Chunk::HorizontalSize);
 		chunk->selectLOD(distanceInChunks);
-		
-		chunk->setShader(opaqueShader);
 		chunk->setUseAmbientOcclusion(useAmbientOcclusion);
 
-		// Render opaque blocks
-		chunk->renderOpaque(transform, frustum);
+		// Opaque blocks, without the faces turned away from the camera. Chunks still meshed in
+		// the other format are drawn with its shader until their new mesh arrives.
+		const auto format = static_cast<uint8_t>(chunk->getMeshFormat());
+		solidVerticesSubmitted +=
+			chunk->recordSolidDraws(playerPos, renderQueue, {RenderQueue::Pass::opaque, format, RenderQueue::DefaultState});
+		solidVerticesTotal += chunk->getSolidVertexCount();
 
-		// Rendu des blocs "semi-transparents" (ex: verre) qui se dessinent aussi dans ce pass
-		chunk->renderSemiTransparent(transform, frustum);
+		// Blocs "semi-transparents" (ex: verre) qui se dessinent aussi dans ce pass
+		chunk->recordSemiTransparentDraws(renderQueue, {RenderQueue::Pass::opaque, format, RenderQueue::NoCulling});
 	}
+	PerformanceMonitor::getInstance().recordCount("Solid Vertices Submitted", solidVerticesSubmitted);
+	PerformanceMonitor::getInstance().recordCount("Solid Vertices Backface Rejected",
+												  solidVerticesTotal - solidVerticesSubmitted);
+
+	// 8) One multi-draw per shader and state
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	ChunkRenderBackend backend(getChunkShaders(), meshBuffers);
+	renderQueue.execute(backend);
+	recordRenderQueueStatistics("Opaque", renderQueue.getStatistics());
+
+	// Buffer of the current format, the other one only holds meshes waiting to be rebuilt
+	const ChunkMegaBuffer& meshBuffer = getMeshBuffer(meshFormat);
+	const ChunkBufferAllocator& allocator = meshBuffer.getAllocator();
+	PerformanceMonitor::getInstance().recordCount(
+		"Chunk Mega Buffer Capacity (MB)",
+		static_cast<size_t>(allocator.getCapacity()) * meshBuffer.getElementSize() / (1024 * 1024));
+	PerformanceMonitor::getInstance().recordCount("Chunk Mega Buffer Free Blocks", allocator.getFreeBlockCount());
+	PerformanceMonitor::getInstance().recordCount("Chunk Mega Buffer Relocations", meshBuffer.getRelocationCount());
 
 	// Rendu additionnel : behaviors opaques (ex: particules cubiques)
 	for (const auto& behavior : behaviors) {
@@ -283,12 +447,25 @@ void World::renderOpaque(glm::mat4 transform, glm::vec3 playerPos, const Frustum
 	glDisable(GL_BLEND);
 }
 
-void World::renderTransparent(glm::mat4 transform,
-							  glm::vec3 playerPos,
-							  const Frustum& frustum,
-							  float zNear,
-							  float zFar,
-							  const Ref<Framebuffer>& opaqueRender) {
+void World::recordRenderQueueStatistics(const std::string& pass, const RenderQueue::Statistics& statistics) {
+	PerformanceMonitor::getInstance().recordCount(pass + " Draw Commands", statistics.commands);
+	PerformanceMonitor::getInstance().recordCount(pass + " Draw Calls", statistics.batches);
+	PerformanceMonitor::getInstance().recordCount(pass + " Shader Changes", statistics.shaderChanges);
+	PerformanceMonitor::getInstance().recordCount(pass + " State Changes", statistics.stateChanges);
+}
+
+void World::updateFrameUniforms(const glm::mat4& viewProjection, float zNear, float zFar) {
+	FrameUniforms frameUniforms;
+	frameUniforms.viewProjection = viewProjection;
+	frameUniforms.lightDirection = glm::vec4(glm::normalize(glm::vec3(1, 1, 1)), 0);
+	frameUniforms.textureAnimation = static_cast<uint32_t>(textureAnimation);
+	frameUniforms.zNear = zNear;
+	frameUniforms.zFar = zFar;
+	frameUniformBuffer.bufferDynamicValue(frameUniforms);
+	frameUniformBuffer.bindBase(GL_UNIFORM_BUFFER, FrameUniforms::Binding);
+}
+
+void World::renderTransparent(glm::vec3 playerPos, const Frustum& frustum, const Ref<Framebuffer>& opaqueRender) {
 	TRACE_FUNCTION();
 
 	// 1) Préparer le framebuffer "accum + revealage"
@@ -300,21 +477,17 @@ void World::renderTransparent(glm::mat4 transform,
 	}
 
 	// 2) Use hierarchical culling from opaque pass
-	static std::vector<Ref<Chunk>> visibleChunks;
+	static std::vector<Chunk*> visibleChunks;
 	performHierarchicalCulling(frustum, visibleChunks);
 	
 	// Sort visible chunks by distance (far to near for transparency)
 	glm::vec2 playerXZ = glm::vec2(playerPos.x, playerPos.z);
 	std::sort(visibleChunks.begin(), visibleChunks.end(), 
-		[&playerXZ](const Ref<Chunk>& a, const Ref<Chunk>& b) {
+		[&playerXZ](const Chunk* a, const Chunk* b) {
 			return a->distanceToPoint(playerXZ) > b->distanceToPoint(playerXZ);
 		});
 
-	// 3) Calcul de la frame courante (même totalFrames = 8, par ex)
-	int totalFrames = 8;
-	int32_t currentFrame = static_cast<int32_t>(textureAnimation) % totalFrames;
-
-	// 4) Bind du FBO
+	// 3) Bind du FBO
 	window.getFramebufferStack()->push(framebuffer);
 	glEnable(GL_BLEND);
 
@@ -326,28 +499,31 @@ void World::renderTransparent(glm::mat4 transform,
 	glClear(GL_COLOR_BUFFER_BIT);
 	framebuffer->clearColorAttachment(1, glm::vec4(1));
 
-	// 5) Configure shader
-	transparentShader->bind();
+	// 4) Textures of the shaders (vertex meshes and face records), the frame data is in the
+	//    FrameUniforms block
 	if (textureAtlas) {
-		transparentShader->setTexture("atlas", textureAtlas, 0);
+		textureAtlas->bindToSlot(AtlasTextureSlot);
 	}
-	transparentShader->setUInt("textureAnimation", currentFrame);
-	transparentShader->setVec3("lightDirection", glm::normalize(glm::vec3(1, 1, 1)));
-	transparentShader->setFloat("zNear", zNear);
-	transparentShader->setFloat("zFar", zFar);
-	transparentShader->setTexture("opaqueDepth", opaqueRender->getDepthAttachment(), 1);
+	opaqueRender->getDepthAttachment()->bindToSlot(OpaqueDepthTextureSlot);
 
-	// 6) Dessin des chunks semi-transparents (ex: eau) - only visible chunks
-	for (const auto& chunk : visibleChunks) {
-		chunk->setShader(transparentShader);
+	// 5) Dessin des chunks semi-transparents (ex: eau) - only visible chunks, one multi-draw per
+	//    mesh format
+	static RenderQueue renderQueue;
+	renderQueue.clear();
+	for (Chunk* chunk : visibleChunks) {
 		chunk->setUseAmbientOcclusion(useAmbientOcclusion);
-		chunk->renderSemiTransparent(transform, frustum);
+		const auto format = static_cast<uint8_t>(chunk->getMeshFormat());
+		chunk->recordSemiTransparentDraws(renderQueue, {RenderQueue::Pass::transparent, format, RenderQueue::NoCulling});
 	}
 
+	ChunkRenderBackend backend(getChunkShaders(), meshBuffers);
+	renderQueue.execute(backend);
+	recordRenderQueueStatistics("Transparent", renderQueue.getStatistics());
+
 	// On pop pour repasser au framebuffer précédent
 	window.getFramebufferStack()->pop();
 
-	// 7) Composition finale via world_blend.frag
+	// 6) Composition finale via world_blend.frag
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	ColorRenderPass renderPass(blendShader);
 	renderPass.setTexture("accumTexture", framebuffer->getColorAttachment(0), 1);
@@ -362,6 +538,12 @@ const BlockData* World::getBlockAt(glm::ivec3 position) {
 	return getChunk(getChunkIndex(position))->getBlockAt(Chunk::toChunkCoordinates(position));
 }
 
+int32_t World::getHeightAt(glm::ivec2 columnPosition, Heightmap::Type type) {
+	const glm::ivec3 position = {columnPosition.x, 0, columnPosition.y};
+	const glm::ivec3 positionInChunk = Chunk::toChunkCoordinates(position);
+	return getChunk(getChunkIndex(position))->getHeight(positionInChunk.x, positionInChunk.z, type);
+}
+
 bool World::isValidBlockPosition(glm::ivec3 position) {
 	return Chunk::isValidPosition(position);
 }
@@ -385,7 +567,7 @@ bool World::placeBlock(BlockData block, glm::ivec3 position) {
 	chunk->placeBlock(block, positionInChunk);
 	
 	// Submit chunk for immediate rebuild
-	submitChunkForRebuild(chunk.get());
+	submitChunkForRebuild(chunk);
 
 	// Notifier qu'on a ajouté un bloc
 	for (const auto& behavior : behaviors) {
@@ -398,11 +580,12 @@ bool World::placeBlock(BlockData block, glm::ivec3 position) {
 	for (const glm::ivec3& offset : blocksAround) {
 		glm::ivec3 neighbor = offset + positionInChunk;
 		glm::ivec3 neighborWorldPosition = position + offset;
-		if (!Chunk::isInBounds(neighbor.x, neighbor.y, neighbor.z)) {
-			const auto& chunkN = getChunk(getChunkIndex(neighborWorldPosition));
-			chunkN->setDirty();
+		if (!Chunk::isInBounds(neighbor.x, neighbor.y, neighbor.z) && Chunk::isValidPosition(neighborWorldPosition)) {
+			// Only the sections of the neighbor chunk along the edited block are remeshed
+			Chunk* chunkN = getChunk(getChunkIndex(neighborWorldPosition));
+			chunkN->markSectionsDirty(Chunk::getSectionsAround(position.y));
 			// Also submit neighbor chunk for immediate rebuild
-			submitChunkForRebuild(chunkN.get());
+			submitChunkForRebuild(chunkN);
 		}
 		for (const auto& behavior : behaviors) {
 			behavior->onBlockUpdate(
@@ -418,18 +601,24 @@ glm::ivec2 World::getChunkIndex(glm::ivec3 position) {
 			position.z - Util::positiveMod(position.z, Chunk::HorizontalSize)};
 }
 
-Ref<Chunk> World::getChunk(glm::ivec2 position) {
+Chunk* World::getChunk(glm::ivec2 position) {
 	TRACE_FUNCTION();
 	if (!isChunkLoaded(position)) {
 		addChunk(position, generateOrLoadChunk(position));
 	}
-	return chunks.at(position);
+	return chunks.find(position);
 }
 
-void World::addChunk(glm::ivec2 position, const Ref<Chunk>& chunk) {
+void World::addChunk(glm::ivec2 position, Chunk& chunk) {
 	TRACE_FUNCTION();
-	chunks[position] = chunk;
-	chunk->setShader(opaqueShader);
+	// A chunk loaded on demand far from the player can alias a loaded chunk in the toroidal
+	// grid, the chunk already in the slot is unloaded first
+	if (const Chunk* occupant = chunks.getSlotOccupant(position);
+		occupant && occupant->getPosition() != position) {
+		unloadChunk(occupant->getHandle());
+	}
+	chunkTable.insert(chunk);
+	chunks.insert(chunk);
 	
 	// Add to region for hierarchical culling
 	addChunkToRegion(chunk);
@@ -440,17 +629,21 @@ void World::addChunk(glm::ivec2 position, const Ref<Chunk>& chunk) {
 		glm::ivec2 neighborPosition = position + offset;
 		if (!isChunkLoaded(neighborPosition))
 			continue;
-		chunks[neighborPosition]->setDirty();
+		chunks.find(neighborPosition)->setDirty();
 	}
 
-	// Notifier behaviors pour tous les blocs de ce chunk
+	// Notifier behaviors pour tous les blocs de ce chunk (hors sections vides)
 	for (int32_t x = 0; x < Chunk::HorizontalSize; ++x) {
 		for (int32_t y = 0; y < Chunk::VerticalSize; ++y) {
+			if (chunk.isSectionEmpty(y / ChunkSection::Size)) {
+				y += ChunkSection::Size - 1;
+				continue;
+			}
 			for (int32_t z = 0; z < Chunk::HorizontalSize; ++z) {
 				for (const auto& worldBehavior : behaviors) {
 					glm::ivec3 blockPos = {x, y, z};
 					glm::ivec3 globalPos = blockPos + glm::ivec3(position.x, 0, position.y);
-					worldBehavior->onNewBlock(globalPos, chunk->getBlockAt(blockPos), *this);
+					worldBehavior->onNewBlock(globalPos, chunk.getBlockAt(blockPos), *this);
 				}
 			}
 		}
@@ -463,24 +656,28 @@ void World::setTextureAtlas(const Ref<const Texture>& texture) {
 }
 
 const BlockData* World::getBlockAtIfLoaded(glm::ivec3 position) const {
-	glm::ivec2 index = getChunkIndex(position);
-	if (!isChunkLoaded(index)) {
+	const Chunk* chunk = chunks.find(getChunkIndex(position));
+	if (!chunk) {
 		return nullptr;
 	}
-	return chunks.at(index)->getBlockAt(Chunk::toChunkCoordinates(position));
+	return chunk->getBlockAt(Chunk::toChunkCoordinates(position));
 }
 
 bool World::isChunkLoaded(glm::ivec2 position) const {
 	return chunks.contains(position);
 }
 
+const Chunk* World::getChunkIfLoaded(glm::ivec2 position) const {
+	return chunks.find(position);
+}
+
 /**
  * @brief Adds a chunk to its corresponding region
  * 
  * @details Creates the region if it doesn't exist yet
  */
-void World::addChunkToRegion(const Ref<Chunk>& chunk) {
-	glm::ivec2 regionPos = ChunkRegion::chunkToRegionPos(chunk->getPosition());
+void World::addChunkToRegion(const Chunk& chunk) {
+	glm::ivec2 regionPos = ChunkRegion::chunkToRegionPos(chunk.getPosition());
 	
 	// Create region if it doesn't exist
 	if (!regions.contains(regionPos)) {
@@ -495,12 +692,12 @@ void World::addChunkToRegion(const Ref<Chunk>& chunk) {
  * 
  * @details Removes empty regions to save memory
  */
-void World::removeChunkFromRegion(const glm::ivec2& chunkPos) {
-	glm::ivec2 regionPos = ChunkRegion::chunkToRegionPos(chunkPos);
+void World::removeChunkFromRegion(const Chunk& chunk) {
+	glm::ivec2 regionPos = ChunkRegion::chunkToRegionPos(chunk.getPosition());
 	
 	auto it = regions.find(regionPos);
 	if (it != regions.end()) {
-		it->second->removeChunk(chunkPos);
+		it->second->removeChunk(chunk.getHandle());
 		
 		// Remove empty regions
 		if (it->second->isEmpty()) {
@@ -514,11 +711,11 @@ void World::removeChunkFromRegion(const glm::ivec2& chunkPos) {
  * 
  * @details First culls entire regions, then individual chunks within visible regions
  */
-int32_t World::performHierarchicalCulling(const Frustum& frustum, std::vector<Ref<Chunk>>& visibleChunks) {
+int32_t World::performHierarchicalCulling(const Frustum& frustum, std::vector<Chunk*>& visibleChunks) {
 	TRACE_FUNCTION();
 	
 	visibleChunks.clear();
-	visibleChunks.reserve(chunks.size());
+	visibleChunks.reserve(chunks.getChunkCount());
 	
 	int32_t chunksculled = 0;
 	int32_t regionsCulled = 0;
@@ -526,13 +723,13 @@ int32_t World::performHierarchicalCulling(const Frustum& frustum, std::vector<Re
 	// Debug: check if we have regions
 	if (regions.empty()) {
 		// Fallback: if no regions, use all chunks
-		for (const auto& [pos, chunk] : chunks) {
-			if (chunk->isVisible(frustum)) {
-				visibleChunks.push_back(chunk);
+		chunks.forEach([&](Chunk& chunk) {
+			if (chunk.isVisible(frustum)) {
+				visibleChunks.push_back(&chunk);
 			} else {
 				chunksculled++;
 			}
-		}
+		});
 		return chunksculled;
 	}
 	
@@ -546,8 +743,9 @@ int32_t World::performHierarchicalCulling(const Frustum& frustum, std::vector<Re
 		}
 		
 		// Second pass: check individual chunks in visible regions
-		for (const auto& chunk : region->getChunks()) {
-			if (chunk->isVisible(frustum)) {
+		for (ChunkHandle handle : region->getChunks()) {
+			Chunk* chunk = chunkTable.get(handle);
+			if (chunk && chunk->isVisible(frustum)) {
 				visibleChunks.push_back(chunk);
 			} else {
 				chunksculled++;
@@ -558,6 +756,64 @@ int32_t World::performHierarchicalCulling(const Frustum& frustum, std::vector<Re
 	return chunksculled;
 }
 
+int32_t World::findVisibleSections(const glm::vec3& cameraPosition, const Frustum& frustum) {
+	TRACE_FUNCTION();
+	PERF_TIMER("World::findVisibleSections");
+
+	const glm::ivec3 cameraBlock = glm::floor(cameraPosition);
+	Chunk* cameraChunk = nullptr;
+	if (cameraBlock.y >= 0 && cameraBlock.y < Chunk::VerticalSize) {
+		cameraChunk = chunks.find(getChunkIndex(cameraBlock));
+	}
+	if (!cameraChunk) {
+		chunks.forEach([](Chunk& chunk) { chunk.setVisibleSections(ChunkMeshData::AllSections); });
+		return 0;
+	}
+	chunks.forEach([](Chunk& chunk) { chunk.setVisibleSections(0); });
+
+	struct Step {
+		Chunk* chunk;
+		int32_t section;
+		int32_t entryFace;	// -1 for the section of the camera, which is seen from inside
+		uint8_t directions;	// Faces crossed since the camera, one bit per face
+	};
+	static std::vector<Step> steps;
+	steps.clear();
+
+	const int32_t cameraSection = cameraBlock.y / ChunkSection::Size;
+	cameraChunk->addVisibleSection(cameraSection);
+	steps.push_back({cameraChunk, cameraSection, -1, 0});
+	for (size_t next = 0; next < steps.size(); ++next) {
+		const Step step = steps[next];
+		const SectionConnectivity& connectivity = step.chunk->getSectionConnectivity(step.section);
+		for (int32_t face = 0; face < SectionConnectivity::FaceCount; ++face) {
+			const int32_t oppositeFace = SectionConnectivity::getOppositeFace(face);
+			if ((step.directions & (1u << oppositeFace)) != 0 ||
+				(step.entryFace >= 0 && !connectivity.isConnected(step.entryFace, face))) {
+				continue;
+			}
+
+			const glm::ivec3 direction = SectionConnectivity::getFaceDirection(face);
+			const int32_t section = step.section + direction.y;
+			if (section < 0 || section >= Chunk::SectionCount) {
+				continue;
+			}
+			Chunk* chunk = step.chunk;
+			if (direction.x != 0 || direction.z != 0) {
+				chunk = chunks.find(chunk->getPosition() + glm::ivec2(direction.x, direction.z) * Chunk::HorizontalSize);
+			}
+			if (!chunk || (chunk->getVisibleSections() & (1u << section)) != 0 ||
+				!chunk->isSectionVisible(frustum, section)) {
+				continue;
+			}
+
+			chunk->addVisibleSection(section);
+			steps.push_back({chunk, section, oppositeFace, static_cast<uint8_t>(step.directions | (1u << face))});
+		}
+	}
+	return static_cast<int32_t>(steps.size());
+}
+
 size_t World::getActiveMeshTasks() const {
 	return meshTaskManager->getActiveTaskCount();
 }
@@ -568,6 +824,6 @@ size_t World::getCompletedMeshTasks() const {
 
 void World::submitChunkForRebuild(Chunk* chunk) {
 	if (chunk && chunk->needsMeshRebuild()) {
-		meshTaskManager->submitChunk(chunk);
+		meshTaskManager->submitChunk(chunk, chunk->getCurrentLOD(), true);
 	}
 }
@@ -13,35 +13,32 @@
 #include "../Common.hpp"
 #include "../Game/Behaviors.hpp"
 #include "../Persistence/Persistence.hpp"
+#include "../Rendering/FrameUniforms.hpp"
+#include "../Rendering/RenderQueue.hpp"
 #include "../Rendering/Shaders.hpp"
 #include "../Rendering/Textures.hpp"
 #include "../Utils/Utils.hpp"
 #include "Chunk.hpp"
+#include "ChunkGrid.hpp"
 #include "ChunkRegion.hpp"
+#include "ChunkMegaBuffer.hpp"
 #include "ChunkMeshTaskManager.hpp"
+#include "ChunkPool.hpp"
+#include "ChunkTable.hpp"
 #include "WorldGenerator.hpp"
 
 #include <Frustum.h>
 
-#include <queue>
-
 class Window;
 class Assets;
 class Framebuffer;
 
-// ChunkPool for efficient chunk memory management
-class ChunkPool {
-	std::queue<std::unique_ptr<Chunk>> available;
-	static constexpr size_t MAX_SIZE = 100;
-
-   public:
-	Ref<Chunk> acquire(glm::ivec2 pos);
-	void release(const Ref<Chunk>& chunk);
-	size_t size() const { return available.size(); }
-};
-
 class World {
-	std::unordered_map<glm::ivec2, Ref<Chunk>, Util::HashVec2> chunks;
+	// Shared GPU buffer of the chunk meshes of each format, declared first: the chunks give their
+	// ranges back when destroyed
+	std::array<std::unique_ptr<ChunkMegaBuffer>, 2> meshBuffers;
+	ChunkTable chunkTable;	// Owns the loaded chunks, everything else refers to them by handle
+	ChunkGrid chunks{chunkTable};
 	std::unordered_map<glm::ivec2, std::unique_ptr<ChunkRegion>, Util::HashVec2> regions;
 	std::vector<Ref<WorldBehavior>> behaviors;
 	ChunkPool chunkPool;
@@ -51,7 +48,24 @@ class World {
 	Ref<const ShaderProgram> opaqueShader;
 	Ref<const ShaderProgram> transparentShader;
 	Ref<const ShaderProgram> blendShader;
+	// Same passes for the chunks meshed with face records, see world_faces.vert
+	Ref<const ShaderProgram> opaqueFaceShader;
+	Ref<const ShaderProgram> transparentFaceShader;
+	/**
+	 * @brief Chunk shaders by render pass and mesh format, the shader ids of the render queues
+	 *        being the mesh formats
+	 */
+	[[nodiscard]] std::array<std::array<const ShaderProgram*, 2>, 2> getChunkShaders() const {
+		return {{{opaqueShader.get(), opaqueFaceShader.get()}, {transparentShader.get(), transparentFaceShader.get()}}};
+	}
+	static void recordRenderQueueStatistics(const std::string& pass, const RenderQueue::Statistics& statistics);
+	static constexpr int32_t AtlasTextureSlot = 0;
+	static constexpr int32_t OpaqueDepthTextureSlot = 1;
+	UniformBuffer frameUniformBuffer;
 	bool useAmbientOcclusion = true;
+	bool useGreedyMeshing = false;
+	bool useCaveCulling = true;
+	ChunkMeshFormat meshFormat = ChunkMeshFormat::vertices;
 
 	Window& window;
 	Assets& assets;
@@ -60,26 +74,69 @@ class World {
 
 	const uint32_t MaxRebuildsAllowedPerFrame = 10;
 
+	// Initial capacity of the mesh buffers, in vertices and face records (12 MB and 4 MB)
+	static constexpr int32_t InitialMeshBufferVertices = 1 << 21;
+	static constexpr int32_t InitialMeshBufferFaces = 1 << 19;
+
 	int32_t viewDistance = 10;
+
+	/**
+	 * @brief Cold chunk compression: chunks neither rendered nor accessed for coldChunkIdleTime
+	 *        seconds get their block storage compressed, at most coldChunkCompressionBudget per
+	 *        frame (0 disables it). Chunks closer than ColdChunkMinDistance never get cold.
+	 */
+	float coldChunkIdleTime = 60.0f;
+	int32_t coldChunkCompressionBudget = 2;
+	static constexpr float ColdChunkMinDistance = 2.0f * Chunk::HorizontalSize;
 	float textureAnimation = 0;
 	static constexpr float TextureAnimationSpeed = 2;
 
-	Ref<Chunk> generateOrLoadChunk(glm::ivec2 position);
-	void unloadChunk(const Ref<Chunk>& chunk);
+	Chunk& generateOrLoadChunk(glm::ivec2 position);
+	void unloadChunk(ChunkHandle handle);
+	void unloadChunks(const std::vector<ChunkHandle>& chunksToUnload);
+
+	/**
+	 * @brief Radius of the chunk grid for a view distance
+	 *
+	 * @details Chunks are unloaded a bit beyond the view distance, and chunks can be loaded on
+	 *          demand just outside of it (block updates at the border), hence the extra margin.
+	 */
+	static int32_t getGridRadius(int32_t distance) { return distance + 2; }
+
+	/**
+	 * @brief Number of chunks the grid can hold for a view distance, used to size the chunk pool
+	 */
+	static size_t getGridCapacity(int32_t distance) {
+		const size_t gridSize = 2 * getGridRadius(distance) + 1;
+		return gridSize * gridSize;
+	}
+	void compressColdChunks(glm::vec2 playerXZ, float deltaTime);
 	void sortChunkIndices(glm::vec3 playerPos, const Ref<ChunkIndexVector>& chunkIndices);
 	void rebuildChunks(const Ref<ChunkIndexVector>& chunkIndices, const Frustum& frustum);
 	
 	/**
 	 * @brief Manages regions for hierarchical culling
 	 */
-	void addChunkToRegion(const Ref<Chunk>& chunk);
-	void removeChunkFromRegion(const glm::ivec2& chunkPos);
+	void addChunkToRegion(const Chunk& chunk);
+	void removeChunkFromRegion(const Chunk& chunk);
 	
 	/**
 	 * @brief Performs hierarchical frustum culling
 	 * @return Number of chunks culled
 	 */
-	int32_t performHierarchicalCulling(const Frustum& frustum, std::vector<Ref<Chunk>>& visibleChunks);
+	int32_t performHierarchicalCulling(const Frustum& frustum, std::vector<Chunk*>& visibleChunks);
+
+	/**
+	 * @brief Sets the visible sections of every chunk by walking the sections from the one of the
+	 *        camera, see SectionConnectivity
+	 *
+	 * @details A section is entered through one face and left through the faces connected to
+	 *          it, never going back in a direction opposite to one already taken, and only into
+	 *          sections inside the frustum. Everything is visible when the camera is outside of
+	 *          the loaded world.
+	 * @return Number of sections reached
+	 */
+	int32_t findVisibleSections(const glm::vec3& cameraPosition, const Frustum& frustum);
 
    public:
 	World(Window& window,
@@ -87,40 +144,86 @@ class World {
 		  const Ref<Persistence>& persistence,
 		  std::vector<Ref<WorldBehavior>> behaviors,
 		  int32_t seed);
+	~World();
 	Window& getWindow() { return window; }
 	const Window& getWindow() const { return window; }
 	Assets& getAssets() { return assets; }
 	const Assets& getAssets() const { return assets; }
 
-	Ref<Chunk> getChunk(glm::ivec2 position);
-	void addChunk(glm::ivec2 position, const Ref<Chunk>& chunk);
+	Chunk* getChunk(glm::ivec2 position);
+	void addChunk(glm::ivec2 position, Chunk& chunk);
 	[[nodiscard]] static glm::ivec2 getChunkIndex(glm::ivec3 position);
 
 	[[nodiscard]] int32_t getViewDistance() const { return viewDistance; };
-	void setViewDistance(int32_t distance) { viewDistance = distance; };
+	void setViewDistance(int32_t distance);
+
+	[[nodiscard]] float getColdChunkIdleTime() const { return coldChunkIdleTime; }
+	void setColdChunkIdleTime(float seconds) { coldChunkIdleTime = std::max(seconds, 0.0f); }
+	[[nodiscard]] int32_t getColdChunkCompressionBudget() const { return coldChunkCompressionBudget; }
+	void setColdChunkCompressionBudget(int32_t budget) { coldChunkCompressionBudget = std::max(budget, 0); }
 
 	[[nodiscard]] bool getUseAmbientOcclusion() const { return useAmbientOcclusion; };
 	void setUseAmbientOcclusion(bool enabled) { useAmbientOcclusion = enabled; };
 
+	[[nodiscard]] bool getUseGreedyMeshing() const { return useGreedyMeshing; };
+
+	/**
+	 * @brief Switches between one quad per block face and merged quads, every chunk is remeshed
+	 */
+	void setUseGreedyMeshing(bool enabled);
+
+	[[nodiscard]] bool getUseCaveCulling() const { return useCaveCulling; };
+
+	/**
+	 * @brief Only draws the sections the camera can see through open blocks, see
+	 *        findVisibleSections
+	 */
+	void setUseCaveCulling(bool enabled) { useCaveCulling = enabled; };
+
+	[[nodiscard]] ChunkMeshFormat getMeshFormat() const { return meshFormat; };
+
+	/**
+	 * @brief Buffer the chunk meshes of a format are allocated in, see ChunkMegaBuffer
+	 * @details GPU storage only, it is handed out by the const world to the mesh tasks
+	 */
+	[[nodiscard]] ChunkMegaBuffer& getMeshBuffer(ChunkMeshFormat format) const {
+		return *meshBuffers[static_cast<size_t>(format)];
+	}
+
+	/**
+	 * @brief Switches between vertex meshes and face records pulled by the vertex shader,
+	 *        every chunk is remeshed
+	 */
+	void setMeshFormat(ChunkMeshFormat format);
+
 	[[nodiscard]] const BlockData* getBlockAt(glm::ivec3 position);
 	[[nodiscard]] const BlockData* getBlockAtIfLoaded(glm::ivec3 position) const;
+
+	/**
+	 * @brief Height of the highest block of a world column (x, z), loading its chunk if needed
+	 * @return Heightmap::Empty if the column contains no matching block
+	 */
+	[[nodiscard]] int32_t getHeightAt(glm::ivec2 columnPosition,
+									  Heightmap::Type type = Heightmap::Type::nonAir);
 	[[nodiscard]] bool isChunkLoaded(glm::ivec2 position) const;
+	[[nodiscard]] const Chunk* getChunkIfLoaded(glm::ivec2 position) const;
 	bool placeBlock(BlockData block, glm::ivec3 position);
 
 	void update(const glm::vec3& playerPosition, float deltaTime);
-	void renderTransparent(glm::mat4 transform,
-						   glm::vec3 playerPos,
-						   const Frustum& frustum,
-						   float zNear,
-						   float zFar,
-						   const Ref<Framebuffer>& opaqueRender);
+
+	/**
+	 * @brief Writes the FrameUniforms block read by the world shaders, once per frame before
+	 *        the render passes
+	 */
+	void updateFrameUniforms(const glm::mat4& viewProjection, float zNear, float zFar);
+	void renderTransparent(glm::vec3 playerPos, const Frustum& frustum, const Ref<Framebuffer>& opaqueRender);
 
 	void renderOpaque(glm::mat4 transform, glm::vec3 playerPos, const Frustum& frustum);
 	static bool isValidBlockPosition(glm::ivec3 position);
 	void setTextureAtlas(const Ref<const Texture>& texture);
 
 	// ChunkPool stats
-	size_t getChunkPoolSize() const { return chunkPool.size(); }
+	size_t getChunkPoolSize() const { return chunkPool.getFreeCount(); }
 	
 	// Mesh task manager stats
 	size_t getActiveMeshTasks() const;
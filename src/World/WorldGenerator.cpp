@@ -8,21 +8,41 @@ WorldGenerator::WorldGenerator(int32_t seed) : seed(seed), noise(seed) {
 	noise.SetFractalType(FastNoiseLite::FractalType_FBm);
 }
 
-void WorldGenerator::populateChunk(const Ref<Chunk>& chunkRef) {
+void WorldGenerator::populateChunk(Chunk& chunk) {
 	TRACE_FUNCTION();
-	Chunk& chunk = *chunkRef;
 
 	glm::ivec2 worldPosition = chunk.getPosition();
 	glm::vec2 position = worldPosition;
 
+	// Compute every column height first so uniform sections can be filled in one go
+	std::array<int32_t, Chunk::HorizontalSize * Chunk::HorizontalSize> heights;
+	int32_t minHeight = Chunk::VerticalSize;
 	for (int32_t x = 0; x < Chunk::HorizontalSize; x++) {
 		for (int32_t z = 0; z < Chunk::HorizontalSize; z++) {
 			float noiseX = (position.x + static_cast<float>(x));
 			float noiseY = (position.y + static_cast<float>(z));
 			float noiseValue = noise.GetNoise(noiseX, noiseY) / WorldConstants::Noise::NormalizeScale + WorldConstants::Noise::NormalizeOffset;
 			int32_t height = WorldConstants::Terrain::BaseHeight + static_cast<int32_t>(noiseValue * WorldConstants::Terrain::HeightVariation);
+			heights[x + z * Chunk::HorizontalSize] = height;
+			minHeight = std::min(minHeight, height);
+		}
+	}
+
+	// Blocks at least SubsurfaceLayerDepth below the surface are always stone, so every
+	// section lying entirely under that depth is uniform. Sections above the terrain and the
+	// sea level are never touched and stay empty.
+	const int32_t stoneTop = minHeight - WorldConstants::Layers::SubsurfaceLayerDepth;
+	const int32_t uniformSections = std::max(0, (stoneTop + 1) / ChunkSection::Size);
+	for (int32_t section = 0; section < uniformSections; section++) {
+		chunk.fillSection(section, BlockData::BlockType::stone);
+	}
+	const int32_t firstColumnY = uniformSections * ChunkSection::Size;
+
+	for (int32_t x = 0; x < Chunk::HorizontalSize; x++) {
+		for (int32_t z = 0; z < Chunk::HorizontalSize; z++) {
+			int32_t height = heights[x + z * Chunk::HorizontalSize];
 
-			for (int32_t y = 0; y < height; y++) {
+			for (int32_t y = firstColumnY; y < height; y++) {
 				int32_t dy = height - y;
 				BlockData::BlockType blockToPlace = BlockData::BlockType::stone;
 
@@ -22,5 +22,5 @@ class WorldGenerator {
 	WorldGenerator(int32_t seed);
 	[[nodiscard]] int32_t getSeed() const { return seed; };
 
-	void populateChunk(const Ref<Chunk>& chunkRef);
+	void populateChunk(Chunk& chunk);
 };
\ No newline at end of file
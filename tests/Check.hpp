@@ -0,0 +1,34 @@
+/**
+ * @file Check.hpp
+ * @brief Minimal checks shared by the tests, without a test framework
+ *
+ * @details A failed CHECK prints its expression and location and the test keeps going, so one
+ *          run reports every failure. A test returns Test::report() from main: 0 when every check
+ *          passed, which is what ctest expects.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+namespace Test {
+	inline int32_t checks = 0;
+	inline int32_t failures = 0;
+
+	inline bool check(bool condition, const char* expression, const char* file, int32_t line) {
+		++checks;
+		if (!condition) {
+			++failures;
+			std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+		}
+		return condition;
+	}
+
+	inline int report() {
+		std::printf("%d checks, %d failed\n", checks, failures);
+		return failures == 0 ? 0 : 1;
+	}
+}
+
+#define CHECK(condition) Test::check((condition), #condition, __FILE__, __LINE__)
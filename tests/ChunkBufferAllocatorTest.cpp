@@ -0,0 +1,237 @@
+/**
+ * @file ChunkBufferAllocatorTest.cpp
+ * @brief Bookkeeping of the shared chunk mesh buffer ranges, without a GL context
+ *
+ * @details The buffer is simulated by a vector in which each allocation writes its id, so that
+ *          the moves returned by defragment can be replayed and the live data checked.
+ */
+
+#include "../src/World/ChunkBufferAllocator.hpp"
+#include "Check.hpp"
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+namespace {
+	using Buffer = std::vector<int32_t>;
+
+	void write(Buffer& buffer, const ChunkBufferAllocator& allocator, int32_t allocation) {
+		std::fill_n(buffer.begin() + allocator.getOffset(allocation), allocator.getSize(allocation), allocation);
+	}
+
+	bool holds(const Buffer& buffer, const ChunkBufferAllocator& allocator, int32_t allocation) {
+		const auto first = buffer.begin() + allocator.getOffset(allocation);
+		return std::all_of(first, first + allocator.getSize(allocation),
+						   [allocation](int32_t value) { return value == allocation; });
+	}
+
+	/**
+	 * @brief Applies the moves of a defragmentation to a new buffer, as ChunkMegaBuffer does
+	 */
+	Buffer replay(const Buffer& buffer, const std::vector<ChunkBufferAllocator::Move>& moves, int32_t capacity) {
+		Buffer moved(capacity, -1);
+		for (const ChunkBufferAllocator::Move& move : moves) {
+			std::copy_n(buffer.begin() + move.from, move.size, moved.begin() + move.to);
+		}
+		return moved;
+	}
+
+	void testCoalescing() {
+		ChunkBufferAllocator allocator(100);
+		const int32_t a = allocator.allocate(10);
+		const int32_t b = allocator.allocate(20);
+		const int32_t c = allocator.allocate(30);
+		CHECK(allocator.getOffset(a) == 0);
+		CHECK(allocator.getOffset(b) == 10);
+		CHECK(allocator.getOffset(c) == 30);
+		CHECK(allocator.getUsedSize() == 60);
+		CHECK(allocator.getFreeBlockCount() == 1);
+
+		// A hole between two live ranges stays on its own
+		allocator.free(b);
+		CHECK(allocator.getFreeBlockCount() == 2);
+		CHECK(allocator.getLargestFreeBlock() == 40);
+
+		// Freeing its left neighbor merges with it, then the right one joins the tail block
+		allocator.free(a);
+		CHECK(allocator.getFreeBlockCount() == 2);
+		CHECK(allocator.getLargestFreeBlock() == 40);
+		const int32_t merged = allocator.allocate(30);
+		CHECK(allocator.getOffset(merged) == 0);
+		allocator.free(merged);
+
+		allocator.free(c);
+		CHECK(allocator.getFreeBlockCount() == 1);
+		CHECK(allocator.getLargestFreeBlock() == 100);
+		CHECK(allocator.getUsedSize() == 0);
+		CHECK(allocator.getAllocationCount() == 0);
+	}
+
+	void testBestFit() {
+		// Free blocks of 10, 30 and 20 elements between live ranges, then the 20 element tail
+		ChunkBufferAllocator allocator(100);
+		std::vector<int32_t> ranges;
+		for (int32_t size : {10, 5, 30, 5, 20, 10}) {
+			ranges.push_back(allocator.allocate(size));
+		}
+		allocator.free(ranges[0]);
+		allocator.free(ranges[2]);
+		allocator.free(ranges[4]);
+		CHECK(allocator.getFreeBlockCount() == 4);
+
+		// The smallest block that fits is taken, the lowest offset among equal sizes
+		const int32_t fifteen = allocator.allocate(15);
+		CHECK(allocator.getOffset(fifteen) == 50);
+		const int32_t ten = allocator.allocate(10);
+		CHECK(allocator.getOffset(ten) == 0);
+		const int32_t twenty = allocator.allocate(20);
+		CHECK(allocator.getOffset(twenty) == 80);
+		const int32_t thirty = allocator.allocate(30);
+		CHECK(allocator.getOffset(thirty) == 15);
+	}
+
+	void testExhaustion() {
+		ChunkBufferAllocator allocator(64);
+		const int32_t a = allocator.allocate(30);
+		const int32_t b = allocator.allocate(30);
+		CHECK(a != ChunkBufferAllocator::InvalidAllocation);
+		CHECK(b != ChunkBufferAllocator::InvalidAllocation);
+		CHECK(allocator.allocate(5) == ChunkBufferAllocator::InvalidAllocation);
+
+		// Enough free elements in total, but no single block that fits
+		allocator.free(a);
+		CHECK(allocator.getFreeSize() == 34);
+		CHECK(allocator.allocate(31) == ChunkBufferAllocator::InvalidAllocation);
+		CHECK(allocator.allocate(30) != ChunkBufferAllocator::InvalidAllocation);
+		CHECK(allocator.getUsedSize() == 60);
+	}
+
+	void testDefragment() {
+		ChunkBufferAllocator allocator(200);
+		Buffer buffer(200, -1);
+		std::vector<int32_t> live;
+		for (int32_t i = 0; i < 10; ++i) {
+			const int32_t allocation = allocator.allocate(5 + i * 3);
+			write(buffer, allocator, allocation);
+			live.push_back(allocation);
+		}
+		for (size_t i = 0; i < live.size(); i += 3) {
+			allocator.free(live[i]);
+		}
+		std::erase_if(live, [&](int32_t allocation) { return allocator.getSize(allocation) == 0; });
+		CHECK(allocator.getFreeBlockCount() > 1);
+
+		const int32_t usedSize = allocator.getUsedSize();
+		std::map<int32_t, int32_t> sizes;
+		for (int32_t allocation : live) {
+			sizes[allocation] = allocator.getSize(allocation);
+		}
+
+		const std::vector<ChunkBufferAllocator::Move> moves = allocator.defragment(400);
+		CHECK(moves.size() == live.size());
+		CHECK(allocator.getCapacity() == 400);
+		CHECK(allocator.getUsedSize() == usedSize);
+		CHECK(allocator.getFreeBlockCount() == 1);
+		CHECK(allocator.getLargestFreeBlock() == 400 - usedSize);
+
+		// Ranges are packed from 0 in their previous offset order, each move matching its id
+		int32_t packedOffset = 0;
+		int32_t previousFrom = -1;
+		for (const ChunkBufferAllocator::Move& move : moves) {
+			CHECK(move.from > previousFrom);
+			CHECK(move.to == packedOffset);
+			CHECK(move.size == sizes[move.allocation]);
+			CHECK(allocator.getOffset(move.allocation) == move.to);
+			CHECK(allocator.getSize(move.allocation) == move.size);
+			previousFrom = move.from;
+			packedOffset += move.size;
+		}
+		CHECK(packedOffset == usedSize);
+
+		const Buffer moved = replay(buffer, moves, allocator.getCapacity());
+		for (int32_t allocation : live) {
+			CHECK(holds(moved, allocator, allocation));
+		}
+
+		// The packed buffer keeps working
+		const int32_t next = allocator.allocate(400 - usedSize);
+		CHECK(allocator.getOffset(next) == usedSize);
+		CHECK(allocator.getFreeBlockCount() == 0);
+	}
+
+	/**
+	 * @brief Random allocations and frees with a defragmentation whenever nothing fits, as the
+	 *        mesh buffers do, checking that live ranges never overlap nor lose their data
+	 */
+	void testRandomOperations() {
+		std::mt19937 random(1);
+		ChunkBufferAllocator allocator(1 << 14);
+		Buffer buffer(allocator.getCapacity(), -1);
+		std::map<int32_t, int32_t> live;
+		int32_t defragmentations = 0;
+
+		const auto checkLiveRanges = [&] {
+			std::map<int32_t, int32_t> byOffset;
+			int32_t usedSize = 0;
+			for (const auto& [allocation, size] : live) {
+				CHECK(allocator.getSize(allocation) == size);
+				CHECK(holds(buffer, allocator, allocation));
+				byOffset[allocator.getOffset(allocation)] = size;
+				usedSize += size;
+			}
+			int32_t end = 0;
+			for (const auto& [offset, size] : byOffset) {
+				CHECK(offset >= end);
+				end = offset + size;
+			}
+			CHECK(end <= allocator.getCapacity());
+			CHECK(usedSize == allocator.getUsedSize());
+		};
+
+		for (int32_t step = 0; step < 20000; ++step) {
+			if (live.empty() || random() % 3 != 0) {
+				const auto size = static_cast<int32_t>(1 + random() % 500);
+				int32_t allocation = allocator.allocate(size);
+				if (allocation == ChunkBufferAllocator::InvalidAllocation) {
+					CHECK(allocator.getLargestFreeBlock() < size);
+					const int32_t capacity = allocator.getCapacity();
+					const int32_t newCapacity = allocator.getUsedSize() + size > capacity * 3 / 4 ? capacity * 2 : capacity;
+					buffer = replay(buffer, allocator.defragment(newCapacity), newCapacity);
+					++defragmentations;
+					allocation = allocator.allocate(size);
+					CHECK(allocation != ChunkBufferAllocator::InvalidAllocation);
+				}
+				live[allocation] = size;
+				write(buffer, allocator, allocation);
+			} else {
+				auto it = live.begin();
+				std::advance(it, random() % live.size());
+				allocator.free(it->first);
+				live.erase(it);
+			}
+
+			if (step % 500 == 0) {
+				checkLiveRanges();
+			}
+		}
+		checkLiveRanges();
+		CHECK(defragmentations > 0);
+
+		for (const auto& [allocation, size] : live) {
+			allocator.free(allocation);
+		}
+		CHECK(allocator.getUsedSize() == 0);
+		CHECK(allocator.getFreeBlockCount() == 1);
+		CHECK(allocator.getLargestFreeBlock() == allocator.getCapacity());
+	}
+}
+
+int main() {
+	testCoalescing();
+	testBestFit();
+	testExhaustion();
+	testDefragment();
+	testRandomOperations();
+	return Test::report();
+}
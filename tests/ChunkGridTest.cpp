@@ -0,0 +1,125 @@
+/**
+ * @file ChunkGridTest.cpp
+ * @brief Toroidal grid of the loaded chunks
+ *
+ * @details The grid must find chunks at negative coordinates through the wrapped slots, and
+ *          report the chunks that leave its window when it moves or shrinks.
+ */
+
+#include "../src/World/Chunk.hpp"
+#include "../src/World/ChunkGrid.hpp"
+#include "../src/World/ChunkTable.hpp"
+#include "Check.hpp"
+
+#include <algorithm>
+
+namespace {
+	constexpr int32_t ChunkSize = Chunk::HorizontalSize;
+
+	/**
+	 * @brief Chunks created on demand, kept alive for the whole test like the ChunkPool does
+	 */
+	struct Chunks {
+		std::vector<std::unique_ptr<Chunk>> storage;
+
+		Chunk& create(const glm::ivec2& chunkIndex) {
+			storage.push_back(std::make_unique<Chunk>(chunkIndex * ChunkSize));
+			return *storage.back();
+		}
+	};
+
+	/**
+	 * @brief Stores a new chunk in the table and the grid for every chunk index of a window
+	 */
+	void fillWindow(ChunkGrid& grid, ChunkTable& table, Chunks& chunks, const glm::ivec2& center, int32_t radius) {
+		for (int32_t z = center.y - radius; z <= center.y + radius; ++z) {
+			for (int32_t x = center.x - radius; x <= center.x + radius; ++x) {
+				Chunk& chunk = chunks.create({x, z});
+				table.insert(chunk);
+				CHECK(grid.getSlotOccupant(chunk.getPosition()) == nullptr);
+				grid.insert(chunk);
+			}
+		}
+	}
+
+	void testNegativeCoordinates() {
+		// A window that only covers negative chunk indices, the slots wrap around
+		ChunkTable table;
+		Chunks chunks;
+		ChunkGrid grid(table, 2);
+		const glm::ivec2 center(-7, -12);
+		grid.recenter(center * ChunkSize);
+		fillWindow(grid, table, chunks, center, 2);
+		CHECK(grid.getChunkCount() == 25);
+
+		for (const std::unique_ptr<Chunk>& chunk : chunks.storage) {
+			CHECK(grid.find(chunk->getPosition()) == chunk.get());
+			CHECK(grid.isInWindow(chunk->getPosition()));
+
+			// The same slot one grid size away holds this chunk, not the aliased position
+			const glm::ivec2 aliased = chunk->getPosition() + glm::ivec2(5, -5) * ChunkSize;
+			CHECK(grid.getSlotOccupant(aliased) == chunk.get());
+			CHECK(grid.find(aliased) == nullptr);
+			CHECK(!grid.isInWindow(aliased));
+		}
+
+		// Blocks inside a chunk with negative coordinates belong to that chunk
+		CHECK(grid.isInWindow(center * ChunkSize + glm::ivec2(ChunkSize - 1)));
+		CHECK(!grid.isInWindow((center + glm::ivec2(3, 0)) * ChunkSize));
+		CHECK(grid.isInWindow((center - glm::ivec2(2)) * ChunkSize));
+	}
+
+	void testRecenter() {
+		ChunkTable table;
+		Chunks chunks;
+		ChunkGrid grid(table, 1);
+		fillWindow(grid, table, chunks, {0, 0}, 1);
+		CHECK(grid.recenter(glm::ivec2(5, 7)).empty());
+
+		// Moving one chunk towards -x evicts the x = 1 column, which stays until removed
+		std::vector<ChunkHandle> evicted = grid.recenter(glm::ivec2(-1, 0));
+		CHECK(evicted.size() == 3);
+		for (ChunkHandle handle : evicted) {
+			const Chunk* chunk = table.get(handle);
+			CHECK(chunk && chunk->getPosition().x == ChunkSize);
+			CHECK(chunk && grid.find(chunk->getPosition()) == chunk);
+		}
+
+		// The entering x = -2 column maps onto the slots of the evicted chunks
+		for (ChunkHandle handle : evicted) {
+			const glm::ivec2 position = table.get(handle)->getPosition();
+			const glm::ivec2 entering = position - glm::ivec2(3 * ChunkSize, 0);
+			CHECK(grid.getSlotOccupant(entering) == table.get(handle));
+			CHECK(grid.remove(position));
+			table.remove(handle);
+
+			Chunk& chunk = chunks.create(entering / ChunkSize);
+			table.insert(chunk);
+			grid.insert(chunk);
+			CHECK(grid.find(entering) == &chunk);
+			CHECK(grid.find(position) == nullptr);
+		}
+		CHECK(grid.getChunkCount() == 9);
+
+		// A jump across the whole window evicts every chunk
+		evicted = grid.recenter(glm::ivec2(-40, 90) * ChunkSize);
+		CHECK(evicted.size() == 9);
+
+		// Shrinking the window returns the chunks that no longer fit
+		ChunkGrid largeGrid(table, 2);
+		Chunks largeChunks;
+		fillWindow(largeGrid, table, largeChunks, {0, 0}, 2);
+		const std::vector<ChunkHandle> removed = largeGrid.resize(1);
+		CHECK(removed.size() == 16);
+		CHECK(largeGrid.getChunkCount() == 9);
+		CHECK(std::all_of(removed.begin(), removed.end(), [&](ChunkHandle handle) {
+			return !largeGrid.isInWindow(table.get(handle)->getPosition());
+		}));
+	}
+}
+
+int main() {
+	testNegativeCoordinates();
+	testRecenter();
+	return Test::report();
+}
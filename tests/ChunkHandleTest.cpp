@@ -0,0 +1,110 @@
+/**
+ * @file ChunkHandleTest.cpp
+ * @brief Generation-checked chunk handles of the chunk table
+ *
+ * @details A handle kept after its chunk was unloaded must never resolve again, whatever the
+ *          chunk later stored in its slot.
+ */
+
+#include "../src/World/Chunk.hpp"
+#include "../src/World/ChunkTable.hpp"
+#include "Check.hpp"
+
+namespace {
+	constexpr int32_t ChunkSize = Chunk::HorizontalSize;
+
+	/**
+	 * @brief Chunks created on demand, kept alive for the whole test like the ChunkPool does
+	 */
+	struct Chunks {
+		std::vector<std::unique_ptr<Chunk>> storage;
+
+		Chunk& create(const glm::ivec2& chunkIndex) {
+			storage.push_back(std::make_unique<Chunk>(chunkIndex * ChunkSize));
+			return *storage.back();
+		}
+	};
+
+	void testStaleHandles() {
+		ChunkTable table;
+		Chunks chunks;
+		Chunk& first = chunks.create({0, 0});
+		const ChunkHandle firstHandle = table.insert(first);
+		CHECK(firstHandle.isValid());
+		CHECK(first.getHandle() == firstHandle);
+		CHECK(table.get(firstHandle) == &first);
+
+		CHECK(table.remove(firstHandle) == &first);
+		CHECK(!first.getHandle().isValid());
+		CHECK(table.get(firstHandle) == nullptr);
+		CHECK(table.getChunkCount() == 0);
+
+		// The next chunk reuses the slot with a new generation
+		Chunk& second = chunks.create({1, 0});
+		const ChunkHandle secondHandle = table.insert(second);
+		CHECK(secondHandle.getIndex() == firstHandle.getIndex());
+		CHECK(secondHandle.getGeneration() != firstHandle.getGeneration());
+		CHECK(table.get(firstHandle) == nullptr);
+		CHECK(table.get(secondHandle) == &second);
+
+		// Removing through the stale handle leaves the new chunk alone
+		CHECK(table.remove(firstHandle) == nullptr);
+		CHECK(table.get(secondHandle) == &second);
+		CHECK(table.getChunkCount() == 1);
+	}
+
+	void testGenerationLimit() {
+		// One slot reused until it runs out of generations
+		ChunkTable table;
+		Chunks chunks;
+		Chunk& chunk = chunks.create({0, 0});
+		std::vector<ChunkHandle> staleHandles;
+		for (uint32_t generation = 0; generation <= ChunkHandle::GenerationMask; ++generation) {
+			const ChunkHandle handle = table.insert(chunk);
+			CHECK(handle.getIndex() == 0 && handle.getGeneration() == generation);
+			table.remove(handle);
+			staleHandles.push_back(handle);
+		}
+
+		// The retired slot is not handed out again, and no generation of it resolves
+		Chunk& other = chunks.create({1, 0});
+		const ChunkHandle otherHandle = table.insert(other);
+		CHECK(otherHandle.getIndex() == 1);
+		bool anyResolves = false;
+		for (ChunkHandle handle : staleHandles) {
+			anyResolves = anyResolves || table.get(handle) != nullptr;
+		}
+		CHECK(!anyResolves);
+		for (uint32_t generation = 0; generation <= ChunkHandle::GenerationMask; ++generation) {
+			anyResolves = anyResolves || table.get(ChunkHandle(0, generation)) != nullptr;
+		}
+		CHECK(!anyResolves);
+		CHECK(table.get(otherHandle) == &other);
+	}
+
+	void testInvalidHandle() {
+		ChunkTable table;
+		Chunks chunks;
+		CHECK(!ChunkHandle().isValid());
+		CHECK(table.get(ChunkHandle()) == nullptr);
+
+		// Not even when the table is full of live chunks of every generation
+		for (int32_t i = 0; i < 8; ++i) {
+			table.remove(table.insert(chunks.create({i, 0})));
+			table.insert(chunks.create({i, 1}));
+		}
+		CHECK(table.get(ChunkHandle()) == nullptr);
+		CHECK(table.remove(ChunkHandle()) == nullptr);
+		CHECK(!ChunkHandle(ChunkHandle::IndexMask, 0).isValid());
+		CHECK(ChunkHandle(ChunkHandle::MaxIndex, ChunkHandle::GenerationMask).isValid());
+		CHECK(table.get(ChunkHandle(ChunkHandle::MaxIndex, 0)) == nullptr);
+		CHECK(table.getChunkCount() == 8);
+	}
+}
+
+int main() {
+	testStaleHandles();
+	testGenerationLimit();
+	testInvalidHandle();
+	return Test::report();
+}
@@ -0,0 +1,176 @@
+/**
+ * @file ChunkHeightmapTest.cpp
+ * @brief Solid and non-air heightmaps kept up to date by placeBlock and fillSection
+ *
+ * @details The heightmaps are only rescanned below a removed top block, skipping empty and
+ *          uniform sections, so after each edit they are compared with a plain scan of the
+ *          column.
+ */
+
+#include "../src/World/Chunk.hpp"
+#include "../src/World/WorldGenerator.hpp"
+#include "Check.hpp"
+
+#include <random>
+
+namespace {
+	using BlockType = BlockData::BlockType;
+	using Type = Heightmap::Type;
+
+	int32_t scanColumn(const Chunk& chunk, int32_t x, int32_t z, Type type) {
+		for (int32_t y = Chunk::VerticalSize - 1; y >= 0; --y) {
+			const BlockData::BlockClass blockClass = chunk.getBlockAt({x, y, z})->blockClass;
+			if (type == Type::solid ? blockClass == BlockData::BlockClass::solid
+									: blockClass != BlockData::BlockClass::air) {
+				return y;
+			}
+		}
+		return Heightmap::Empty;
+	}
+
+	bool matchesColumnScan(const Chunk& chunk, int32_t x, int32_t z) {
+		return chunk.getHeight(x, z, Type::solid) == scanColumn(chunk, x, z, Type::solid) &&
+			   chunk.getHeight(x, z, Type::nonAir) == scanColumn(chunk, x, z, Type::nonAir);
+	}
+
+	bool matchesColumnScans(const Chunk& chunk) {
+		bool matches = true;
+		for (int32_t z = 0; z < Chunk::HorizontalSize; ++z) {
+			for (int32_t x = 0; x < Chunk::HorizontalSize; ++x) {
+				matches = matches && matchesColumnScan(chunk, x, z);
+			}
+		}
+		return matches;
+	}
+
+	bool hasHeights(const Chunk& chunk, int32_t x, int32_t z, int32_t solid, int32_t nonAir) {
+		return chunk.getHeight(x, z, Type::solid) == solid && chunk.getHeight(x, z, Type::nonAir) == nonAir;
+	}
+
+	void testPlaceAboveTop() {
+		Chunk chunk(glm::ivec2(0));
+		CHECK(hasHeights(chunk, 3, 4, Heightmap::Empty, Heightmap::Empty));
+
+		chunk.placeBlock(BlockData(BlockType::stone), 3, 20, 4);
+		CHECK(hasHeights(chunk, 3, 4, 20, 20));
+		chunk.placeBlock(BlockData(BlockType::oak_leaves), 3, 40, 4);
+		CHECK(hasHeights(chunk, 3, 4, 20, 40));
+		chunk.placeBlock(BlockData(BlockType::dirt), 3, 30, 4);
+		CHECK(hasHeights(chunk, 3, 4, 30, 40));
+
+		// Below the top, nothing changes
+		chunk.placeBlock(BlockData(BlockType::stone), 3, 10, 4);
+		CHECK(hasHeights(chunk, 3, 4, 30, 40));
+		CHECK(hasHeights(chunk, 4, 4, Heightmap::Empty, Heightmap::Empty));
+		CHECK(matchesColumnScans(chunk));
+	}
+
+	void testRemoveTop() {
+		// Stone, then water, then an empty section, then a mixed section holding the top
+		Chunk chunk(glm::ivec2(0));
+		chunk.fillSection(0, BlockType::stone);
+		chunk.fillSection(1, BlockType::water);
+		chunk.placeBlock(BlockData(BlockType::stone), 5, 50, 6);
+		chunk.placeBlock(BlockData(BlockType::glass), 5, 52, 6);
+		CHECK(chunk.getStoredSection(2).getState() == ChunkSection::State::empty);
+		CHECK(chunk.getStoredSection(1).getState() == ChunkSection::State::uniform);
+		CHECK(hasHeights(chunk, 5, 6, 50, 52));
+
+		chunk.placeBlock(BlockData(BlockType::air), 5, 52, 6);
+		CHECK(hasHeights(chunk, 5, 6, 50, 50));
+
+		// Down through the empty section into the uniform water one
+		chunk.placeBlock(BlockData(BlockType::air), 5, 50, 6);
+		CHECK(hasHeights(chunk, 5, 6, 15, 31));
+
+		// The top of a uniform section removed, the section below is scanned block by block
+		chunk.placeBlock(BlockData(BlockType::air), 5, 31, 6);
+		CHECK(chunk.getStoredSection(1).getState() == ChunkSection::State::mixed);
+		CHECK(hasHeights(chunk, 5, 6, 15, 30));
+		CHECK(matchesColumnScans(chunk));
+	}
+
+	void testReplaceWithNonSolid() {
+		Chunk chunk(glm::ivec2(0));
+		chunk.fillSection(0, BlockType::dirt);
+		chunk.placeBlock(BlockData(BlockType::stone), 7, 40, 8);
+		chunk.placeBlock(BlockData(BlockType::stone), 7, 60, 8);
+
+		// Still the highest non-air block, no longer the highest solid one
+		chunk.placeBlock(BlockData(BlockType::water), 7, 60, 8);
+		CHECK(hasHeights(chunk, 7, 8, 40, 60));
+		chunk.placeBlock(BlockData(BlockType::oak_leaves), 7, 40, 8);
+		CHECK(hasHeights(chunk, 7, 8, 15, 60));
+		chunk.placeBlock(BlockData(BlockType::air), 7, 60, 8);
+		CHECK(hasHeights(chunk, 7, 8, 15, 40));
+		CHECK(matchesColumnScans(chunk));
+	}
+
+	void testFillSection() {
+		Chunk chunk(glm::ivec2(0));
+		chunk.fillSection(2, BlockType::stone);
+		chunk.placeBlock(BlockData(BlockType::dirt), 1, 100, 1);
+		CHECK(hasHeights(chunk, 0, 0, 47, 47));
+		CHECK(hasHeights(chunk, 1, 1, 100, 100));
+
+		// Over the top of some columns only
+		chunk.fillSection(5, BlockType::glass);
+		CHECK(hasHeights(chunk, 0, 0, 47, 95));
+		CHECK(hasHeights(chunk, 1, 1, 100, 100));
+		chunk.fillSection(4, BlockType::stone);
+		CHECK(hasHeights(chunk, 0, 0, 79, 95));
+
+		// Cleared sections holding the tops
+		chunk.fillSection(5, BlockType::air);
+		CHECK(hasHeights(chunk, 0, 0, 79, 79));
+		chunk.fillSection(6, BlockType::air);
+		CHECK(hasHeights(chunk, 1, 1, 79, 79));
+		chunk.fillSection(4, BlockType::water);
+		CHECK(hasHeights(chunk, 0, 0, 47, 79));
+		chunk.fillSection(2, BlockType::air);
+		CHECK(hasHeights(chunk, 0, 0, Heightmap::Empty, 79));
+		CHECK(matchesColumnScans(chunk));
+	}
+
+	void testRandomEdits() {
+		// Generated terrain, edited around the top of its columns where the rescans happen
+		WorldGenerator generator(1337);
+		std::mt19937 random(4);
+		std::uniform_int_distribution<int32_t> types(0, static_cast<int32_t>(BlockData::TypeCount) - 1);
+		std::uniform_int_distribution<int32_t> horizontal(0, Chunk::HorizontalSize - 1);
+		std::uniform_int_distribution<int32_t> aroundTop(-3, 2);
+		std::uniform_int_distribution<int32_t> sections(0, Chunk::SectionCount - 1);
+		for (int32_t chunkIndex = 0; chunkIndex < 4; ++chunkIndex) {
+			Chunk chunk(glm::ivec2(chunkIndex * 3, chunkIndex * 5) * Chunk::HorizontalSize);
+			generator.populateChunk(chunk);
+			CHECK(matchesColumnScans(chunk));
+
+			bool matches = true;
+			for (int32_t i = 0; i < 2000; ++i) {
+				const int32_t x = horizontal(random);
+				const int32_t z = horizontal(random);
+				const int32_t y = glm::clamp(chunk.getHeight(x, z, Type::nonAir) + aroundTop(random), 0,
+											 Chunk::VerticalSize - 1);
+				const auto type = random() % 2 == 0 ? BlockType::air : static_cast<BlockType>(types(random));
+				chunk.placeBlock(BlockData(type), x, y, z);
+				matches = matches && matchesColumnScan(chunk, x, z);
+
+				if (i % 250 == 0) {
+					chunk.fillSection(sections(random), random() % 2 == 0 ? BlockType::air : type);
+					matches = matches && matchesColumnScans(chunk);
+				}
+			}
+			CHECK(matches);
+			CHECK(matchesColumnScans(chunk));
+		}
+	}
+}
+
+int main() {
+	testPlaceAboveTop();
+	testRemoveTop();
+	testReplaceWithNonSolid();
+	testFillSection();
+	testRandomEdits();
+	return Test::report();
+}
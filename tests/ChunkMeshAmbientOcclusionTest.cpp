@@ -0,0 +1,207 @@
+/**
+ * @file ChunkMeshAmbientOcclusionTest.cpp
+ * @brief The ambient occlusion read from the neighborhood cube matches the per-vertex rule
+ *
+ * @details Generated chunks, with random blocks added and random or missing neighbors, are meshed
+ *          in both formats with ambient occlusion on and off. Every face of both passes is
+ *          compared with the same face shaded by the per-vertex rule the cube path replaced.
+ */
+
+#include "../src/Common.hpp"
+#include "../src/Rendering/Mesh.hpp"
+#include "../src/World/BlockRegistry.hpp"
+#include "../src/World/Chunk.hpp"
+#include "../src/World/ChunkMeshBuilder.hpp"
+#include "../src/World/ChunkSnapshot.hpp"
+#include "../src/World/WorldGenerator.hpp"
+#include "Check.hpp"
+
+#include <cstring>
+#include <random>
+
+namespace {
+	constexpr int32_t ChunkCount = 12;
+	constexpr int32_t BottomFace = 5;
+
+	bool isNonAir(const ChunkSnapshot& snapshot, const glm::ivec3& position) {
+		const BlockData::BlockType type = snapshot.get(position);
+		return static_cast<size_t>(type) < BlockData::TypeCount &&
+			   BlockRegistry::getInstance().getClass(type) != BlockData::BlockClass::air;
+	}
+
+	/**
+	 * @brief Per-vertex rule: with direction = offset * 2 - 1, the two sides of a vertex are at
+	 *        direction * (1, 1, 0) and direction * (0, 1, 1) and its corner block at direction
+	 */
+	uint8_t calculateOcclusionLevel(const ChunkSnapshot& snapshot,
+									const glm::ivec3& blockPosition,
+									const glm::ivec3& vertexOffset) {
+		const glm::ivec3 direction = vertexOffset * 2 - 1;
+		const uint8_t side1 = isNonAir(snapshot, blockPosition + direction * glm::ivec3(1, 1, 0)) ? 1 : 0;
+		const uint8_t side2 = isNonAir(snapshot, blockPosition + direction * glm::ivec3(0, 1, 1)) ? 1 : 0;
+		if (side1 && side2) {
+			return 0;
+		}
+		const uint8_t corner = isNonAir(snapshot, blockPosition + direction) ? 1 : 0;
+		return 3 - (side1 + side2 + corner);
+	}
+
+	uint8_t getExpectedLevel(const ChunkSnapshot& snapshot,
+							 bool useAmbientOcclusion,
+							 int32_t face,
+							 const glm::ivec3& blockPosition,
+							 const BlockVertex& meshVertex) {
+		if (!useAmbientOcclusion) {
+			return 3;
+		}
+		if (face == BottomFace) {
+			return 0;
+		}
+		return calculateOcclusionLevel(snapshot, blockPosition, meshVertex.getPosition());
+	}
+
+	/**
+	 * @brief Face direction of 6 vertices, found from their offsets and texture coordinates
+	 *
+	 * @details Vertices store y on 8 bits, the top of a block at y = 255 wraps to 0.
+	 * @return -1 if they match no face of BlockMesh
+	 */
+	int32_t findFace(const BlockVertex* vertices, glm::ivec3& blockPosition) {
+		const auto wrap = [](glm::ivec3 position) { return glm::ivec3(position.x, position.y & 0xFF, position.z); };
+		for (int32_t face = 0; face < 6; ++face) {
+			const auto& reference = BlockMesh::vertices[face];
+			const glm::ivec3 origin = wrap(vertices[0].getPosition() - reference[0].getPosition());
+			bool matches = true;
+			for (size_t i = 0; i < reference.size() && matches; ++i) {
+				matches = vertices[i].getPosition() == wrap(origin + reference[i].getPosition()) &&
+						  vertices[i].getUv() == reference[i].getUv();
+			}
+			if (matches) {
+				blockPosition = origin;
+				return face;
+			}
+		}
+		return -1;
+	}
+
+	void checkVertices(const ChunkSnapshot& snapshot,
+					   bool useAmbientOcclusion,
+					   const std::vector<BlockVertex>& vertices,
+					   const ChunkMeshSlot& slot,
+					   int32_t& occludedVertices) {
+		CHECK(slot.size % 6 == 0);
+		for (int32_t first = slot.first; first + 6 <= slot.first + slot.size; first += 6) {
+			glm::ivec3 blockPosition;
+			const int32_t face = findFace(&vertices[first], blockPosition);
+			if (!CHECK(face >= 0)) {
+				continue;
+			}
+			for (int32_t i = 0; i < 6; ++i) {
+				BlockVertex expected = vertices[first + i];
+				const uint8_t level = getExpectedLevel(snapshot, useAmbientOcclusion, face, blockPosition,
+													   BlockMesh::vertices[face][i]);
+				expected.setOcclusionLevel(level);
+				CHECK(std::memcmp(&expected, &vertices[first + i], sizeof(BlockVertex)) == 0);
+				occludedVertices += level < 3 ? 1 : 0;
+			}
+		}
+	}
+
+	void checkFaces(const ChunkSnapshot& snapshot,
+					bool useAmbientOcclusion,
+					const std::vector<FaceRecord>& faces,
+					const ChunkMeshSlot& slot,
+					int32_t& occludedVertices) {
+		for (int32_t index = slot.first; index < slot.first + slot.size; ++index) {
+			const FaceRecord& record = faces[index];
+			const int32_t face = record.getFace();
+			std::array<uint8_t, FaceRecord::CornerCount> cornerOcclusion{};
+			for (const BlockVertex& vertex : BlockMesh::vertices[face]) {
+				cornerOcclusion[FaceRecord::getCorner(vertex.getUv())] =
+					getExpectedLevel(snapshot, useAmbientOcclusion, face, record.getPosition(), vertex);
+			}
+			const FaceRecord expected(record.getPosition(), face, record.getTextureLayer(), cornerOcclusion);
+			CHECK(expected == record);
+			for (uint8_t level : cornerOcclusion) {
+				occludedVertices += level < 3 ? 1 : 0;
+			}
+		}
+	}
+
+	/**
+	 * @brief Random blocks in the columns of a chunk that end up in the border of its neighbor
+	 */
+	void fillBorderColumns(Chunk& chunk, std::mt19937& random) {
+		std::uniform_int_distribution<int32_t> types(0, static_cast<int32_t>(BlockData::TypeCount) - 1);
+		for (int32_t z = 0; z < Chunk::HorizontalSize; ++z) {
+			for (int32_t x = 0; x < Chunk::HorizontalSize; ++x) {
+				if (x != 0 && x != Chunk::HorizontalSize - 1 && z != 0 && z != Chunk::HorizontalSize - 1) {
+					continue;
+				}
+				for (int32_t y = 0; y < Chunk::VerticalSize; ++y) {
+					chunk.placeBlock(BlockData(static_cast<BlockData::BlockType>(types(random))), x, y, z);
+				}
+			}
+		}
+	}
+}
+
+int main() {
+	WorldGenerator generator(1337);
+	std::mt19937 random(7);
+	std::uniform_int_distribution<int32_t> types(0, static_cast<int32_t>(BlockData::TypeCount) - 1);
+	std::uniform_int_distribution<int32_t> horizontal(0, Chunk::HorizontalSize - 1);
+	std::uniform_int_distribution<int32_t> vertical(0, Chunk::VerticalSize - 1);
+
+	// Neighbors with random borders, shared by the snapshots
+	std::vector<std::unique_ptr<Chunk>> neighborChunks;
+	for (int32_t i = 0; i < 8; ++i) {
+		neighborChunks.push_back(std::make_unique<Chunk>(glm::ivec2(0)));
+		fillBorderColumns(*neighborChunks.back(), random);
+	}
+
+	int32_t checkedFaces = 0;
+	int32_t occludedVertices = 0;
+	for (int32_t chunkIndex = 0; chunkIndex < ChunkCount; ++chunkIndex) {
+		Chunk chunk(glm::ivec2(chunkIndex * 7, chunkIndex % 4 * 5) * Chunk::HorizontalSize);
+		generator.populateChunk(chunk);
+		for (int32_t i = 0; i < 300; ++i) {
+			chunk.placeBlock(BlockData(static_cast<BlockData::BlockType>(types(random))), horizontal(random),
+							 vertical(random), horizontal(random));
+		}
+
+		// Every other snapshot borders generated neighbors, some of them not loaded
+		std::array<const Chunk*, 9> neighbors{};
+		if (chunkIndex % 2 == 1) {
+			for (size_t i = 0; i < neighbors.size(); ++i) {
+				neighbors[i] = random() % 4 == 0 ? nullptr : neighborChunks[i % neighborChunks.size()].get();
+			}
+		}
+		ChunkSnapshot snapshot;
+		snapshot.capture(chunk, neighbors);
+
+		for (ChunkMeshFormat format : {ChunkMeshFormat::vertices, ChunkMeshFormat::faceRecords}) {
+			for (bool useAmbientOcclusion : {false, true}) {
+				ChunkMeshData meshData;
+				ChunkMeshBuilder::buildMesh(snapshot, useAmbientOcclusion, meshData, LODLevel::Full, false, format);
+				for (int32_t section = 0; section < Chunk::SectionCount; ++section) {
+					for (const ChunkMeshSlot& slot : {meshData.solidSlots[section], meshData.semiTransparentSlots[section]}) {
+						if (format == ChunkMeshFormat::faceRecords) {
+							checkFaces(snapshot, useAmbientOcclusion, meshData.faces, slot, occludedVertices);
+							checkedFaces += slot.size;
+						} else {
+							checkVertices(snapshot, useAmbientOcclusion, meshData.vertices, slot, occludedVertices);
+							checkedFaces += slot.size / 6;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// The comparison must have covered occluded corners, not only flat terrain
+	std::printf("%d faces compared, %d occluded vertices\n", checkedFaces, occludedVertices);
+	CHECK(checkedFaces > 0);
+	CHECK(occludedVertices > 0);
+	return Test::report();
+}
@@ -0,0 +1,223 @@
+/**
+ * @file ChunkSectionCompressionTest.cpp
+ * @brief Runs of compressed sections restore every block, and are read in place by snapshots
+ *
+ * @details Each case keeps a copy of the blocks of the section and compares get() on every
+ *          block after compress, decompress and readColumns.
+ */
+
+#include "../src/World/Chunk.hpp"
+#include "../src/World/ChunkSection.hpp"
+#include "../src/World/ChunkSnapshot.hpp"
+#include "../src/World/WorldGenerator.hpp"
+#include "Check.hpp"
+
+#include <random>
+
+namespace {
+	constexpr int32_t Size = ChunkSection::Size;
+
+	using BlockType = BlockData::BlockType;
+	using Blocks = std::array<BlockType, ChunkSection::BlockCount>;
+
+	BlockType getType(int32_t type) { return static_cast<BlockType>(type); }
+
+	Blocks readBlocks(const ChunkSection& section) {
+		Blocks blocks;
+		for (int32_t y = 0; y < Size; ++y) {
+			for (int32_t z = 0; z < Size; ++z) {
+				for (int32_t x = 0; x < Size; ++x) {
+					blocks[ChunkSection::getIndex(x, y, z)] = section.get(x, y, z);
+				}
+			}
+		}
+		return blocks;
+	}
+
+	template <typename Generate>
+	void fillSection(ChunkSection& section, const Generate& generate) {
+		for (int32_t y = 0; y < Size; ++y) {
+			for (int32_t z = 0; z < Size; ++z) {
+				for (int32_t x = 0; x < Size; ++x) {
+					section.set(x, y, z, generate(x, y, z));
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Whether readColumns gives the blocks over a few column ranges, compressed or not
+	 */
+	bool readsColumns(const ChunkSection& section, const Blocks& expected) {
+		bool matches = true;
+		for (const glm::ivec4& range : {glm::ivec4(0, 16, 0, 16), glm::ivec4(15, 16, 0, 16), glm::ivec4(0, 16, 0, 1),
+										glm::ivec4(0, 1, 15, 16), glm::ivec4(3, 9, 5, 12)}) {
+			int32_t blocks = 0;
+			section.readColumns(range.x, range.y, range.z, range.w, [&](int32_t x, int32_t y, int32_t z, BlockType type) {
+				matches = matches && x >= range.x && x < range.y && z >= range.z && z < range.w &&
+						  type == expected[ChunkSection::getIndex(x, y, z)];
+				++blocks;
+			});
+			matches = matches && blocks == (range.y - range.x) * (range.w - range.z) * Size;
+		}
+		return matches;
+	}
+
+	/**
+	 * @brief Compresses a section, checks its state and blocks, then restores it
+	 * @return Whether the section was compressed
+	 */
+	bool roundTrip(ChunkSection& section) {
+		const Blocks before = readBlocks(section);
+		const ChunkSection::State state = section.getState();
+		const int32_t nonAirCount = section.getNonAirCount();
+		const size_t memoryUsage = section.getMemoryUsage();
+
+		const bool compressed = section.compress();
+		CHECK(section.isCompressed() == compressed);
+		CHECK(section.getState() == state);
+		CHECK(section.getNonAirCount() == nonAirCount);
+		CHECK(readsColumns(section, before));
+		if (compressed) {
+			CHECK(section.getMemoryUsage() < memoryUsage);
+		}
+
+		section.decompress();
+		CHECK(!section.isCompressed());
+		CHECK(section.getState() == state);
+		CHECK(section.getNonAirCount() == nonAirCount);
+		CHECK(readBlocks(section) == before);
+		return compressed;
+	}
+
+	void testFullHeightRuns() {
+		// Columns of a single type are one run of 16, the longest the low nibble holds
+		ChunkSection section;
+		fillSection(section, [](int32_t x, int32_t, int32_t z) { return getType((x + z) % 2 == 0 ? 5 : 3); });
+		CHECK(roundTrip(section));
+
+		// Terrain like layers, and a single block breaking a full column
+		fillSection(section, [](int32_t x, int32_t y, int32_t z) {
+			return y < 6 + (x + z) % 4 ? BlockType::stone : (y < 12 ? BlockType::dirt : BlockType::air);
+		});
+		section.set(0, 0, 0, BlockType::air);
+		section.set(15, 15, 15, BlockType::gold);
+		CHECK(roundTrip(section));
+	}
+
+	void testPaletteLimit() {
+		// 16 types: the last palette index fills the high nibble
+		ChunkSection section;
+		section.fill(BlockType::stone);
+		fillSection(section, [](int32_t x, int32_t y, int32_t z) { return getType((x + z * 3 + y / 8) % 16); });
+		CHECK(section.getState() == ChunkSection::State::mixed);
+		CHECK(roundTrip(section));
+
+		// A 17th type cannot be indexed by the runs, the section stays as it is
+		section.set(7, 7, 7, getType(16));
+		CHECK(!roundTrip(section));
+	}
+
+	void testNoisySection() {
+		// Runs of one block would not be smaller than the packed indices
+		std::mt19937 random(5);
+		ChunkSection section;
+		fillSection(section, [&](int32_t, int32_t, int32_t) { return getType(static_cast<int32_t>(random() % 4)); });
+		CHECK(!roundTrip(section));
+	}
+
+	void testEditBetweenCompressions() {
+		ChunkSection section;
+		fillSection(section, [](int32_t, int32_t y, int32_t) {
+			return y < 6 ? BlockType::stone : (y < 10 ? BlockType::dirt : BlockType::air);
+		});
+		CHECK(roundTrip(section));
+
+		// Compress, restore to edit, then compress the edited blocks
+		CHECK(section.compress());
+		section.decompress();
+		for (int32_t i = 0; i < Size; ++i) {
+			section.set(i, 10, 15 - i, BlockType::water);
+			section.set(i, 0, i, BlockType::air);
+		}
+		CHECK(roundTrip(section));
+
+		// Uniform and empty sections have nothing to compress
+		section.fill(BlockType::stone);
+		CHECK(!roundTrip(section));
+		section.fill(BlockType::air);
+		CHECK(!roundTrip(section));
+	}
+
+	void testRandomColumns() {
+		std::mt19937 random(9);
+		for (int32_t sample = 0; sample < 200; ++sample) {
+			const int32_t typeCount = 2 + sample % 15;
+			ChunkSection section;
+			for (int32_t z = 0; z < Size; ++z) {
+				for (int32_t x = 0; x < Size; ++x) {
+					// Runs of 1 to 16 blocks, cut at the top of the column
+					for (int32_t y = 0; y < Size;) {
+						const int32_t end = y + 1 + static_cast<int32_t>(random() % 16);
+						const BlockType type = getType(static_cast<int32_t>(random() % typeCount));
+						for (; y < end && y < Size; ++y) {
+							section.set(x, y, z, type);
+						}
+					}
+				}
+			}
+			roundTrip(section);
+		}
+	}
+
+	/**
+	 * @brief Snapshots copy the border of compressed neighbors without decompressing them
+	 */
+	void testSnapshotOfCompressedNeighbors() {
+		WorldGenerator generator(1337);
+		std::vector<std::unique_ptr<Chunk>> chunks;
+		std::array<const Chunk*, 9> neighbors{};
+		for (int32_t i = 0; i < 9; ++i) {
+			chunks.push_back(std::make_unique<Chunk>(glm::ivec2(i % 3, i / 3) * Chunk::HorizontalSize));
+			generator.populateChunk(*chunks.back());
+			neighbors[i] = chunks.back().get();
+		}
+
+		ChunkSnapshot resident;
+		resident.capture(*chunks[4], neighbors);
+		std::vector<const Chunk*> compressedNeighbors;
+		for (int32_t i = 0; i < 9; ++i) {
+			if (i != 4 && chunks[i]->compressBlocks() > 0) {
+				compressedNeighbors.push_back(chunks[i].get());
+			}
+		}
+		ChunkSnapshot compressed;
+		compressed.capture(*chunks[4], neighbors);
+
+		CHECK(!compressedNeighbors.empty());
+		for (const Chunk* neighbor : compressedNeighbors) {
+			CHECK(neighbor->isCompressed());
+		}
+		const int32_t padding = ChunkSnapshot::Padding;
+		bool matches = true;
+		for (int32_t y = 0; y < Chunk::VerticalSize; ++y) {
+			for (int32_t z = -padding; z < Chunk::HorizontalSize + padding; ++z) {
+				for (int32_t x = -padding; x < Chunk::HorizontalSize + padding; ++x) {
+					const int32_t index = ChunkSnapshot::getIndex(x, y, z);
+					matches = matches && compressed.get(index) == resident.get(index);
+				}
+			}
+		}
+		CHECK(matches);
+	}
+}
+
+int main() {
+	testFullHeightRuns();
+	testPaletteLimit();
+	testNoisySection();
+	testEditBetweenCompressions();
+	testRandomColumns();
+	testSnapshotOfCompressedNeighbors();
+	return Test::report();
+}
@@ -0,0 +1,130 @@
+/**
+ * @file ChunkSectionStateTest.cpp
+ * @brief Empty, uniform and mixed states of a section as its blocks are edited
+ *
+ * @details The mesher, the connectivity and the LOD builds only take their fast paths on empty
+ *          and uniform sections, so a section must go back to them, and release its packed
+ *          indices, as soon as its last block of another type is replaced.
+ */
+
+#include "../src/World/ChunkSection.hpp"
+#include "Check.hpp"
+
+#include <sstream>
+
+namespace {
+	constexpr int32_t Size = ChunkSection::Size;
+
+	// Smallest packed indices: one bit per block
+	constexpr size_t PackedIndicesSize = ChunkSection::BlockCount / 8;
+
+	using BlockType = BlockData::BlockType;
+	using State = ChunkSection::State;
+
+	bool isUniform(const ChunkSection& section, BlockType type) {
+		return section.getState() == State::uniform && section.getUniformType() == type &&
+			   section.getNonAirCount() == ChunkSection::BlockCount &&
+			   section.getMemoryUsage() < PackedIndicesSize;
+	}
+
+	void testEmptyAfterLastBlock() {
+		ChunkSection section;
+		section.set(4, 5, 6, BlockType::stone);
+		CHECK(section.getState() == State::mixed);
+
+		section.set(4, 5, 6, BlockType::air);
+		CHECK(section.getState() == State::empty);
+		CHECK(section.getMemoryUsage() < PackedIndicesSize);
+	}
+
+	void testUniformAfterReplace() {
+		// A block broken and placed back
+		ChunkSection section;
+		section.fill(BlockType::stone);
+		section.set(3, 4, 5, BlockType::air);
+		CHECK(section.getState() == State::mixed);
+		CHECK(section.getNonAirCount() == ChunkSection::BlockCount - 1);
+
+		section.set(3, 4, 5, BlockType::stone);
+		CHECK(isUniform(section, BlockType::stone));
+
+		// A hole filled with another type stays mixed until that block is replaced too
+		section.set(0, 0, 0, BlockType::air);
+		section.set(0, 0, 0, BlockType::glass);
+		CHECK(section.getState() == State::mixed);
+		section.set(0, 0, 0, BlockType::stone);
+		CHECK(isUniform(section, BlockType::stone));
+	}
+
+	void testUniformAfterRewrite() {
+		// Dirt over stone with a few ores, turned into stone: only the last replacement collapses
+		ChunkSection section;
+		section.fill(BlockType::stone);
+		for (int32_t z = 0; z < Size; ++z) {
+			for (int32_t x = 0; x < Size; ++x) {
+				section.set(x, Size - 1, z, BlockType::dirt);
+			}
+		}
+		section.set(1, 2, 3, BlockType::gold);
+		section.set(8, 8, 8, BlockType::diamond);
+		section.set(15, 0, 15, BlockType::iron);
+		CHECK(section.getState() == State::mixed);
+
+		for (int32_t z = 0; z < Size; ++z) {
+			for (int32_t x = 0; x < Size; ++x) {
+				section.set(x, Size - 1, z, BlockType::stone);
+			}
+		}
+		section.set(1, 2, 3, BlockType::stone);
+		section.set(8, 8, 8, BlockType::stone);
+		CHECK(section.getState() == State::mixed);
+		section.set(15, 0, 15, BlockType::stone);
+		CHECK(isUniform(section, BlockType::stone));
+
+		// Every block overwritten with a type that was not the first one of the palette
+		section.set(5, 5, 5, BlockType::dirt);
+		bool staysMixed = true;
+		for (int32_t y = 0; y < Size; ++y) {
+			for (int32_t z = 0; z < Size; ++z) {
+				for (int32_t x = 0; x < Size; ++x) {
+					staysMixed = staysMixed && section.getState() == State::mixed;
+					section.set(x, y, z, BlockType::dirt);
+				}
+			}
+		}
+		CHECK(staysMixed);
+		CHECK(isUniform(section, BlockType::dirt));
+	}
+
+	void testReadCollapses() {
+		// Saved with a palette holding a type that no block uses anymore
+		PalettedBlockStorage storage(ChunkSection::BlockCount, BlockType::stone);
+		storage.set(10, BlockType::dirt);
+		storage.set(10, BlockType::stone);
+		CHECK(storage.getBitsPerEntry() != 0);
+		CHECK(storage.holdsOnly(BlockType::stone));
+		CHECK(!storage.holdsOnly(BlockType::dirt));
+
+		std::stringstream stream;
+		storage.write(stream);
+		ChunkSection section;
+		CHECK(section.read(stream));
+		CHECK(isUniform(section, BlockType::stone));
+
+		// A mixed section read back stays mixed
+		storage.set(10, BlockType::dirt);
+		std::stringstream mixedStream;
+		storage.write(mixedStream);
+		CHECK(section.read(mixedStream));
+		CHECK(section.getState() == State::mixed);
+		CHECK(section.get(10, 0, 0) == BlockType::dirt);
+	}
+}
+
+int main() {
+	testEmptyAfterLastBlock();
+	testUniformAfterReplace();
+	testUniformAfterRewrite();
+	testReadCollapses();
+	return Test::report();
+}
@@ -0,0 +1,117 @@
+/**
+ * @file FaceRecordTest.cpp
+ * @brief Every field of a face record decodes to the value it was built with, at its limits
+ *
+ * @details Each field is swept over its whole range while the others sit at their lowest or
+ *          highest value, so a mask or shift that lets one field spill into another fails.
+ */
+
+#include "../src/Rendering/FaceRecord.hpp"
+#include "Check.hpp"
+
+namespace {
+	using Occlusion = std::array<uint8_t, FaceRecord::CornerCount>;
+
+	struct Fields {
+		glm::ivec3 position;
+		int32_t face;
+		uint8_t textureLayer;
+		Occlusion cornerOcclusion;
+		uint8_t uScale;
+		uint8_t vScale;
+	};
+
+	constexpr Fields Lowest = {{0, 0, 0}, 0, 0, {0, 0, 0, 0}, 1, 1};
+	constexpr Fields Highest = {{15, 255, 15}, 5, 255, {3, 3, 3, 3}, 16, 16};
+
+	bool roundTrips(const Fields& fields) {
+		const FaceRecord record(fields.position, fields.face, fields.textureLayer, fields.cornerOcclusion,
+								fields.uScale, fields.vScale);
+		bool decoded = record.getPosition() == fields.position && record.getFace() == fields.face &&
+					   record.getTextureLayer() == fields.textureLayer && record.getUScale() == fields.uScale &&
+					   record.getVScale() == fields.vScale;
+		for (int32_t corner = 0; corner < FaceRecord::CornerCount; ++corner) {
+			decoded = decoded && record.getOcclusionLevel(corner) == fields.cornerOcclusion[corner];
+		}
+		return decoded;
+	}
+
+	void testPosition() {
+		for (const Fields& base : {Lowest, Highest}) {
+			Fields fields = base;
+			for (int32_t y = 0; y < 256; ++y) {
+				for (int32_t z = 0; z < 16; ++z) {
+					for (int32_t x = 0; x < 16; ++x) {
+						fields.position = {x, y, z};
+						CHECK(roundTrips(fields));
+					}
+				}
+			}
+		}
+	}
+
+	void testFaceAndTextureLayer() {
+		for (const Fields& base : {Lowest, Highest}) {
+			Fields fields = base;
+			for (int32_t face = 0; face < 6; ++face) {
+				for (int32_t layer = 0; layer < 256; ++layer) {
+					fields.face = face;
+					fields.textureLayer = static_cast<uint8_t>(layer);
+					CHECK(roundTrips(fields));
+				}
+			}
+		}
+	}
+
+	void testCornerOcclusion() {
+		// The 256 combinations of the 4 corner levels
+		for (const Fields& base : {Lowest, Highest}) {
+			Fields fields = base;
+			for (int32_t levels = 0; levels < 256; ++levels) {
+				for (int32_t corner = 0; corner < FaceRecord::CornerCount; ++corner) {
+					fields.cornerOcclusion[corner] = (levels >> (2 * corner)) & 0x03;
+				}
+				CHECK(roundTrips(fields));
+			}
+		}
+	}
+
+	void testScale() {
+		for (const Fields& base : {Lowest, Highest}) {
+			Fields fields = base;
+			for (int32_t vScale = 1; vScale <= 16; ++vScale) {
+				for (int32_t uScale = 1; uScale <= 16; ++uScale) {
+					fields.uScale = static_cast<uint8_t>(uScale);
+					fields.vScale = static_cast<uint8_t>(vScale);
+					CHECK(roundTrips(fields));
+				}
+			}
+		}
+	}
+
+	void testDefaults() {
+		// A face without explicit scale covers one block, and equal fields give equal records
+		const FaceRecord record({3, 200, 9}, 2, 17, {1, 2, 3, 0});
+		CHECK(record.getUScale() == 1 && record.getVScale() == 1);
+		CHECK(record == FaceRecord({3, 200, 9}, 2, 17, {1, 2, 3, 0}, 1, 1));
+		CHECK(!(record == FaceRecord({3, 200, 9}, 2, 17, {1, 2, 3, 1})));
+		CHECK(FaceRecord() == FaceRecord({0, 0, 0}, 0, 0, {0, 0, 0, 0}));
+	}
+
+	void testCorners() {
+		CHECK(FaceRecord::getCorner({false, false}) == 0);
+		CHECK(FaceRecord::getCorner({true, false}) == 1);
+		CHECK(FaceRecord::getCorner({false, true}) == 2);
+		CHECK(FaceRecord::getCorner({true, true}) == 3);
+	}
+}
+
+int main() {
+	testPosition();
+	testFaceAndTextureLayer();
+	testCornerOcclusion();
+	testScale();
+	testDefaults();
+	testCorners();
+	return Test::report();
+}
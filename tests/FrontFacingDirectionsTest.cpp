@@ -0,0 +1,113 @@
+/**
+ * @file FrontFacingDirectionsTest.cpp
+ * @brief Face directions of a section that the solid pass leaves out for a camera position
+ *
+ * @details Leaving out a direction that still has a face in front of the camera makes terrain
+ *          vanish, so every rejection is checked against the planes of every block face of the
+ *          section, for camera positions around and inside the section bounds. Greedy quads and
+ *          LOD cells cover whole block faces, so their planes are among the ones checked.
+ */
+
+#include "../src/World/Chunk.hpp"
+#include "Check.hpp"
+
+#include <random>
+
+namespace {
+	constexpr int32_t Size = ChunkSection::Size;
+
+	// Outward normal of each face, in BlockMesh face order
+	constexpr std::array<glm::ivec3, 6> Directions = {{
+		{0, 1, 0},
+		{1, 0, 0},
+		{-1, 0, 0},
+		{0, 0, -1},
+		{0, 0, 1},
+		{0, -1, 0},
+	}};
+
+	/**
+	 * @brief Whether a block face of the direction in the section is in front of the camera
+	 */
+	bool hasFrontFace(const glm::vec3& localCamera, int32_t section, size_t face) {
+		const glm::vec3 normal = Directions[face];
+		const glm::vec3 corner = BlockMesh::vertices[face][0].getPosition();
+		for (int32_t y = section * Size; y < (section + 1) * Size; ++y) {
+			for (int32_t z = 0; z < Chunk::HorizontalSize; ++z) {
+				for (int32_t x = 0; x < Chunk::HorizontalSize; ++x) {
+					if (glm::dot(localCamera - (glm::vec3(x, y, z) + corner), normal) > 0.0f) {
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+	void checkCamera(const glm::vec3& localCamera, int32_t section) {
+		const std::array<bool, 6> frontFacing = Chunk::getFrontFacingDirections(localCamera, section);
+		for (size_t face = 0; face < frontFacing.size(); ++face) {
+			CHECK(frontFacing[face] || !hasFrontFace(localCamera, section, face));
+		}
+	}
+
+	void testFaceOrder() {
+		for (size_t face = 0; face < Directions.size(); ++face) {
+			CHECK(&BlockMesh::getVerticesFromDirection(Directions[face]) == &BlockMesh::vertices[face]);
+			for (const BlockVertex& vertex : BlockMesh::vertices[face]) {
+				const glm::ivec3 offset = vertex.getPosition() - BlockMesh::vertices[face][0].getPosition();
+				CHECK(glm::dot(glm::vec3(offset), glm::vec3(Directions[face])) == 0.0f);
+			}
+		}
+	}
+
+	void testRejectedDirections() {
+		// Above the chunk, no bottom face can be seen
+		const std::array<bool, 6> above = Chunk::getFrontFacingDirections({8.0f, 300.0f, 8.0f}, 3);
+		CHECK(above[0] && above[1] && above[2] && above[3] && above[4] && !above[5]);
+
+		// West of the chunk, beside section 0, east faces point away
+		const std::array<bool, 6> west = Chunk::getFrontFacingDirections({-10.0f, 8.0f, 8.0f}, 0);
+		CHECK(west[0] && !west[1] && west[2] && west[3] && west[4] && west[5]);
+
+		// Past a corner, two horizontal directions point away
+		const std::array<bool, 6> corner = Chunk::getFrontFacingDirections({20.0f, 40.0f, -4.0f}, 15);
+		CHECK(!corner[0] && corner[1] && !corner[2] && corner[3] && !corner[4] && corner[5]);
+	}
+
+	void testCameraSweep() {
+		// Around the bounds of the section and of the block planes next to them
+		constexpr std::array<float, 15> Offsets = {
+			-20.0f, -0.5f, 0.0f, 0.25f, 1.0f, 1.25f, 2.0f, 8.0f,
+			14.0f, 14.75f, 15.0f, 15.5f, 16.0f, 16.5f, 40.0f,
+		};
+		for (int32_t section : {0, 7, Chunk::SectionCount - 1}) {
+			const auto bottom = static_cast<float>(section * Size);
+			for (float y : Offsets) {
+				for (float z : Offsets) {
+					for (float x : Offsets) {
+						checkCamera({x, bottom + y, z}, section);
+					}
+				}
+			}
+		}
+	}
+
+	void testRandomCameras() {
+		std::mt19937 random(21);
+		std::uniform_real_distribution<float> horizontal(-32.0f, 48.0f);
+		std::uniform_real_distribution<float> vertical(-32.0f, Chunk::VerticalSize + 32.0f);
+		std::uniform_int_distribution<int32_t> sections(0, Chunk::SectionCount - 1);
+		for (int32_t i = 0; i < 500; ++i) {
+			checkCamera({horizontal(random), vertical(random), horizontal(random)}, sections(random));
+		}
+	}
+}
+
+int main() {
+	testFaceOrder();
+	testRejectedDirections();
+	testCameraSweep();
+	testRandomCameras();
+	return Test::report();
+}
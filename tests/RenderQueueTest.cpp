@@ -0,0 +1,164 @@
+/**
+ * @file RenderQueueTest.cpp
+ * @brief Recording, sorting and batching of the render queue, with a backend that only logs its
+ *        calls
+ */
+
+#include "../src/Rendering/RenderQueue.hpp"
+#include "Check.hpp"
+
+#include <string>
+
+namespace {
+	using Pass = RenderQueue::Pass;
+	using State = RenderQueue::State;
+
+	constexpr State OpaqueShader0 = {Pass::opaque, 0, RenderQueue::DefaultState};
+	constexpr State OpaqueShader0NoCulling = {Pass::opaque, 0, RenderQueue::NoCulling};
+	constexpr State OpaqueShader1 = {Pass::opaque, 1, RenderQueue::DefaultState};
+	constexpr State TransparentShader0 = {Pass::transparent, 0, RenderQueue::NoCulling};
+	constexpr State TransparentShader1 = {Pass::transparent, 1, RenderQueue::NoCulling};
+
+	/**
+	 * @brief Logs every call as a line of text and checks that the state bits it is told about
+	 *        are the ones it was left with
+	 */
+	class CountingBackend : public RenderQueue::Backend {
+	   public:
+		std::vector<std::string> calls;
+		std::vector<std::vector<RenderQueue::Command>> batches;
+		uint8_t bits = RenderQueue::DefaultState;
+
+		void bindShader(Pass pass, uint8_t shader) override {
+			calls.push_back("bind " + std::to_string(static_cast<int32_t>(pass)) + " " + std::to_string(shader));
+		}
+
+		void setState(uint8_t previousBits, uint8_t newBits) override {
+			CHECK(previousBits == bits);
+			bits = newBits;
+			calls.push_back("state " + std::to_string(previousBits) + " " + std::to_string(newBits));
+		}
+
+		void draw(const State& state, std::span<const RenderQueue::Command> commands) override {
+			CHECK(state.bits == bits);
+			for (const RenderQueue::Command& command : commands) {
+				CHECK(command.getState() == state);
+			}
+			calls.push_back("draw " + std::to_string(commands.size()));
+			batches.emplace_back(commands.begin(), commands.end());
+		}
+	};
+
+	void testMerging() {
+		RenderQueue queue;
+		const glm::ivec2 origin(16, 32);
+
+		// Contiguous ranges of a state and origin extend the previous command
+		queue.record(OpaqueShader0, origin, 0, 10);
+		queue.record(OpaqueShader0, origin, 10, 20);
+		queue.record(OpaqueShader0, origin, 30, 0);
+		CHECK(queue.getCommands().size() == 1);
+		CHECK(queue.getCommands()[0].first == 0);
+		CHECK(queue.getCommands()[0].count == 30);
+
+		// A gap, another origin or another state start a new command
+		queue.record(OpaqueShader0, origin, 40, 5);
+		queue.record(OpaqueShader0, origin + glm::ivec2(16, 0), 45, 5);
+		queue.record(OpaqueShader0NoCulling, origin + glm::ivec2(16, 0), 50, 5);
+		CHECK(queue.getCommands().size() == 4);
+
+		queue.clear();
+		CHECK(queue.getCommands().empty());
+	}
+
+	void testSortOrder() {
+		RenderQueue queue;
+		const glm::ivec2 origin(0);
+
+		// Recorded against the key order: pass > shader > state bits > recording order
+		queue.record(TransparentShader1, origin, 600, 1);
+		queue.record(TransparentShader0, origin, 500, 1);
+		queue.record(OpaqueShader1, origin, 400, 1);
+		queue.record(OpaqueShader0NoCulling, origin, 300, 1);
+		queue.record(OpaqueShader0, origin, 200, 1);
+		queue.record(OpaqueShader0NoCulling, origin, 100, 1);
+		queue.record(OpaqueShader0, origin, 0, 1);
+		queue.sort();
+
+		const std::vector<std::pair<State, int32_t>> expected = {
+			{OpaqueShader0, 200},		  {OpaqueShader0, 0},		  {OpaqueShader0NoCulling, 300},
+			{OpaqueShader0NoCulling, 100}, {OpaqueShader1, 400},		  {TransparentShader0, 500},
+			{TransparentShader1, 600},
+		};
+		const std::span<const RenderQueue::Command> commands = queue.getCommands();
+		if (CHECK(commands.size() == expected.size())) {
+			for (size_t i = 0; i < commands.size(); ++i) {
+				CHECK(commands[i].getState() == expected[i].first);
+				CHECK(commands[i].first == expected[i].second);
+				CHECK(i == 0 || commands[i - 1].key < commands[i].key);
+			}
+		}
+	}
+
+	void testExecute() {
+		RenderQueue queue;
+		const glm::ivec2 first(0, 0);
+		const glm::ivec2 second(16, 0);
+		queue.record(TransparentShader1, second, 300, 4);
+		queue.record(OpaqueShader0, first, 0, 10);
+		queue.record(OpaqueShader0, first, 10, 10);
+		queue.record(OpaqueShader1, first, 800, 8);
+		queue.record(OpaqueShader0NoCulling, first, 50, 6);
+		queue.record(TransparentShader0, first, 200, 4);
+		queue.record(OpaqueShader0, second, 100, 5);
+
+		CountingBackend backend;
+		queue.execute(backend);
+
+		// One batch per state, the shader is bound when it changes and the state bits are put
+		// back to the default at the end
+		const std::vector<std::string> expectedCalls = {
+			"bind 0 0", "draw 2",  "state 0 1", "draw 1",	"bind 0 1",	 "state 1 0", "draw 1",
+			"bind 1 0", "state 0 1", "draw 1",	 "bind 1 1", "draw 1",	 "state 1 0",
+		};
+		CHECK(backend.calls == expectedCalls);
+		CHECK(backend.bits == RenderQueue::DefaultState);
+
+		if (CHECK(backend.batches.size() == 5)) {
+			const std::vector<RenderQueue::Command>& batch = backend.batches[0];
+			CHECK(batch[0].origin == first && batch[0].first == 0 && batch[0].count == 20);
+			CHECK(batch[1].origin == second && batch[1].first == 100 && batch[1].count == 5);
+		}
+
+		const RenderQueue::Statistics& statistics = queue.getStatistics();
+		CHECK(statistics.commands == 6);
+		CHECK(statistics.batches == 5);
+		CHECK(statistics.shaderChanges == 4);
+		CHECK(statistics.stateChanges == 4);
+	}
+
+	void testExecuteInDefaultState() {
+		// Nothing is restored when the last batch already uses the default state
+		RenderQueue queue;
+		queue.record(OpaqueShader0, glm::ivec2(0), 0, 6);
+		CountingBackend backend;
+		queue.execute(backend);
+		CHECK((backend.calls == std::vector<std::string>{"bind 0 0", "draw 1"}));
+		CHECK(queue.getStatistics().stateChanges == 0);
+
+		// An empty queue draws nothing
+		queue.clear();
+		CountingBackend emptyBackend;
+		queue.execute(emptyBackend);
+		CHECK(emptyBackend.calls.empty());
+		CHECK(queue.getStatistics().batches == 0);
+	}
+}
+
+int main() {
+	testMerging();
+	testSortOrder();
+	testExecute();
+	testExecuteInDefaultState();
+	return Test::report();
+}
@@ -0,0 +1,237 @@
+/**
+ * @file SectionConnectivityTest.cpp
+ * @brief Faces of a section joined by its open blocks, as used to cull hidden sections
+ *
+ * @details A missing pair makes visible terrain vanish, so the flood fill is checked on shaped
+ *          sections with known answers, against a plain region labelling on random sections, and
+ *          through the mesher for sections made of non-solid blocks.
+ */
+
+#include "../src/World/Chunk.hpp"
+#include "../src/World/ChunkMeshBuilder.hpp"
+#include "../src/World/ChunkSnapshot.hpp"
+#include "../src/World/SectionConnectivity.hpp"
+#include "Check.hpp"
+
+#include <random>
+
+namespace {
+	constexpr int32_t Size = ChunkSection::Size;
+	constexpr int32_t Top = 0;
+	constexpr int32_t East = 1;
+	constexpr int32_t West = 2;
+	constexpr int32_t North = 3;
+	constexpr int32_t South = 4;
+	constexpr int32_t Bottom = 5;
+
+	using SolidColumns = SectionConnectivity::SolidColumns;
+
+	SolidColumns makeFull() {
+		SolidColumns solid;
+		solid.fill(0xFFFF);
+		return solid;
+	}
+
+	void setSolid(SolidColumns& solid, int32_t x, int32_t y, int32_t z, bool isSolid) {
+		uint16_t& column = solid[x + z * Size];
+		column = isSolid ? column | (1u << y) : column & ~(1u << y);
+	}
+
+	/**
+	 * @brief Whether the connected pairs are exactly the pairs of the faces of a mask
+	 */
+	bool connectsExactly(const SectionConnectivity& connectivity, uint8_t faceMask) {
+		bool matches = true;
+		for (int32_t a = 0; a < SectionConnectivity::FaceCount; ++a) {
+			for (int32_t b = a + 1; b < SectionConnectivity::FaceCount; ++b) {
+				const bool expected = (faceMask & (1u << a)) != 0 && (faceMask & (1u << b)) != 0;
+				matches = matches && connectivity.isConnected(a, b) == expected &&
+						  connectivity.isConnected(b, a) == expected;
+			}
+		}
+		return matches;
+	}
+
+	void testUniformSections() {
+		const SectionConnectivity open = SectionConnectivity::compute(SolidColumns{});
+		CHECK(open.getBits() == SectionConnectivity::AllConnected);
+		CHECK(connectsExactly(open, 0x3F));
+
+		const SectionConnectivity closed = SectionConnectivity::compute(makeFull());
+		CHECK(closed.getBits() == SectionConnectivity::NoneConnected);
+		CHECK(connectsExactly(closed, 0));
+
+		// A face always sees itself, and a section is open until computed
+		for (int32_t face = 0; face < SectionConnectivity::FaceCount; ++face) {
+			CHECK(closed.isConnected(face, face));
+		}
+		CHECK(SectionConnectivity().getBits() == SectionConnectivity::AllConnected);
+	}
+
+	void testWalls() {
+		// A wall across x separates east from west, each side still joins the 4 other faces
+		SolidColumns solid{};
+		for (int32_t z = 0; z < Size; ++z) {
+			solid[8 + z * Size] = 0xFFFF;
+		}
+		SectionConnectivity connectivity = SectionConnectivity::compute(solid);
+		CHECK(!connectivity.isConnected(East, West));
+		for (int32_t side : {East, West}) {
+			for (int32_t face : {Top, North, South, Bottom}) {
+				CHECK(connectivity.isConnected(side, face));
+			}
+		}
+		CHECK(connectivity.isConnected(Top, Bottom));
+		CHECK(connectivity.isConnected(North, South));
+
+		// A horizontal floor separates the top from the bottom
+		solid.fill(1u << 3);
+		connectivity = SectionConnectivity::compute(solid);
+		CHECK(!connectivity.isConnected(Top, Bottom));
+		CHECK(connectivity.isConnected(East, West));
+		CHECK(connectivity.isConnected(Top, North));
+		CHECK(connectivity.isConnected(Bottom, South));
+
+		// One hole in the floor joins them again
+		setSolid(solid, 15, 3, 15, false);
+		CHECK(SectionConnectivity::compute(solid).isConnected(Top, Bottom));
+	}
+
+	void testTunnels() {
+		// A straight tunnel through solid rock joins its two end faces and nothing else
+		SolidColumns solid = makeFull();
+		for (int32_t x = 0; x < Size; ++x) {
+			setSolid(solid, x, 5, 7, false);
+		}
+		CHECK(connectsExactly(SectionConnectivity::compute(solid), 1u << East | 1u << West));
+
+		// A bent one going down from the top then towards the south
+		solid = makeFull();
+		for (int32_t y = 8; y < Size; ++y) {
+			setSolid(solid, 3, y, 3, false);
+		}
+		for (int32_t z = 3; z < Size; ++z) {
+			setSolid(solid, 3, 8, z, false);
+		}
+		CHECK(connectsExactly(SectionConnectivity::compute(solid), 1u << Top | 1u << South));
+
+		// Two tunnels that do not meet
+		for (int32_t y = 0; y < Size; ++y) {
+			setSolid(solid, 12, y, 12, false);
+		}
+		const SectionConnectivity twoTunnels = SectionConnectivity::compute(solid);
+		CHECK(twoTunnels.isConnected(Top, South));
+		CHECK(twoTunnels.isConnected(Top, Bottom));
+		CHECK(!twoTunnels.isConnected(South, Bottom));
+		CHECK(!twoTunnels.isConnected(East, West));
+	}
+
+	void testSingleOpenBlock() {
+		// On an edge it joins the 2 faces it lies against, in a corner the 3 of them
+		SolidColumns solid = makeFull();
+		setSolid(solid, 15, 7, 0, false);
+		CHECK(connectsExactly(SectionConnectivity::compute(solid), 1u << East | 1u << North));
+
+		solid = makeFull();
+		setSolid(solid, 0, 0, 15, false);
+		CHECK(connectsExactly(SectionConnectivity::compute(solid), 1u << West | 1u << South | 1u << Bottom));
+
+		// Inside the section or on a single face it joins nothing
+		solid = makeFull();
+		setSolid(solid, 7, 7, 7, false);
+		CHECK(connectsExactly(SectionConnectivity::compute(solid), 0));
+		setSolid(solid, 7, 15, 7, false);
+		CHECK(connectsExactly(SectionConnectivity::compute(solid), 0));
+	}
+
+	/**
+	 * @brief Faces touched by each region of open blocks, labelled one block at a time
+	 */
+	SectionConnectivity labelRegions(const SolidColumns& solid) {
+		const auto isOpen = [&](const glm::ivec3& p) { return ((solid[p.x + p.z * Size] >> p.y) & 1) == 0; };
+		std::array<bool, ChunkSection::BlockCount> labelled{};
+		SectionConnectivity connectivity(SectionConnectivity::NoneConnected);
+		for (int32_t index = 0; index < ChunkSection::BlockCount; ++index) {
+			const glm::ivec3 seed(index % Size, index / (Size * Size), (index / Size) % Size);
+			if (labelled[index] || !isOpen(seed)) {
+				continue;
+			}
+			std::vector<glm::ivec3> region = {seed};
+			labelled[index] = true;
+			uint8_t faces = 0;
+			for (size_t i = 0; i < region.size(); ++i) {
+				const glm::ivec3 block = region[i];
+				for (int32_t face = 0; face < SectionConnectivity::FaceCount; ++face) {
+					const glm::ivec3 next = block + SectionConnectivity::getFaceDirection(face);
+					if (glm::any(glm::lessThan(next, glm::ivec3(0))) || glm::any(glm::greaterThanEqual(next, glm::ivec3(Size)))) {
+						faces |= 1u << face;
+						continue;
+					}
+					const int32_t nextIndex = next.x + next.z * Size + next.y * Size * Size;
+					if (!labelled[nextIndex] && isOpen(next)) {
+						labelled[nextIndex] = true;
+						region.push_back(next);
+					}
+				}
+			}
+			connectivity.connectFaces(faces);
+		}
+		return connectivity;
+	}
+
+	void testRandomSections() {
+		std::mt19937 random(11);
+		for (int32_t sample = 0; sample < 400; ++sample) {
+			// From nearly open to nearly closed, where the regions are small and many
+			const uint32_t solidChance = 40 + sample % 60;
+			SolidColumns solid{};
+			for (int32_t index = 0; index < ChunkSection::BlockCount; ++index) {
+				setSolid(solid, index % Size, index / (Size * Size), (index / Size) % Size, random() % 100 < solidChance);
+			}
+			CHECK(SectionConnectivity::compute(solid) == labelRegions(solid));
+		}
+	}
+
+	void testNonSolidSections() {
+		// Sections of water or leaves are drawn through, so the mesher must keep them open
+		Chunk chunk(glm::ivec2(0));
+		chunk.fillSection(1, BlockData::BlockType::water);
+		chunk.fillSection(2, BlockData::BlockType::oak_leaves);
+		chunk.fillSection(3, BlockData::BlockType::glass);
+		chunk.fillSection(4, BlockData::BlockType::stone);
+
+		// Stone crossed by a water tunnel and glass, mixed sections with non-solid blocks
+		chunk.fillSection(5, BlockData::BlockType::stone);
+		for (int32_t x = 0; x < Size; ++x) {
+			chunk.placeBlock(BlockData(BlockData::BlockType::water), x, 5 * Size + 4, 9);
+		}
+		chunk.fillSection(6, BlockData::BlockType::stone);
+		for (int32_t y = 0; y < Size; ++y) {
+			chunk.placeBlock(BlockData(BlockData::BlockType::glass), 0, 6 * Size + y, 0);
+		}
+
+		ChunkSnapshot snapshot;
+		snapshot.capture(chunk, std::array<const Chunk*, 9>{});
+		ChunkMeshData meshData;
+		ChunkMeshBuilder::buildMesh(snapshot, false, meshData);
+
+		const auto& connectivity = meshData.sectionConnectivity;
+		CHECK(connectivity[0].getBits() == SectionConnectivity::AllConnected);
+		CHECK(connectivity[1].getBits() == SectionConnectivity::AllConnected);
+		CHECK(connectivity[2].getBits() == SectionConnectivity::AllConnected);
+		CHECK(connectivity[3].getBits() == SectionConnectivity::AllConnected);
+		CHECK(connectivity[4].getBits() == SectionConnectivity::NoneConnected);
+		CHECK(connectsExactly(connectivity[5], 1u << East | 1u << West));
+		CHECK(connectsExactly(connectivity[6], 1u << Top | 1u << West | 1u << North | 1u << Bottom));
+	}
+}
+
+int main() {
+	testUniformSections();
+	testWalls();
+	testTunnels();
+	testSingleOpenBlock();
+	testRandomSections();
+	testNonSolidSections();
+	return Test::report();
+}